@@ -0,0 +1,657 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * Micro benchmarks for the data path: readers, buffers, checksums,
+ * recording and curve painting.
+ *
+ * All input is synthetic and fed from memory (`QBuffer`) so results
+ * only depend on the code being measured. Results are printed as JSON
+ * (default) or CSV to be compared between revisions. Run with `--help`
+ * for options.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include <QApplication>
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <QtDebug>
+
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "framedreader.h"
+#include "ringbuffer.h"
+#include "multiringbuffer.h"
+#include "indexbuffer.h"
+#include "framebufferseries.h"
+#include "checksumcalculator.h"
+#include "datarecorder.h"
+#include "numberformat.h"
+#include "setting_defines.h"
+#include "defines.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Allocation counting. With glibc the `malloc` family is interposed,
+// which also covers C++ `new` and Qt container storage (`QArrayData`).
+// Elsewhere only C++ `new` can be counted, Qt containers aren't included.
+static std::atomic<uint64_t> numAllocations(0);
+
+#ifdef __GLIBC__
+
+extern "C"
+{
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+
+void* malloc(std::size_t size) noexcept
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) noexcept
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, std::size_t size) noexcept
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+}
+
+/// What `allocsPerIteration` counts
+static const char ALLOCATION_COUNTER[] = "malloc calls";
+
+#else
+
+void* operator new(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/// What `allocsPerIteration` counts
+static const char ALLOCATION_COUNTER[] = "operator new calls";
+
+#endif // __GLIBC__
+
+struct Options
+{
+    unsigned numChannels;
+    unsigned numSamples;
+    unsigned iterations;
+    NumberFormat numberFormat;
+    QString filter;
+};
+
+struct Result
+{
+    QString name;
+    QString params;
+    unsigned iterations;
+    double seconds;             ///< total for all iterations
+    uint64_t bytes;             ///< processed per iteration
+    uint64_t samples;           ///< processed per iteration
+    uint64_t allocations;       ///< total for all iterations
+};
+
+/// Collects results of benchmarks
+class Runner
+{
+public:
+    explicit Runner(const Options& options) : opt(options) {}
+
+    /**
+     * Runs `func` once for warm up, then `iterations` times and records
+     * the result.
+     *
+     * @param bytes number of bytes processed by a single run, 0 if N/A
+     * @param samples number of samples processed by a single run, 0 if N/A
+     */
+    void run(QString name, QString params, uint64_t bytes, uint64_t samples,
+             std::function<void()> func)
+    {
+        if (!opt.filter.isEmpty() && !name.contains(opt.filter)) return;
+
+        func();
+
+        uint64_t allocStart = numAllocations.load();
+        QElapsedTimer timer;
+        timer.start();
+        for (unsigned i = 0; i < opt.iterations; i++)
+        {
+            func();
+        }
+        double seconds = timer.nsecsElapsed() / 1e9;
+        uint64_t allocs = numAllocations.load() - allocStart;
+
+        results.push_back({name, params, opt.iterations, seconds, bytes, samples, allocs});
+    }
+
+    void printJson(QTextStream& out) const
+    {
+        QJsonArray array;
+        for (auto& r : results)
+        {
+            QJsonObject obj;
+            obj["name"] = r.name;
+            obj["params"] = r.params;
+            obj["iterations"] = int(r.iterations);
+            obj["seconds"] = r.seconds;
+            obj["mbPerSec"] = mbPerSec(r);
+            obj["samplesPerSec"] = samplesPerSec(r);
+            obj["allocsPerIteration"] = double(r.allocations) / r.iterations;
+            obj["allocCounter"] = ALLOCATION_COUNTER;
+            array.append(obj);
+        }
+        out << QJsonDocument(array).toJson();
+    }
+
+    void printCsv(QTextStream& out) const
+    {
+        out << "name,params,iterations,seconds,mbPerSec,samplesPerSec,allocsPerIteration\n";
+        for (auto& r : results)
+        {
+            out << r.name << "," << r.params << "," << r.iterations << ","
+                << r.seconds << "," << mbPerSec(r) << "," << samplesPerSec(r) << ","
+                << double(r.allocations) / r.iterations << "\n";
+        }
+    }
+
+private:
+    const Options& opt;
+    std::vector<Result> results;
+
+    static double mbPerSec(const Result& r)
+    {
+        return r.bytes * r.iterations / r.seconds / 1e6;
+    }
+
+    static double samplesPerSec(const Result& r)
+    {
+        return r.samples * r.iterations / r.seconds;
+    }
+};
+
+/// Sink that doesn't do anything, readers don't feed out without a sink
+class NullSink : public Sink
+{
+};
+
+/// Feeds given pack to connected sinks
+class PackSource : public Source
+{
+public:
+    PackSource(unsigned nc) : _numChannels(nc) {}
+
+    unsigned numChannels() const override {return _numChannels;}
+    bool hasX() const override {return false;}
+    void feed(const SamplePack& pack) const {feedOut(pack);}
+
+private:
+    unsigned _numChannels;
+};
+
+/// Returns a test signal value, sine with a different frequency per channel
+static double signal(unsigned ci, unsigned i)
+{
+    return 1000. * sin(2 * M_PI * (ci + 1) * i / 1000.);
+}
+
+/// Writes a single sample in given format (little endian)
+static void appendSample(QByteArray& data, NumberFormat nf, double value)
+{
+    char buf[8];
+    switch (nf)
+    {
+        case NumberFormat_uint8:  {uint8_t v = uint8_t(value + 128); memcpy(buf, &v, 1); break;}
+        case NumberFormat_int8:   {int8_t v = int8_t(value / 10); memcpy(buf, &v, 1); break;}
+        case NumberFormat_uint16: {uint16_t v = uint16_t(value + 1000); memcpy(buf, &v, 2); break;}
+        case NumberFormat_int16:  {int16_t v = int16_t(value); memcpy(buf, &v, 2); break;}
+        case NumberFormat_uint24:
+        case NumberFormat_uint32: {uint32_t v = uint32_t(value + 1000); memcpy(buf, &v, 4); break;}
+        case NumberFormat_int24:
+        case NumberFormat_int32:  {int32_t v = int32_t(value); memcpy(buf, &v, 4); break;}
+        case NumberFormat_float:  {float v = value; memcpy(buf, &v, 4); break;}
+        case NumberFormat_double: {memcpy(buf, &value, 8); break;}
+        default: Q_ASSERT(false);
+    }
+    data.append(buf, numberFormatByteSize(nf));
+}
+
+/**
+ * Feeds all of the data to the reader by signaling `readyRead` until
+ * the reader stops consuming.
+ */
+static void pumpReader(QBuffer& buffer, const QByteArray& data)
+{
+    buffer.close();
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    while (buffer.bytesAvailable())
+    {
+        qint64 pos = buffer.pos();
+        emit buffer.readyRead();
+        if (buffer.pos() == pos) break;
+    }
+}
+
+static void benchBinaryStreamReader(Runner& runner, const Options& opt, QSettings& settings)
+{
+    QByteArray data;
+    for (unsigned i = 0; i < opt.numSamples; i++)
+    {
+        for (unsigned ci = 0; ci < opt.numChannels; ci++)
+        {
+            appendSample(data, opt.numberFormat, signal(ci, i));
+        }
+    }
+
+    settings.beginGroup(SettingGroup_Binary);
+    settings.setValue(SG_Binary_NumOfChannels, opt.numChannels);
+    settings.setValue(SG_Binary_NumberFormat, numberFormatToStr(opt.numberFormat));
+    settings.setValue(SG_Binary_Endianness, "little");
+    settings.endGroup();
+
+    QBuffer buffer;
+    BinaryStreamReader reader(&buffer);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+    NullSink sink;
+    reader.connectSink(&sink);
+
+    runner.run("BinaryStreamReader",
+               QString("%1ch,%2").arg(opt.numChannels).arg(numberFormatToStr(opt.numberFormat)),
+               data.size(), uint64_t(opt.numSamples) * opt.numChannels,
+               [&]() { pumpReader(buffer, data); });
+}
+
+/// @param burst number of samples per channel in a frame
+static void benchFramedReader(Runner& runner, const Options& opt, QSettings& settings,
+                              unsigned burst)
+{
+    const char sync[] = {char(0xAA), char(0xBB)};
+    unsigned sampleSize = numberFormatByteSize(opt.numberFormat);
+    unsigned rowSize = opt.numChannels * sampleSize;
+    unsigned frameLength = sizeof(sync) + burst * rowSize;
+    unsigned numFrames = opt.numSamples / burst;
+
+    QByteArray data;
+    for (unsigned i = 0; i < numFrames * burst; i++)
+    {
+        if (i % burst == 0) data.append(sync, sizeof(sync));
+        for (unsigned ci = 0; ci < opt.numChannels; ci++)
+        {
+            appendSample(data, opt.numberFormat, signal(ci, i));
+        }
+    }
+
+    settings.beginGroup(SettingGroup_CustomFrame);
+    settings.setValue(SG_CustomFrame_NumOfChannels, opt.numChannels);
+    settings.setValue(SG_CustomFrame_FrameStart, "AA BB");
+    settings.setValue(SG_CustomFrame_TotalFrameLength, frameLength);
+    settings.setValue(SG_CustomFrame_Checksum, false);
+    settings.setValue(SG_CustomFrame_LengthField, false);
+    settings.setValue(SG_CustomFrame_DebugMode, false);
+    settings.beginGroup(SG_CustomFrame_ChannelMapping);
+    settings.setValue(SG_CustomFrame_SamplesPerFrame, burst);
+    for (unsigned ci = 0; ci < opt.numChannels; ci++)
+    {
+        settings.beginGroup(QString("%1_%2").arg(SG_CustomFrame_Channel).arg(ci));
+        settings.setValue(SG_CustomFrame_ChannelByteOffset, sizeof(sync) + ci * sampleSize);
+        settings.setValue(SG_CustomFrame_ChannelStride, rowSize);
+        settings.setValue(SG_CustomFrame_ChannelByteLength, sampleSize);
+        settings.setValue(SG_CustomFrame_ChannelFormat, numberFormatToStr(opt.numberFormat));
+        settings.setValue(SG_CustomFrame_ChannelEndianness, "little");
+        settings.setValue(SG_CustomFrame_ChannelEnabled, true);
+        settings.endGroup();
+    }
+    settings.endGroup();
+    settings.endGroup();
+
+    QBuffer buffer;
+    FramedReader reader(&buffer);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+    NullSink sink;
+    reader.connectSink(&sink);
+
+    runner.run("FramedReader",
+               QString("%1ch,%2,burst%3").arg(opt.numChannels)
+               .arg(numberFormatToStr(opt.numberFormat)).arg(burst),
+               data.size(), uint64_t(numFrames) * burst * opt.numChannels,
+               [&]() { pumpReader(buffer, data); });
+}
+
+static void benchAsciiReader(Runner& runner, const Options& opt, QSettings& settings,
+                             bool labeled, bool keyed)
+{
+    QByteArray data;
+    for (unsigned i = 0; i < opt.numSamples; i++)
+    {
+        for (unsigned ci = 0; ci < opt.numChannels; ci++)
+        {
+            if (labeled) data.append("ch").append(QByteArray::number(ci)).append(':');
+            data.append(QByteArray::number(signal(ci, i), 'f', 3));
+            data.append(ci == opt.numChannels-1 ? '\n' : ',');
+        }
+    }
+
+    settings.beginGroup(SettingGroup_ASCII);
+    settings.setValue(SG_ASCII_NumOfChannels, opt.numChannels);
+    settings.setValue(SG_ASCII_Delimiter, ",");
+    settings.setValue(SG_ASCII_FilterMode, "disabled");
+    settings.setValue(SG_ASCII_Hex, false);
+    settings.setValue(SG_ASCII_Keyed, keyed);
+    settings.remove(SG_ASCII_Keys);
+    settings.endGroup();
+
+    QBuffer buffer;
+    AsciiReader reader(&buffer);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+    NullSink sink;
+    reader.connectSink(&sink);
+
+    QString name = keyed ? "AsciiReader/keyed" : (labeled ? "AsciiReader/labeled" : "AsciiReader");
+    runner.run(name, QString("%1ch").arg(opt.numChannels),
+               data.size(), uint64_t(opt.numSamples) * opt.numChannels,
+               [&]() { pumpReader(buffer, data); });
+}
+
+static void benchRingBuffer(Runner& runner, const Options& opt)
+{
+    const unsigned chunkSize = 100;
+    RingBuffer buf(opt.numSamples);
+
+    std::vector<double> chunk(chunkSize);
+    for (unsigned i = 0; i < chunkSize; i++) chunk[i] = signal(0, i);
+
+    unsigned numChunks = opt.numSamples / chunkSize;
+    runner.run("RingBuffer::addSamples", QString("%1x%2").arg(numChunks).arg(chunkSize),
+               uint64_t(numChunks) * chunkSize * sizeof(double), uint64_t(numChunks) * chunkSize,
+               [&]()
+               {
+                   for (unsigned i = 0; i < numChunks; i++)
+                   {
+                       buf.addSamples(chunk.data(), chunkSize);
+                   }
+               });
+
+    // `limits` after each chunk, as it happens during plotting
+    runner.run("RingBuffer::limits", QString("%1 samples").arg(opt.numSamples),
+               0, opt.numSamples,
+               [&]()
+               {
+                   buf.addSamples(chunk.data(), chunkSize);
+                   volatile auto lim = buf.limits().start;
+                   (void) lim;
+               });
+}
+
+/// Per channel `RingBuffer`s versus a single `MultiRingBuffer`
+static void benchMultiChannelStorage(Runner& runner, const Options& opt)
+{
+    const unsigned chunkSize = 100;
+    unsigned numChunks = opt.numSamples / chunkSize;
+
+    SamplePack pack(chunkSize, opt.numChannels);
+    for (unsigned ci = 0; ci < opt.numChannels; ci++)
+    {
+        for (unsigned i = 0; i < chunkSize; i++) pack.data(ci)[i] = signal(ci, i);
+    }
+
+    std::vector<std::unique_ptr<RingBuffer>> bufs;
+    for (unsigned ci = 0; ci < opt.numChannels; ci++)
+    {
+        bufs.emplace_back(new RingBuffer(opt.numSamples));
+    }
+    runner.run("RingBuffer/perChannel", QString("%1ch %2x%3").arg(opt.numChannels).arg(numChunks).arg(chunkSize),
+               0, uint64_t(numChunks) * chunkSize * opt.numChannels,
+               [&]()
+               {
+                   for (unsigned i = 0; i < numChunks; i++)
+                   {
+                       for (unsigned ci = 0; ci < opt.numChannels; ci++)
+                       {
+                           bufs[ci]->addSamples(pack.data(ci), chunkSize);
+                       }
+                   }
+               });
+
+    MultiRingBuffer multi(opt.numChannels, opt.numSamples);
+    runner.run("MultiRingBuffer::addSamples", QString("%1ch %2x%3").arg(opt.numChannels).arg(numChunks).arg(chunkSize),
+               0, uint64_t(numChunks) * chunkSize * opt.numChannels,
+               [&]()
+               {
+                   for (unsigned i = 0; i < numChunks; i++)
+                   {
+                       multi.addSamples(pack);
+                   }
+               });
+}
+
+static void benchChecksums(Runner& runner)
+{
+    const unsigned size = 64 * 1024;
+    std::vector<uint8_t> data(size);
+    for (unsigned i = 0; i < size; i++) data[i] = uint8_t(i * 31 + 7);
+
+    const ChecksumAlgorithm algorithms[] =
+    {
+        ChecksumAlgorithm::CRC8,
+        ChecksumAlgorithm::CRC16,
+        ChecksumAlgorithm::CRC16_CCITT,
+        ChecksumAlgorithm::CRC16_MODBUS,
+        ChecksumAlgorithm::CRC32,
+        ChecksumAlgorithm::SUM8,
+        ChecksumAlgorithm::SUM16,
+        ChecksumAlgorithm::SUM24,
+        ChecksumAlgorithm::SUM32,
+        ChecksumAlgorithm::XOR8
+    };
+
+    for (auto algo : algorithms)
+    {
+        runner.run("ChecksumCalculator/" + ChecksumCalculator::algorithmToString(algo),
+                   "64KiB", size, 0,
+                   [&]()
+                   {
+                       volatile uint32_t r = ChecksumCalculator::calculate(algo, data.data(), size);
+                       (void) r;
+                   });
+    }
+}
+
+static void benchDataRecorder(Runner& runner, const Options& opt)
+{
+    QTemporaryDir dir;
+    DataRecorder recorder;
+    PackSource source(opt.numChannels);
+
+    SamplePack pack(opt.numSamples, opt.numChannels);
+    for (unsigned ci = 0; ci < opt.numChannels; ci++)
+    {
+        for (unsigned i = 0; i < opt.numSamples; i++)
+        {
+            pack.data(ci)[i] = signal(ci, i);
+        }
+    }
+
+    recorder.startRecording(dir.filePath("bench.csv"), ",", {}, DataRecorder::TimestampOption::disabled);
+    source.connectSink(&recorder);
+
+    runner.run("DataRecorder", QString("%1ch").arg(opt.numChannels),
+               0, uint64_t(opt.numSamples) * opt.numChannels,
+               [&]() { source.feed(pack); });
+
+    source.disconnectSinks();
+    recorder.stopRecording();
+}
+
+static void benchFrameBufferSeriesPaint(Runner& runner, const Options& opt)
+{
+    RingBuffer yBuf(opt.numSamples);
+    IndexBuffer xBuf(opt.numSamples);
+    std::vector<double> values(opt.numSamples);
+    for (unsigned i = 0; i < opt.numSamples; i++) values[i] = signal(0, i);
+    yBuf.addSamples(values.data(), opt.numSamples);
+
+    auto series = new FrameBufferSeries(&xBuf, &yBuf);
+    QwtPlotCurve curve;
+    curve.setSamples(series);   // takes ownership
+
+    QImage image(1000, 300, QImage::Format_ARGB32_Premultiplied);
+    QRectF canvasRect = image.rect();
+
+    QwtScaleMap xMap, yMap;
+    xMap.setPaintInterval(canvasRect.left(), canvasRect.right());
+    xMap.setScaleInterval(0, opt.numSamples - 1);
+    yMap.setPaintInterval(canvasRect.bottom(), canvasRect.top());
+    yMap.setScaleInterval(-1000, 1000);
+
+    runner.run("FrameBufferSeries/paint", QString("%1 samples").arg(opt.numSamples),
+               0, opt.numSamples,
+               [&]()
+               {
+                   image.fill(Qt::white);
+                   QPainter painter(&image);
+                   series->setRectOfInterest(QRectF(0, -1000, opt.numSamples - 1, 2000));
+                   curve.draw(&painter, xMap, yMap, canvasRect);
+               });
+}
+
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QString("Micro benchmarks for serialplot data path\n"
+                "allocsPerIteration counts %1 of this platform.").arg(ALLOCATION_COUNTER));
+    parser.addHelpOption();
+    QCommandLineOption channelsOpt("channels", "Number of channels.", "n", "8");
+    QCommandLineOption samplesOpt("samples", "Number of samples per channel.", "n", "100000");
+    QCommandLineOption iterationsOpt("iterations", "Number of measured runs.", "n", "10");
+    QCommandLineOption formatOpt("format", "Number format of binary data (int16, float etc.).",
+                                 "format", "int16");
+    QCommandLineOption filterOpt("filter", "Only run benchmarks whose name contains this text.",
+                                 "text");
+    QCommandLineOption csvOpt("csv", "Print results as CSV instead of JSON.");
+    parser.addOptions({channelsOpt, samplesOpt, iterationsOpt, formatOpt, filterOpt, csvOpt});
+    parser.process(app);
+
+    Options opt;
+    opt.numChannels = qBound(1u, parser.value(channelsOpt).toUInt(), MAX_NUM_CHANNELS);
+    opt.numSamples = qMax(100u, parser.value(samplesOpt).toUInt());
+    opt.iterations = qMax(1u, parser.value(iterationsOpt).toUInt());
+    opt.numberFormat = strToNumberFormat(parser.value(formatOpt));
+    opt.filter = parser.value(filterOpt);
+    if (opt.numberFormat == NumberFormat_INVALID)
+    {
+        qCritical() << "Invalid number format:" << parser.value(formatOpt);
+        return 1;
+    }
+
+    // readers are configured via their settings
+    QTemporaryFile settingsFile;
+    settingsFile.open();
+    QSettings settings(settingsFile.fileName(), QSettings::IniFormat);
+
+    Runner runner(opt);
+    benchBinaryStreamReader(runner, opt, settings);
+    benchFramedReader(runner, opt, settings, 1);
+    benchFramedReader(runner, opt, settings, 64);
+    benchAsciiReader(runner, opt, settings, false, false);
+    benchAsciiReader(runner, opt, settings, true, false);
+    benchAsciiReader(runner, opt, settings, true, true);
+    benchRingBuffer(runner, opt);
+    benchMultiChannelStorage(runner, opt);
+    benchChecksums(runner);
+    benchDataRecorder(runner, opt);
+    benchFrameBufferSeriesPaint(runner, opt);
+
+    QTextStream out(stdout);
+    if (parser.isSet(csvOpt))
+    {
+        runner.printCsv(out);
+    }
+    else
+    {
+        runner.printJson(out);
+    }
+
+    return 0;
+}
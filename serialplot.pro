@@ -58,12 +58,32 @@ SOURCES += \
     src/commandedit.cpp \
     src/dataformatpanel.cpp \
     src/plotcontrolpanel.cpp \
+    src/triggerpanel.cpp \
     src/recordpanel.cpp \
     src/datarecorder.cpp \
     src/rawdatarecorder.cpp \
     src/tooltipfilter.cpp \
     src/sneakylineedit.cpp \
     src/stream.cpp \
+    src/streammerger.cpp \
+    src/chunkdevice.cpp \
+    src/portsession.cpp \
+    src/portsessionspanel.cpp \
+    src/replaydevice.cpp \
+    src/replaypanel.cpp \
+    src/headlessrunner.cpp \
+    src/datasource.cpp \
+    src/sourcepanel.cpp \
+    src/metrics.cpp \
+    src/metricspanel.cpp \
+    src/tracer.cpp \
+    src/plotrenderer.cpp \
+    src/laneplot.cpp \
+    src/multiringbuffer.cpp \
+    src/statspanel.cpp \
+    src/protocoltrace.cpp \
+    src/protocoltraceview.cpp \
+    src/trigger.cpp \
     src/streamchannel.cpp \
     src/channelinfomodel.cpp \
     src/channelplotmapping.cpp \
@@ -72,6 +92,7 @@ SOURCES += \
     src/ringbuffer.cpp \
     src/indexbuffer.cpp \
     src/linindexbuffer.cpp \
+    src/xringbuffer.cpp \
     src/readonlybuffer.cpp \
     src/framebufferseries.cpp \
     src/numberformatbox.cpp \
@@ -89,12 +110,18 @@ SOURCES += \
     src/checksumcalculator.cpp \
     src/channelmappingdialog.cpp \
     src/checksumconfigdialog.cpp \
+    src/messagelayoutsdialog.cpp \
     src/plotmanager.cpp \
     src/plotmenu.cpp \
     src/barplot.cpp \
     src/barchart.cpp \
     src/barscaledraw.cpp \
+    src/fftplan.cpp \
+    src/spectrumanalyzer.cpp \
+    src/spectrumplot.cpp \
     src/numberformat.cpp \
+    src/numberparser.cpp \
+    src/channelkeymap.cpp \
     src/updatechecker.cpp \
     src/versionnumber.cpp \
     src/updatecheckdialog.cpp \
@@ -128,6 +155,26 @@ HEADERS += \
     src/sneakylineedit.h \
     src/framebufferseries.h \
     src/plotcontrolpanel.h \
+    src/triggerpanel.h \
+    src/streammerger.h \
+    src/chunkdevice.h \
+    src/portsession.h \
+    src/portsessionspanel.h \
+    src/replaydevice.h \
+    src/replaypanel.h \
+    src/headlessrunner.h \
+    src/datasource.h \
+    src/sourcepanel.h \
+    src/metrics.h \
+    src/metricspanel.h \
+    src/tracer.h \
+    src/plotrenderer.h \
+    src/laneplot.h \
+    src/multiringbuffer.h \
+    src/statspanel.h \
+    src/protocoltrace.h \
+    src/protocoltraceview.h \
+    src/trigger.h \
     src/numberformatbox.h \
     src/endiannessbox.h \
     src/framedreadersettings.h \
@@ -141,6 +188,8 @@ HEADERS += \
     src/plotmanager.h \
     src/setting_defines.h \
     src/numberformat.h \
+    src/numberparser.h \
+    src/channelkeymap.h \
     src/recordpanel.h \
     src/updatechecker.h \
     src/updatecheckdialog.h \
@@ -151,6 +200,9 @@ HEADERS += \
     src/barchart.h \
     src/barplot.h \
     src/barscaledraw.h \
+    src/fftplan.h \
+    src/spectrumanalyzer.h \
+    src/spectrumplot.h \
     src/channelinfomodel.h \
     src/channelplotmapping.h \
     src/channelplotmappingdialog.h \
@@ -164,6 +216,7 @@ HEADERS += \
     src/plotmenu.h \
     src/readonlybuffer.h \
     src/ringbuffer.h \
+    src/xringbuffer.h \
     src/samplecounter.h \
     src/samplepack.h \
     src/scrollbar.h \
@@ -178,7 +231,8 @@ HEADERS += \
     src/channelmapping.h \
     src/checksumcalculator.h \
     src/channelmappingdialog.h \
-    src/checksumconfigdialog.h
+    src/checksumconfigdialog.h \
+    src/messagelayoutsdialog.h
 
 FORMS += \
     src/mainwindow.ui \
@@ -189,6 +243,7 @@ FORMS += \
     src/commandwidget.ui \
     src/dataformatpanel.ui \
     src/plotcontrolpanel.ui \
+    src/triggerpanel.ui \
     src/numberformatbox.ui \
     src/endiannessbox.ui \
     src/framedreadersettings.ui \
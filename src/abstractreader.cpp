@@ -18,12 +18,45 @@
 */
 
 #include "abstractreader.h"
+#include "metrics.h"
+#include "tracer.h"
 
 AbstractReader::AbstractReader(QIODevice* device, QObject* parent) :
     QObject(parent)
 {
     _device = device;
     bytesRead = 0;
+    firstChannelAsX = false;
+}
+
+bool AbstractReader::hasX() const
+{
+    return firstChannelAsX && numReadChannels() > 1;
+}
+
+unsigned AbstractReader::numChannels() const
+{
+    return hasX() ? numReadChannels() - 1 : numReadChannels();
+}
+
+void AbstractReader::setFirstChannelAsX(bool enabled)
+{
+    if (enabled == firstChannelAsX) return;
+
+    firstChannelAsX = enabled;
+    updateNumChannels();
+}
+
+void AbstractReader::feedOut(const SamplePack& data) const
+{
+    if (hasX())
+    {
+        Source::feedOut(SamplePack::firstChannelAsX(data));
+    }
+    else
+    {
+        Source::feedOut(data);
+    }
 }
 
 void AbstractReader::pause(bool enabled)
@@ -45,9 +78,34 @@ void AbstractReader::enable(bool enabled)
     }
 }
 
+void AbstractReader::setDevice(QIODevice* device)
+{
+    Q_ASSERT(device != nullptr);
+    if (device == _device) return;
+
+    // move the `readyRead` connection if there is one
+    bool enabled = QObject::disconnect(_device, &QIODevice::readyRead,
+                                       this, &AbstractReader::onDataReady);
+    _device = device;
+    if (enabled)
+    {
+        QObject::connect(_device, &QIODevice::readyRead,
+                         this, &AbstractReader::onDataReady);
+    }
+}
+
 void AbstractReader::onDataReady()
 {
-    bytesRead += readData();
+    static MetricCounter& bytesIn = Metrics::instance().counter("reader.bytes_in");
+    static MetricGauge& backlog = Metrics::instance().gauge("reader.device_backlog");
+    static MetricHistogram& decodeTime = Metrics::instance().histogram("reader.decode_time");
+
+    TRACE_SCOPE("AbstractReader::readData");
+    backlog.set(_device->bytesAvailable());
+    MetricTimer timer(decodeTime);
+    unsigned n = readData();
+    bytesIn.add(n);
+    bytesRead += n;
 }
 
 unsigned AbstractReader::getBytesRead()
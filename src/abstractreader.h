@@ -46,8 +46,24 @@ public:
     /// 'disabled'.
     virtual void enable(bool enabled = true);
 
-    /// None of the current readers support X channel at the moment
-    bool hasX() const final { return false; };
+    /**
+     * Changes the device that reader reads from. If reader is
+     * enabled it continues reading from the new device, sinks stay
+     * connected.
+     */
+    void setDevice(QIODevice* device);
+
+    /// Returns the device that reader reads from
+    QIODevice* device() const {return _device;}
+
+    /// Returns true if first read channel is fed to sinks as X data
+    bool hasX() const final;
+
+    /// Returns number of channels fed to sinks, excluding X
+    unsigned numChannels() const final;
+
+    /// Returns number of channels read from device, including X
+    virtual unsigned numReadChannels() const = 0;
 
     /// Read and 'zero' the byte counter
     unsigned getBytesRead();
@@ -65,6 +81,12 @@ public slots:
      */
     void pause(bool enabled);
 
+    /**
+     * Use first channel of the read data as X. Ignored while there is only
+     * 1 channel.
+     */
+    void setFirstChannelAsX(bool enabled);
+
 protected:
     /// Reader should read from this device in `readData()` function.
     QIODevice* _device;
@@ -80,8 +102,12 @@ protected:
      */
     virtual unsigned readData() = 0;
 
+    /// Re-implemented to split X data when first channel is used as X
+    void feedOut(const SamplePack& data) const override;
+
 private:
     unsigned bytesRead;
+    bool firstChannelAsX;
 
 private slots:
     void onDataReady();
@@ -17,22 +17,69 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
+#include <limits>
 #include <QtDebug>
 
+#include "defines.h"
+#include "setting_defines.h"
 #include "asciireader.h"
+#include "numberparser.h"
 
 /// If set to this value number of channels is determined from input
 #define NUMOFCHANNELS_AUTO   (0)
 
+/// Incomplete lines longer than this are discarded
+#define MAX_LINE_LENGTH      (64 * 1024)
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+/// Moves given range boundaries to skip the leading and trailing whitespace
+static inline void trim(const char*& begin, const char*& end)
+{
+    while (begin < end && isSpace(*begin)) begin++;
+    while (end > begin && isSpace(*(end-1))) end--;
+}
+
+/// Returns pointer to the first occurrence of `delim` or `end` if not found
+static inline const char* findDelimiter(const char* begin, const char* end,
+                                        const QByteArray& delim)
+{
+    if (delim.isEmpty() || end - begin < delim.size())
+    {
+        return end;
+    }
+    else if (delim.size() == 1)
+    {
+        auto r = (const char*) memchr(begin, delim[0], end - begin);
+        return r == nullptr ? end : r;
+    }
+
+    const char* last = end - delim.size();
+    for (const char* p = begin; p <= last; p++)
+    {
+        if (memcmp(p, delim.constData(), delim.size()) == 0) return p;
+    }
+    return end;
+}
+
 AsciiReader::AsciiReader(QIODevice* device, QObject* parent) :
     AbstractReader(device, parent)
 {
     paused = false;
+    batchNumRows = 0;
 
     _numChannels = _settingsWidget.numOfChannels();
     autoNumOfChannels = (_numChannels == NUMOFCHANNELS_AUTO);
-    delimiter = _settingsWidget.delimiter();
+    delimiter = _settingsWidget.delimiter().toUtf8();
     isHexData = _settingsWidget.isHex();
+    filterMode = _settingsWidget.filterMode();
+    filterPrefix = _settingsWidget.filterPrefix().toUtf8();
+    keyed = _settingsWidget.isKeyed();
+    missingKeyMode = _settingsWidget.missingKeyMode();
 
     connect(&_settingsWidget, &AsciiReaderSettings::numOfChannelsChanged,
             [this](unsigned value)
@@ -50,19 +97,30 @@ AsciiReader::AsciiReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &AsciiReaderSettings::delimiterChanged,
             [this](QString d)
             {
-                delimiter = d;
+                delimiter = d.toUtf8();
             });
     connect(&_settingsWidget, &AsciiReaderSettings::filterChanged,
             [this](AsciiReaderSettings::FilterMode mode, QString prefix)
             {
                 filterMode = mode;
-                filterPrefix = prefix;
+                filterPrefix = prefix.toUtf8();
             });
     connect(&_settingsWidget, &AsciiReaderSettings::hexChanged,
             [this](bool hexData)
             {
                 isHexData = hexData;
             });
+    connect(&_settingsWidget, &AsciiReaderSettings::keyedChanged,
+            [this](bool enabled)
+            {
+                keyed = enabled;
+                resetKeys();
+            });
+    connect(&_settingsWidget, &AsciiReaderSettings::missingKeyModeChanged,
+            [this](AsciiReaderSettings::MissingKeyMode mode)
+            {
+                missingKeyMode = mode;
+            });
 }
 
 QWidget* AsciiReader::settingsWidget()
@@ -70,7 +128,7 @@ QWidget* AsciiReader::settingsWidget()
     return &_settingsWidget;
 }
 
-unsigned AsciiReader::numChannels() const
+unsigned AsciiReader::numReadChannels() const
 {
     // TODO: an alternative is to never set _numChannels to '0'
     // do not allow '0'
@@ -82,6 +140,7 @@ void AsciiReader::enable(bool enabled)
     if (enabled)
     {
         firstReadAfterEnable = true;
+        lineBuffer.clear();
     }
 
     AbstractReader::enable(enabled);
@@ -89,13 +148,29 @@ void AsciiReader::enable(bool enabled)
 
 unsigned AsciiReader::readData()
 {
-    unsigned numBytesRead = 0;
+    QByteArray bytes = _device->readAll();
+    unsigned numBytesRead = bytes.size();
 
-    while(_device->canReadLine())
+    // avoid a copy when there is no partial line left from previous read
+    if (lineBuffer.isEmpty())
     {
-        QByteArray bytes = _device->readLine();
-        QString line = QString(bytes);
-        numBytesRead += bytes.size();
+        lineBuffer = bytes;
+    }
+    else
+    {
+        lineBuffer.append(bytes);
+    }
+
+    const char* data = lineBuffer.constData();
+    const char* dataEnd = data + lineBuffer.size();
+    const char* lineStart = data;
+    const char* lineEnd;
+
+    while ((lineEnd = (const char*) memchr(lineStart, '\n', dataEnd - lineStart)) != nullptr)
+    {
+        const char* begin = lineStart;
+        const char* end = lineEnd;
+        lineStart = lineEnd + 1;
 
         // discard only once when we just started reading
         if (firstReadAfterEnable)
@@ -110,107 +185,266 @@ unsigned AsciiReader::readData()
             continue;
         }
 
-        // parse data
-        line = line.trimmed();
+        trim(begin, end);
 
         // Note: When data coming from pseudo terminal is buffered by
         // system CR is converted to LF for some reason. This causes
         // empty lines in the input when the port is just opened.
-        if (line.isEmpty())
+        if (begin == end)
         {
             continue;
         }
 
+        bool prefixMatch = (end - begin) >= filterPrefix.size() &&
+            memcmp(begin, filterPrefix.constData(), filterPrefix.size()) == 0;
         switch (filterMode)
         {
             // skip lines that match the prefix
             case AsciiReaderSettings::FilterMode::exclude:
-                if (line.startsWith(filterPrefix)) continue;
+                if (prefixMatch) continue;
                 break;
             // skip lines that doesn't match, and cut off prefix
             case AsciiReaderSettings::FilterMode::include:
-                if (!line.startsWith(filterPrefix)) continue;
-                line = line.remove(0, filterPrefix.length()).trimmed();
+                if (!prefixMatch) continue;
+                begin += filterPrefix.size();
+                trim(begin, end);
                 break;
             case AsciiReaderSettings::FilterMode::disabled:
                 break;
         }
 
-        const SamplePack* samples = parseLine(line);
-        if (samples != nullptr) {
-            // update number of channels if in auto mode
-            if (autoNumOfChannels ) {
-                unsigned nc = samples->numChannels();
-                if (nc != _numChannels) {
-                    _numChannels = nc;
-                    updateNumChannels();
-                    // TODO: is `numOfChannelsChanged` signal still used?
-                    emit numOfChannelsChanged(nc);
-                }
-            }
+        if (!parseLine(begin, end))
+        {
+            qWarning() << "Read line: " << QByteArray(begin, end - begin);
+        }
+    }
 
-            Q_ASSERT(samples->numChannels() == _numChannels);
+    feedBatch();
 
-            // commit data
-            feedOut(*samples);
-            delete samples;
-        }
+    // keep the incomplete line for next read
+    lineBuffer.remove(0, lineStart - data);
+    if (lineBuffer.size() > MAX_LINE_LENGTH)
+    {
+        qWarning() << "Line is too long, discarding" << lineBuffer.size() << "bytes.";
+        lineBuffer.clear();
     }
 
     return numBytesRead;
 }
 
-SamplePack* AsciiReader::parseLine(const QString& line) const
+bool AsciiReader::parseLine(const char* begin, const char* end)
 {
-    auto separatedValues = line.split(delimiter, Qt::SkipEmptyParts);
-    unsigned numComingChannels = separatedValues.length();
-
-    // check number of channels (skipped if auto num channels is enabled)
-    if ((!numComingChannels) || (!autoNumOfChannels && numComingChannels != _numChannels))
+    if (keyed)
     {
-        qWarning() << "Line parsing error: invalid number of channels!";
-        qWarning() << "Read line: " << line;
-        return nullptr;
-    }
+        newKeys.clear();
 
-    // parse data per channel
-    auto samples = new SamplePack(1, numComingChannels);
-    for (unsigned ci = 0; ci < numComingChannels; ci++)
-    {
-        // Strip arduino style labels from data
-        QString strippedValue = separatedValues[ci].section(':', -1);
-        bool ok;
-        if (isHexData)
+        // start from previous values of channels, see `findKeyChannel()`
+        if (missingKeyMode == AsciiReaderSettings::MissingKeyMode::hold)
         {
-            samples->data(ci)[0] = strippedValue.toInt(&ok,16);
+            lineValues = lastValues;
         }
         else
         {
-            samples->data(ci)[0] = strippedValue.toDouble(&ok);
+            lineValues.assign(lastValues.size(), std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    else
+    {
+        lineValues.clear();
+    }
+
+    const char* fieldStart = begin;
+    while (true)
+    {
+        const char* fieldEnd = findDelimiter(fieldStart, end, delimiter);
+        const char* fb = fieldStart;
+        const char* fe = fieldEnd;
+
+        // skip empty parts
+        if (fb != fe)
+        {
+            // find arduino style label
+            const char* valueStart = fb;
+            for (const char* p = fe; p > fb; p--)
+            {
+                if (*(p-1) == ':')
+                {
+                    valueStart = p;
+                    break;
+                }
+            }
+
+            const char* vb = valueStart;
+            const char* ve = fe;
+            trim(vb, ve);
+
+            double value;
+            bool ok = isHexData ? parseHex(vb, ve, &value) : parseDecimal(vb, ve, &value);
             if (!ok)
             {
-                samples->data(ci)[0] = strippedValue.toInt(&ok,0);
+                qWarning() << "Data parsing error for channel: " << lineValues.size();
+                return false;
+            }
+
+            if (!keyed)
+            {
+                lineValues.push_back(value);
+            }
+            else if (valueStart == fb)
+            {
+                qWarning() << "Line parsing error: value without label!";
+                return false;
+            }
+            else
+            {
+                const char* kb = fb;
+                const char* ke = valueStart - 1; // skip ':'
+                trim(kb, ke);
+
+                int ci = findKeyChannel(kb, ke - kb);
+                if (ci != ChannelKeyMap::NOT_FOUND)
+                {
+                    if ((unsigned) ci >= lineValues.size())
+                    {
+                        lineValues.resize(ci+1, std::numeric_limits<double>::quiet_NaN());
+                    }
+                    lineValues[ci] = value;
+                }
             }
         }
-        if (!ok)
+
+        if (fieldEnd == end) break;
+        fieldStart = fieldEnd + delimiter.size();
+    }
+
+    if (keyed)
+    {
+        // channels that haven't been seen yet
+        unsigned nc = autoNumOfChannels ? keyMap.size() + newKeys.size() : _numChannels;
+        lineValues.resize(nc, std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // check number of channels (skipped if auto num channels is enabled)
+    unsigned numComingChannels = lineValues.size();
+    if ((!numComingChannels) || (!autoNumOfChannels && numComingChannels != _numChannels))
+    {
+        qWarning() << "Line parsing error: invalid number of channels!";
+        return false;
+    }
+
+    if (keyed)
+    {
+        // line is valid, keep its labels and values
+        for (auto& key : newKeys)
         {
-            qWarning() << "Data parsing error for channel: " << ci;
-            qWarning() << "Read line: " << line;
+            keyMap.add(key.constData(), key.size());
+        }
+        lastValues = lineValues;
+    }
+
+    // update number of channels if in auto mode
+    if (autoNumOfChannels && numComingChannels != _numChannels)
+    {
+        // lines read so far belong to old channel configuration
+        feedBatch();
+
+        _numChannels = numComingChannels;
+        updateNumChannels();
+        // TODO: is `numOfChannelsChanged` signal still used?
+        emit numOfChannelsChanged(numComingChannels);
+    }
+
+    batch.insert(batch.end(), lineValues.begin(), lineValues.end());
+    batchNumRows++;
 
-            delete samples;
-            return nullptr;
+    return true;
+}
+
+int AsciiReader::findKeyChannel(const char* key, unsigned length)
+{
+    int ci = keyMap.find(key, length);
+    unsigned maxChannels = autoNumOfChannels ? MAX_NUM_CHANNELS : _numChannels;
+
+    if (ci == ChannelKeyMap::NOT_FOUND)
+    {
+        // new keys are rare, a linear search is enough
+        int ni = newKeys.indexOf(QByteArray::fromRawData(key, length));
+        if (ni >= 0) return keyMap.size() + ni;
+
+        // discover new key if there is room
+        if (keyMap.size() + newKeys.size() >= maxChannels) return ChannelKeyMap::NOT_FOUND;
+        newKeys.append(QByteArray(key, length));
+        ci = keyMap.size() + newKeys.size() - 1;
+    }
+    else if ((unsigned) ci >= maxChannels)
+    {
+        return ChannelKeyMap::NOT_FOUND;
+    }
+
+    return ci;
+}
+
+void AsciiReader::resetKeys()
+{
+    keyMap.clear();
+    lastValues.clear();
+}
+
+void AsciiReader::feedBatch()
+{
+    if (!batchNumRows) return;
+
+    unsigned nc = batch.size() / batchNumRows;
+    Q_ASSERT(nc == _numChannels);
+
+    // transpose lines into channel buffers
+    SamplePack samples(batchNumRows, nc);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        double* chData = samples.data(ci);
+        const double* src = batch.data() + ci;
+        for (unsigned i = 0; i < batchNumRows; i++)
+        {
+            chData[i] = src[i * nc];
         }
     }
 
-    return samples;
+    batch.clear();
+    batchNumRows = 0;
+
+    feedOut(samples);
 }
 
 void AsciiReader::saveSettings(QSettings* settings)
 {
     _settingsWidget.saveSettings(settings);
+
+    // save discovered keys so that channel order is kept
+    QStringList keys;
+    for (auto& key : keyMap.keys())
+    {
+        keys << QString::fromUtf8(key);
+    }
+    settings->beginGroup(SettingGroup_ASCII);
+    settings->setValue(SG_ASCII_Keys, keys);
+    settings->endGroup();
 }
 
 void AsciiReader::loadSettings(QSettings* settings)
 {
     _settingsWidget.loadSettings(settings);
+
+    settings->beginGroup(SettingGroup_ASCII);
+    auto keysS = settings->value(SG_ASCII_Keys).toStringList();
+    settings->endGroup();
+
+    // settings file may have been edited, skip duplicate keys
+    QList<QByteArray> keys;
+    for (auto& key : keysS)
+    {
+        QByteArray k = key.toUtf8();
+        if ((unsigned) keys.size() < MAX_NUM_CHANNELS && !keys.contains(k)) keys << k;
+    }
+    keyMap.setKeys(keys);
+    lastValues.clear();
 }
@@ -22,10 +22,13 @@
 
 #include <QSettings>
 #include <QString>
+#include <QByteArray>
+#include <vector>
 
 #include "samplepack.h"
 #include "abstractreader.h"
 #include "asciireadersettings.h"
+#include "channelkeymap.h"
 
 class AsciiReader : public AbstractReader
 {
@@ -34,7 +37,7 @@ class AsciiReader : public AbstractReader
 public:
     explicit AsciiReader(QIODevice* device, QObject *parent = 0);
     QWidget* settingsWidget();
-    unsigned numChannels() const;
+    unsigned numReadChannels() const override;
     void enable(bool enabled) override;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -46,23 +49,48 @@ private:
     unsigned _numChannels;
     /// number of channels will be determined from incoming data
     unsigned autoNumOfChannels;
-    QString delimiter; ///< selected column delimiter
+    QByteArray delimiter; ///< selected column delimiter
     bool isHexData; ///< use hex encoding instead of decimal
     AsciiReaderSettings::FilterMode filterMode;
-    QString filterPrefix; ///< selected ASCII mode filter prefix
+    QByteArray filterPrefix; ///< selected ASCII mode filter prefix
+    bool keyed; ///< values are routed to channels by their labels
+    AsciiReaderSettings::MissingKeyMode missingKeyMode;
+    ChannelKeyMap keyMap; ///< channel of each label in `keyed` mode
+    /// labels first seen in the line being parsed, added to `keyMap` if line is valid
+    QList<QByteArray> newKeys;
+    std::vector<double> lastValues; ///< last line in `keyed` mode
 
     bool firstReadAfterEnable = false;
 
+    QByteArray lineBuffer;       ///< read data waiting for the line end
+    std::vector<double> lineValues; ///< values of the line being parsed
+    std::vector<double> batch;   ///< parsed values in row order
+    unsigned batchNumRows;       ///< number of lines in `batch`
+
     unsigned readData() override;
 
-private slots:
+    /**
+     * Parses a line (trimmed, filtered) and adds its values to the
+     * current batch.
+     *
+     * @return `false` in case of error.
+     */
+    bool parseLine(const char* begin, const char* end);
 
     /**
-     * Parses given line and returns sample pack.
+     * Returns channel of the label in `keyed` mode. New labels are
+     * assigned to next channel until there is no room. They are kept
+     * in `newKeys` until the line is accepted.
      *
-     * Returns `nullptr` in case of error.
+     * @return `ChannelKeyMap::NOT_FOUND` if label is ignored
      */
-    SamplePack* parseLine(const QString& line) const;
+    int findKeyChannel(const char* key, unsigned length);
+
+    /// Forget discovered labels
+    void resetKeys();
+
+    /// Feeds out the batched lines as a single `SamplePack`
+    void feedBatch();
 };
 
 #endif // ASCIIREADER_H
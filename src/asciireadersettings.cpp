@@ -79,6 +79,19 @@ AsciiReaderSettings::AsciiReaderSettings(QWidget *parent) :
                 emit filterChanged(filterMode(), text);
             });
 
+    connect(ui->cbKeyed, &QCheckBox::toggled,
+            [this](bool checked)
+            {
+                ui->cbMissingKey->setEnabled(checked);
+                emit keyedChanged(checked);
+            });
+
+    connect(ui->cbMissingKey, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                emit missingKeyModeChanged(static_cast<MissingKeyMode>(index));
+            });
+
     // Note: if directly connected we get a runtime warning on incompatible signal arguments
     connect(ui->spNumOfChannels, &QSpinBox::valueChanged,
             [this](int value)
@@ -102,6 +115,21 @@ AsciiReaderSettings::FilterMode AsciiReaderSettings::filterMode() const
     return static_cast<FilterMode>(filterButtons.checkedId());
 }
 
+QString AsciiReaderSettings::filterPrefix() const
+{
+    return ui->leFilterPrefix->text();
+}
+
+bool AsciiReaderSettings::isKeyed() const
+{
+    return ui->cbKeyed->isChecked();
+}
+
+AsciiReaderSettings::MissingKeyMode AsciiReaderSettings::missingKeyMode() const
+{
+    return static_cast<MissingKeyMode>(ui->cbMissingKey->currentIndex());
+}
+
 QString AsciiReaderSettings::delimiter() const
 {
     if (ui->rbComma->isChecked())
@@ -192,6 +220,11 @@ void AsciiReaderSettings::saveSettings(QSettings* settings)
     settings->setValue(SG_ASCII_FilterMode, filterModeS);
     settings->setValue(SG_ASCII_FilterPrefix, ui->leFilterPrefix->text());
 
+    // save label mode
+    settings->setValue(SG_ASCII_Keyed, isKeyed());
+    settings->setValue(SG_ASCII_MissingKey,
+                       missingKeyMode() == MissingKeyMode::hold ? "hold" : "nan");
+
     settings->endGroup();
 }
 
@@ -260,5 +293,17 @@ void AsciiReaderSettings::loadSettings(QSettings* settings)
     auto filterPrefixS = settings->value(SG_ASCII_FilterPrefix, ui->leFilterPrefix->text()).toString();
     ui->leFilterPrefix->setText(filterPrefixS);
 
+    // load label mode
+    ui->cbKeyed->setChecked(settings->value(SG_ASCII_Keyed, isKeyed()).toBool());
+    auto missingKeyS = settings->value(SG_ASCII_MissingKey, "").toString();
+    if (missingKeyS == "hold")
+    {
+        ui->cbMissingKey->setCurrentIndex(static_cast<int>(MissingKeyMode::hold));
+    }
+    else if (missingKeyS == "nan")
+    {
+        ui->cbMissingKey->setCurrentIndex(static_cast<int>(MissingKeyMode::nan));
+    }
+
     settings->endGroup();
 }
@@ -40,12 +40,23 @@ public:
         disabled, include, exclude
     };
 
+    /// Value of a channel when its label is missing in "channel by label" mode
+    enum class MissingKeyMode
+    {
+        hold, nan
+    };
+
     explicit AsciiReaderSettings(QWidget *parent = 0);
     ~AsciiReaderSettings();
 
     unsigned numOfChannels() const;
     QString delimiter() const;
     bool isHex() const;
+    FilterMode filterMode() const;
+    QString filterPrefix() const;
+    /// Values are routed to channels by their labels
+    bool isKeyed() const;
+    MissingKeyMode missingKeyMode() const;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -57,6 +68,8 @@ signals:
     void delimiterChanged(QString);
     void hexChanged(bool);
     void filterChanged(FilterMode, QString);
+    void keyedChanged(bool);
+    void missingKeyModeChanged(MissingKeyMode);
 
 private:
     Ui::AsciiReaderSettings *ui;
@@ -64,8 +77,6 @@ private:
     QButtonGroup delimiterButtons;
     QButtonGroup filterButtons;
 
-    FilterMode filterMode() const;
-
 private slots:
     void delimiterToggled(bool checked);
     void customDelimiterChanged(const QString text);
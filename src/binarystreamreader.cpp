@@ -56,7 +56,7 @@ QWidget* BinaryStreamReader::settingsWidget()
     return &_settingsWidget;
 }
 
-unsigned BinaryStreamReader::numChannels() const
+unsigned BinaryStreamReader::numReadChannels() const
 {
     return _numChannels;
 }
@@ -36,7 +36,7 @@ class BinaryStreamReader : public AbstractReader
 public:
     explicit BinaryStreamReader(QIODevice* device, QObject *parent = 0);
     QWidget* settingsWidget();
-    unsigned numChannels() const;
+    unsigned numReadChannels() const override;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
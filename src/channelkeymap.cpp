@@ -0,0 +1,152 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include <QtGlobal>
+#include <QSet>
+
+#include "channelkeymap.h"
+
+/// Minimum (initial) size of the lookup table
+#define MIN_TABLE_SIZE   (8)
+/// Number of seeds to try before growing the table
+#define MAX_SEED_TRIES   (64)
+/// Table isn't grown beyond this size to find a collision free hash
+#define MAX_TABLE_SIZE   (1 << 16)
+
+ChannelKeyMap::ChannelKeyMap()
+{
+    rebuild();
+}
+
+unsigned ChannelKeyMap::size() const
+{
+    return _keys.size();
+}
+
+uint32_t ChannelKeyMap::hash(const char* key, unsigned length, uint32_t seed)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u ^ seed;
+    for (unsigned i = 0; i < length; i++)
+    {
+        h ^= (uint8_t) key[i];
+        h *= 16777619u;
+    }
+    // mix high bits in, table index is taken from low bits
+    h ^= h >> 15;
+    return h;
+}
+
+int ChannelKeyMap::find(const char* key, unsigned length) const
+{
+    uint32_t slot = hash(key, length, seed) & mask;
+    while (true)
+    {
+        int index = table[slot];
+        if (index == NOT_FOUND) return NOT_FOUND;
+
+        const QByteArray& k = _keys[index];
+        if ((unsigned) k.size() == length && memcmp(k.constData(), key, length) == 0)
+        {
+            return index;
+        }
+        if (!probing) return NOT_FOUND;
+        // table is at most half full, probe ends at an empty slot
+        slot = (slot + 1) & mask;
+    }
+}
+
+unsigned ChannelKeyMap::add(const char* key, unsigned length)
+{
+    Q_ASSERT(find(key, length) == NOT_FOUND);
+
+    _keys.append(QByteArray(key, length));
+    rebuild();
+    return _keys.size() - 1;
+}
+
+const QList<QByteArray>& ChannelKeyMap::keys() const
+{
+    return _keys;
+}
+
+void ChannelKeyMap::setKeys(const QList<QByteArray>& keys)
+{
+    // a duplicate key would collide with every seed
+    _keys.clear();
+    QSet<QByteArray> seen;
+    for (auto& key : keys)
+    {
+        if (!seen.contains(key))
+        {
+            seen.insert(key);
+            _keys.append(key);
+        }
+    }
+    rebuild();
+}
+
+void ChannelKeyMap::clear()
+{
+    _keys.clear();
+    rebuild();
+}
+
+void ChannelKeyMap::rebuild()
+{
+    uint32_t minTableSize = MIN_TABLE_SIZE;
+    while (minTableSize < 2 * (uint32_t) _keys.size()) minTableSize *= 2;
+
+    probing = false;
+    for (uint32_t tableSize = minTableSize; tableSize <= MAX_TABLE_SIZE; tableSize *= 2)
+    {
+        for (uint32_t s = 0; s < MAX_SEED_TRIES; s++)
+        {
+            table.assign(tableSize, NOT_FOUND);
+            bool collision = false;
+            for (int i = 0; i < _keys.size() && !collision; i++)
+            {
+                int& slot = table[hash(_keys[i].constData(), _keys[i].size(), s) & (tableSize-1)];
+                collision = (slot != NOT_FOUND);
+                slot = i;
+            }
+
+            if (!collision)
+            {
+                mask = tableSize - 1;
+                seed = s;
+                return;
+            }
+        }
+    }
+
+    // no collision free hash, fall back to linear probing
+    probing = true;
+    mask = minTableSize - 1;
+    seed = 0;
+    table.assign(minTableSize, NOT_FOUND);
+    for (int i = 0; i < _keys.size(); i++)
+    {
+        uint32_t slot = hash(_keys[i].constData(), _keys[i].size(), seed) & mask;
+        while (table[slot] != NOT_FOUND) slot = (slot + 1) & mask;
+        table[slot] = i;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef CHANNELKEYMAP_H
+#define CHANNELKEYMAP_H
+
+#include <stdint.h>
+#include <vector>
+#include <QByteArray>
+#include <QList>
+
+/**
+ * Maps channel labels (keys) to channel indexes.
+ *
+ * Lookup table is rebuilt with a collision free (perfect) hash
+ * whenever a key is added. So a lookup costs a single hash of the key
+ * bytes and one comparison. Keys are expected to be added rarely
+ * (discovered at the start of the data) and looked up for every value.
+ * If no collision free hash is found up to a maximum table size, table
+ * falls back to linear probing.
+ */
+class ChannelKeyMap
+{
+public:
+    /// Returned by `find` if key doesn't exist
+    enum Index {NOT_FOUND = -1};
+
+    ChannelKeyMap();
+
+    /// Number of keys
+    unsigned size() const;
+    /// Returns channel index of the key or `NOT_FOUND`
+    int find(const char* key, unsigned length) const;
+    /// Adds a new key and returns its index, key shouldn't exist already
+    unsigned add(const char* key, unsigned length);
+    /// List of keys in channel order
+    const QList<QByteArray>& keys() const;
+    /// Replaces all keys, only the first of duplicate keys is kept
+    void setKeys(const QList<QByteArray>& keys);
+    /// Removes all keys
+    void clear();
+
+private:
+    QList<QByteArray> _keys;
+    std::vector<int> table;  ///< key indexes, -1 for empty slots
+    uint32_t mask;           ///< table size - 1
+    uint32_t seed;           ///< seed of the collision free hash
+    bool probing;            ///< table uses linear probing, hash isn't collision free
+
+    /// Finds a seed and table size that doesn't have any collisions,
+    /// falls back to linear probing if there isn't one
+    void rebuild();
+    static uint32_t hash(const char* key, unsigned length, uint32_t seed);
+};
+
+#endif // CHANNELKEYMAP_H
@@ -19,7 +19,8 @@
 
 #include "channelmapping.h"
 
-ChannelMappingConfig::ChannelMappingConfig()
+ChannelMappingConfig::ChannelMappingConfig() :
+    _repeat(1)
 {
 }
 
@@ -51,6 +52,16 @@ unsigned ChannelMappingConfig::numChannels() const
     return _channels.size();
 }
 
+unsigned ChannelMappingConfig::repeat() const
+{
+    return _repeat;
+}
+
+void ChannelMappingConfig::setRepeat(unsigned repeat)
+{
+    _repeat = qBound(1u, repeat, MAX_SAMPLES_PER_FRAME);
+}
+
 ChannelMapping& ChannelMappingConfig::channel(unsigned index)
 {
     if (index >= _channels.size())
@@ -65,35 +76,97 @@ const ChannelMapping& ChannelMappingConfig::channel(unsigned index) const
     return _channels[index];
 }
 
+/**
+ * Marks the bits of frame covered by channel, starting from its
+ * `byteOffset`. Returns number of bytes covered.
+ */
+static unsigned channelBitMasks(const ChannelMapping& ch, uint8_t masks[MAX_BIT_FIELD_BYTES])
+{
+    if (!ch.isBitField())
+    {
+        unsigned n = qMin(ch.byteLength, MAX_BIT_FIELD_BYTES);
+        for (unsigned i = 0; i < n; i++) masks[i] = 0xFF;
+        return n;
+    }
+
+    unsigned n = ch.dataLength();
+    for (unsigned i = 0; i < n; i++) masks[i] = 0;
+    for (unsigned b = ch.bitOffset; b < ch.bitOffset + ch.bitWidth; b++)
+    {
+        unsigned byte = ch.endianness == LittleEndian ? b / 8 : n - 1 - b / 8;
+        masks[byte] |= 1 << (b % 8);
+    }
+    return n;
+}
+
 bool ChannelMappingConfig::isValid(unsigned payloadSize, QString& errorMsg) const
 {
-    // Check for overlapping byte ranges
+    // Check bit fields
     for (size_t i = 0; i < _channels.size(); i++)
     {
-        for (size_t j = i + 1; j < _channels.size(); j++)
+        const ChannelMapping& ch = _channels[i];
+        if (!ch.isBitField()) continue;
+
+        if (ch.numberFormat == NumberFormat_float || ch.numberFormat == NumberFormat_double)
         {
-            unsigned end_i = _channels[i].byteOffset + _channels[i].byteLength;
-            unsigned end_j = _channels[j].byteOffset + _channels[j].byteLength;
-            
-            // Check overlap
-            if ((_channels[i].byteOffset < end_j && end_i > _channels[j].byteOffset))
-            {
-                errorMsg = QString("Channel %1 and %2 have overlapping byte ranges!").arg(i).arg(j);
-                return false;
-            }
+            errorMsg = QString("Channel %1 bit field should have an integer format!").arg(i + 1);
+            return false;
+        }
+        if (ch.bitWidth > 32)
+        {
+            errorMsg = QString("Channel %1 bit field can't be wider than 32 bits!").arg(i + 1);
+            return false;
+        }
+        if (ch.dataLength() > MAX_BIT_FIELD_BYTES)
+        {
+            errorMsg = QString("Channel %1 bit field spans more than %2 bytes!")
+                .arg(i + 1).arg(MAX_BIT_FIELD_BYTES);
+            return false;
         }
     }
-    
-    // Check if all bytes are within payload size
+
+    // Check if all samples are within payload size
     for (size_t i = 0; i < _channels.size(); i++)
     {
-        unsigned end = _channels[i].byteOffset + _channels[i].byteLength;
+        const ChannelMapping& ch = _channels[i];
+        uint8_t masks[MAX_BIT_FIELD_BYTES];
+        unsigned length = qMax(ch.byteLength, channelBitMasks(ch, masks));
+        quint64 end = ch.byteOffset + quint64(_repeat - 1) * ch.sampleStride() + length;
         if (end > payloadSize)
         {
             errorMsg = QString("Channel %1 extends beyond payload size!").arg(i + 1);
             return false;
         }
     }
+
+    // Check for overlapping bits of all samples, bit fields may share bytes
+    std::vector<uint8_t> used(payloadSize, 0);
+    std::vector<int> owner(payloadSize, -1);
+    for (size_t i = 0; i < _channels.size(); i++)
+    {
+        const ChannelMapping& ch = _channels[i];
+        uint8_t masks[MAX_BIT_FIELD_BYTES];
+        unsigned length = channelBitMasks(ch, masks);
+
+        for (unsigned r = 0; r < _repeat; r++)
+        {
+            unsigned offset = ch.byteOffset + r * ch.sampleStride();
+            for (unsigned k = 0; k < length; k++)
+            {
+                if (used[offset + k] & masks[k])
+                {
+                    int j = owner[offset + k];
+                    if (j == (int) i)
+                        errorMsg = QString("Channel %1 samples overlap, stride is too small!").arg(i + 1);
+                    else
+                        errorMsg = QString("Channel %1 and %2 have overlapping byte ranges!").arg(j + 1).arg(i + 1);
+                    return false;
+                }
+                used[offset + k] |= masks[k];
+                owner[offset + k] = i;
+            }
+        }
+    }
     
     return true;
 }
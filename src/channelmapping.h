@@ -24,8 +24,20 @@
 #include "numberformat.h"
 #include "endiannessbox.h"
 
+/// Maximum number of bytes a bit field channel can span
+const unsigned MAX_BIT_FIELD_BYTES = 8;
+/// Maximum number of samples per channel in a single frame
+const unsigned MAX_SAMPLES_PER_FRAME = 65535;
+
 /**
  * Describes the mapping of a single channel in the frame.
+ *
+ * A channel with non-zero `bitWidth` is a bit field. Its number format
+ * is the word containing the field (e.g. `uint16` for 12-in-16), which
+ * is read as an unsigned integer in channel's endianness; `bitOffset`
+ * counts from the least significant bit of this word. Word grows to
+ * cover fields that don't fit in it. Signed integer formats are sign
+ * extended from `bitWidth` bits.
  */
 struct ChannelMapping
 {
@@ -34,12 +46,40 @@ struct ChannelMapping
     NumberFormat numberFormat; ///< Data format (uint8, int24, etc.)
     Endianness endianness;    ///< Byte order for this channel
     bool enabled;             ///< Whether this channel is active
+    unsigned bitOffset;       ///< first bit of a bit field
+    unsigned bitWidth;        ///< size of a bit field, 0 for whole bytes
+    unsigned stride;          ///< bytes between samples of a burst frame, 0 for `byteLength`
+
+    ChannelMapping() : byteOffset(0), byteLength(1), numberFormat(NumberFormat_uint8), endianness(LittleEndian), enabled(true), bitOffset(0), bitWidth(0), stride(0) {}
+
+    bool isBitField() const {return bitWidth > 0;}
+
+    /// Byte distance between consecutive samples of channel in a frame
+    unsigned sampleStride() const {return stride ? stride : byteLength;}
 
-    ChannelMapping() : byteOffset(0), byteLength(1), numberFormat(NumberFormat_uint8), endianness(LittleEndian), enabled(true) {}
+    /// Number of bytes covered by the channel according to its format and bits
+    unsigned dataLength() const
+    {
+        unsigned formatSize = numberFormatByteSize(numberFormat);
+        if (!isBitField()) return formatSize;
+
+        unsigned bitsSize = (bitOffset + bitWidth + 7) / 8;
+        return bitsSize > formatSize ? bitsSize : formatSize;
+    }
+
+    /// Signed integer formats are sign extended
+    bool isSigned() const
+    {
+        return numberFormat == NumberFormat_int8 || numberFormat == NumberFormat_int16 ||
+            numberFormat == NumberFormat_int24 || numberFormat == NumberFormat_int32;
+    }
 };
 
 /**
  * Container for all channel mappings.
+ *
+ * A burst frame carries `repeat()` samples of each channel; sample `k`
+ * of a channel is at `byteOffset + k * sampleStride()`.
  */
 class ChannelMappingConfig
 {
@@ -48,15 +88,32 @@ public:
     
     void setNumChannels(unsigned num);
     unsigned numChannels() const;
+
+    /// Number of samples per channel in a frame
+    unsigned repeat() const;
+    void setRepeat(unsigned repeat);
     
     ChannelMapping& channel(unsigned index);
     const ChannelMapping& channel(unsigned index) const;
     
-    /// Returns true if all mappings are valid (no overlaps, contiguous, etc.)
+    /// Returns true if all mappings are valid (no overlapping bits, fits in payload, etc.)
     bool isValid(unsigned payloadSize, QString& errorMsg) const;
     
 private:
     std::vector<ChannelMapping> _channels;
+    unsigned _repeat;
+};
+
+/**
+ * Channel layout of a message type. Frames are dispatched to a layout
+ * by their message ID.
+ */
+struct MessageLayout
+{
+    unsigned id;                  ///< value of the message ID field
+    ChannelMappingConfig mapping; ///< channels of this message
+
+    MessageLayout() : id(0) {}
 };
 
 #endif // CHANNELMAPPING_H
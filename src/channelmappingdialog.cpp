@@ -61,6 +61,7 @@ void ChannelMappingDialog::loadFromConfig()
 
 void ChannelMappingDialog::updateTable()
 {
+    ui->spRepeat->setValue(_config.repeat());
     ui->tableWidget->setRowCount(_config.numChannels());
     
     for (unsigned i = 0; i < _config.numChannels(); i++)
@@ -111,10 +112,40 @@ void ChannelMappingDialog::updateTable()
         endiCombo->setCurrentIndex(ch.endianness == LittleEndian ? 0 : 1);
         ui->tableWidget->setCellWidget(i, 4, endiCombo);
 
+        // Bit field, counted from least significant bit of the covered bytes
+        auto bitOffsetSpin = new QSpinBox();
+        bitOffsetSpin->setMinimum(0);
+        bitOffsetSpin->setMaximum(MAX_BIT_FIELD_BYTES * 8 - 1);
+        bitOffsetSpin->setValue(ch.bitOffset);
+        bitOffsetSpin->setEnabled(ch.isBitField());
+        bitOffsetSpin->setToolTip(tr("First bit of the field in the word of selected format, 0 is the least significant bit"));
+        connect(bitOffsetSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+                [this, i]() { this->updateDataLengthForRow(i); });
+        ui->tableWidget->setCellWidget(i, 5, bitOffsetSpin);
+
+        auto bitWidthSpin = new QSpinBox();
+        bitWidthSpin->setMinimum(0);
+        bitWidthSpin->setMaximum(32);
+        bitWidthSpin->setValue(ch.bitWidth);
+        bitWidthSpin->setSpecialValueText(tr("All"));
+        bitWidthSpin->setToolTip(tr("Number of bits of the field, signed formats are sign extended"));
+        connect(bitWidthSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+                [this, i]() { this->updateDataLengthForRow(i); });
+        ui->tableWidget->setCellWidget(i, 6, bitWidthSpin);
+
+        // Stride between samples of burst frames
+        auto strideSpin = new QSpinBox();
+        strideSpin->setMinimum(0);
+        strideSpin->setMaximum(_totalFrameSize);
+        strideSpin->setValue(ch.stride);
+        strideSpin->setSpecialValueText(tr("Packed"));
+        strideSpin->setToolTip(tr("Bytes from a sample of the channel to the next one in the same frame"));
+        ui->tableWidget->setCellWidget(i, 7, strideSpin);
+
         // Enabled
         auto enabledCheckBox = new QTableWidgetItem();
         enabledCheckBox->setCheckState(ch.enabled ? Qt::Checked : Qt::Unchecked);
-        ui->tableWidget->setItem(i, 5, enabledCheckBox);
+        ui->tableWidget->setItem(i, 8, enabledCheckBox);
     }
 }
 
@@ -166,15 +197,23 @@ void ChannelMappingDialog::updateDataLengthForRow(int row)
 {
     auto formatCombo = qobject_cast<QComboBox*>(ui->tableWidget->cellWidget(row, 3));
     auto lengthSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(row, 2));
+    auto bitOffsetSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(row, 5));
+    auto bitWidthSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(row, 6));
     
-    if (formatCombo && lengthSpin) {
-        NumberFormat format = (NumberFormat)formatCombo->currentData().toInt();
-        lengthSpin->setValue(numberFormatByteSize(format));
+    if (formatCombo && lengthSpin && bitOffsetSpin && bitWidthSpin) {
+        ChannelMapping ch;
+        ch.numberFormat = (NumberFormat)formatCombo->currentData().toInt();
+        ch.bitOffset = bitOffsetSpin->value();
+        ch.bitWidth = bitWidthSpin->value();
+        bitOffsetSpin->setEnabled(ch.isBitField());
+        lengthSpin->setValue(ch.dataLength());
     }
 }
 
 void ChannelMappingDialog::saveToConfig()
 {
+    _config.setRepeat(ui->spRepeat->value());
+
     for (unsigned i = 0; i < _config.numChannels(); i++)
     {
         ChannelMapping& ch = _config.channel(i);
@@ -183,15 +222,21 @@ void ChannelMappingDialog::saveToConfig()
         auto lengthSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(i, 2));
         auto formatCombo = qobject_cast<QComboBox*>(ui->tableWidget->cellWidget(i, 3));
         auto endiCombo = qobject_cast<QComboBox*>(ui->tableWidget->cellWidget(i, 4));
-        auto enabledItem = ui->tableWidget->item(i, 5);
+        auto bitOffsetSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(i, 5));
+        auto bitWidthSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(i, 6));
+        auto strideSpin = qobject_cast<QSpinBox*>(ui->tableWidget->cellWidget(i, 7));
+        auto enabledItem = ui->tableWidget->item(i, 8);
 
         if (offsetSpin) ch.byteOffset = offsetSpin->value() - 1; // Convert 1-based input to 0-based storage
         if (lengthSpin) ch.byteLength = lengthSpin->value();
+        if (bitWidthSpin) ch.bitWidth = bitWidthSpin->value();
+        if (bitOffsetSpin) ch.bitOffset = ch.isBitField() ? bitOffsetSpin->value() : 0;
         if (formatCombo) {
             ch.numberFormat = (NumberFormat)formatCombo->currentData().toInt();
-            ch.byteLength = numberFormatByteSize(ch.numberFormat); // Ensure consistency
+            ch.byteLength = ch.dataLength(); // Ensure consistency
         }
         if (endiCombo) ch.endianness = (Endianness)endiCombo->currentData().toInt();
+        if (strideSpin) ch.stride = strideSpin->value();
         if (enabledItem) ch.enabled = (enabledItem->checkState() == Qt::Checked);
     }
 }
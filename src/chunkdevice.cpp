@@ -0,0 +1,76 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+
+#include "chunkdevice.h"
+
+ChunkDevice::ChunkDevice(QObject* parent) :
+    QIODevice(parent)
+{
+    readPos = 0;
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+bool ChunkDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 ChunkDevice::bytesAvailable() const
+{
+    return buffer.size() - readPos + QIODevice::bytesAvailable();
+}
+
+void ChunkDevice::append(const QByteArray& data)
+{
+    if (data.isEmpty()) return;
+
+    // drop consumed data before growing
+    if (readPos > 0)
+    {
+        buffer.remove(0, readPos);
+        readPos = 0;
+    }
+    buffer.append(data);
+
+    emit readyRead();
+}
+
+void ChunkDevice::clear()
+{
+    buffer.clear();
+    readPos = 0;
+}
+
+qint64 ChunkDevice::readData(char* data, qint64 maxSize)
+{
+    qint64 n = qMin(maxSize, qint64(buffer.size() - readPos));
+    memcpy(data, buffer.constData() + readPos, n);
+    readPos += n;
+    return n;
+}
+
+qint64 ChunkDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
@@ -0,0 +1,59 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef CHUNKDEVICE_H
+#define CHUNKDEVICE_H
+
+#include <QIODevice>
+#include <QByteArray>
+
+/**
+ * A read only sequential device that is fed with chunks of data.
+ *
+ * Used to run a reader on data that is received elsewhere (another
+ * thread for example). `readyRead` is emitted synchronously from
+ * `append`, so a connected reader consumes the data before `append`
+ * returns.
+ */
+class ChunkDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit ChunkDevice(QObject* parent = 0);
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+
+    /// Appends data to the device and notifies readers
+    void append(const QByteArray& data);
+    /// Discards all unread data
+    void clear();
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QByteArray buffer;
+    qsizetype readPos;  ///< start of unread data in `buffer`
+};
+
+#endif // CHUNKDEVICE_H
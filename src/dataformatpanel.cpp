@@ -21,6 +21,7 @@
 #include "ui_dataformatpanel.h"
 
 #include <QRadioButton>
+#include <QCheckBox>
 #include <QtDebug>
 
 #include "setting_defines.h"
@@ -42,6 +43,10 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     currentReader = &framedReader;
     framedReader.enable();
     ui->horizontalLayout->addWidget(framedReader.settingsWidget(), 1);
+
+    // demo reader doesn't generate X values
+    connect(ui->cbFirstChannelAsX, &QCheckBox::toggled,
+            &framedReader, &AbstractReader::setFirstChannelAsX);
 }
 
 DataFormatPanel::~DataFormatPanel()
@@ -109,6 +114,12 @@ void DataFormatPanel::selectReader(AbstractReader* reader)
     emit sourceChanged(currentReader);
 }
 
+void DataFormatPanel::setDevice(QIODevice* device)
+{
+    // demo reader doesn't read from device
+    framedReader.setDevice(device);
+}
+
 uint64_t DataFormatPanel::bytesRead()
 {
     _bytesRead += currentReader->getBytesRead();
@@ -121,6 +132,7 @@ void DataFormatPanel::saveSettings(QSettings* settings)
 
     // save selected data format (always custom frame now)
     settings->setValue(SG_DataFormat_Format, "custom");
+    settings->setValue(SG_DataFormat_FirstChannelAsX, ui->cbFirstChannelAsX->isChecked());
 
     settings->endGroup();
 
@@ -135,6 +147,10 @@ void DataFormatPanel::loadSettings(QSettings* settings)
     // Always use custom frame format
     selectReader(&framedReader);
 
+    ui->cbFirstChannelAsX->setChecked(
+        settings->value(SG_DataFormat_FirstChannelAsX,
+                        ui->cbFirstChannelAsX->isChecked()).toBool());
+
     settings->endGroup();
 
     // load reader settings
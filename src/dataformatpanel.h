@@ -53,6 +53,11 @@ public:
     void saveSettings(QSettings* settings);
     /// Loads data format panel settings from a `QSettings`.
     void loadSettings(QSettings* settings);
+    /**
+     * Changes the device that readers read from, for ex. to replay a
+     * capture instead of reading the serial port.
+     */
+    void setDevice(QIODevice* device);
 
 public slots:
     void pause(bool);
@@ -18,6 +18,8 @@
 */
 
 #include "datarecorder.h"
+#include "metrics.h"
+#include "tracer.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -83,18 +85,22 @@ bool DataRecorder::startRecording(QString fileName, QString separator,
 
 void DataRecorder::feedIn(const SamplePack& data)
 {
+    static MetricHistogram& recordTime = Metrics::instance().histogram("record.csv_time");
+    MetricTimer timer(recordTime);
+    TRACE_SCOPE("DataRecorder::feedIn");
+
     Q_ASSERT(file.isOpen());    // recorder should be disconnected before stopping recording
-    Q_ASSERT(!data.hasX());     // NYI
 
     // check if number of channels has changed during recording and warn
     unsigned numChannels = data.numChannels();
-    if (lastNumChannels != 0 && numChannels != lastNumChannels)
+    unsigned numColumns = numChannels + (data.hasX() ? 1 : 0);
+    if (lastNumChannels != 0 && numColumns != lastNumChannels)
     {
         qWarning() << "Number of channels changed from " << lastNumChannels
-                   << " to " << numChannels <<
+                   << " to " << numColumns <<
             " during recording, CSV file is corrupted but no data will be lost.";
     }
-    lastNumChannels = numChannels;
+    lastNumChannels = numColumns;
 
     // write data
     unsigned numSamples = data.numSamples();
@@ -104,6 +110,10 @@ void DataRecorder::feedIn(const SamplePack& data)
         {
             fileStream << formatTimestamp() << _sep;
         }
+        if (data.hasX())
+        {
+            fileStream << data.xData()[i] << _sep;
+        }
         for (unsigned ci = 0; ci < numChannels; ci++)
         {
             fileStream << data.data(ci)[i];
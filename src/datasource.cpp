@@ -0,0 +1,330 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QFileInfo>
+#include <QHostAddress>
+#include <QtDebug>
+
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "datasource.h"
+
+/// Maximum number of bytes read from a pipe at once
+#define READ_CHUNK_SIZE (256*1024)
+/// Socket receive buffer size requested from OS
+#define SOCKET_BUFFER_SIZE (4*1024*1024)
+
+DataSource::DataSource(QObject* parent) :
+    QObject(parent)
+{
+    _type = TcpClient;
+    _isOpen = false;
+    _bytesReceived = 0;
+    _packetsReceived = 0;
+    tcpSocket = nullptr;
+    udpSocket = nullptr;
+    localSocket = nullptr;
+    pipeFd = -1;
+    pipeNotifier = nullptr;
+}
+
+DataSource::~DataSource()
+{
+    close();
+}
+
+QIODevice* DataSource::device()
+{
+    return &_device;
+}
+
+bool DataSource::isOpen() const
+{
+    return _isOpen;
+}
+
+QStringList DataSource::typeNames()
+{
+    return {tr("TCP Client"), tr("UDP"), tr("Local Socket"), tr("Pipe")};
+}
+
+bool DataSource::parseAddress(QString address, QString* host, quint16* port)
+{
+    int sep = address.lastIndexOf(':');
+    *host = sep < 0 ? QString() : address.left(sep);
+
+    bool ok;
+    unsigned p = address.mid(sep + 1).toUInt(&ok);
+    *port = p;
+    return ok && p > 0 && p <= 65535;
+}
+
+void DataSource::open(Type type, QString address)
+{
+    close();
+
+    _type = type;
+    _address = address;
+    _bytesReceived = 0;
+    _packetsReceived = 0;
+    _device.clear();
+
+    QString host;
+    quint16 port;
+
+    switch (type)
+    {
+        case TcpClient:
+            if (!parseAddress(address, &host, &port) || host.isEmpty())
+            {
+                fail(tr("Invalid address, expected host:port"));
+                return;
+            }
+            tcpSocket = new QTcpSocket(this);
+            tcpSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                                       SOCKET_BUFFER_SIZE);
+            connect(tcpSocket, &QTcpSocket::connected, [this]()
+                    {
+                        _isOpen = true;
+                        emit opened(true, QString());
+                    });
+            connect(tcpSocket, &QTcpSocket::readyRead, this, &DataSource::readStream);
+            connect(tcpSocket, &QTcpSocket::errorOccurred, [this]()
+                    {
+                        fail(tcpSocket->errorString());
+                    });
+            tcpSocket->connectToHost(host, port, QIODevice::ReadOnly);
+            break;
+
+        case Udp:
+        {
+            if (!parseAddress(address, &host, &port))
+            {
+                fail(tr("Invalid address, expected port or address:port"));
+                return;
+            }
+            udpSocket = new QUdpSocket(this);
+            QHostAddress bindAddress = host.isEmpty() ?
+                QHostAddress(QHostAddress::Any) : QHostAddress(host);
+            if (!udpSocket->bind(bindAddress, port))
+            {
+                fail(udpSocket->errorString());
+                return;
+            }
+            udpSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                                       SOCKET_BUFFER_SIZE);
+            connect(udpSocket, &QUdpSocket::readyRead, this, &DataSource::readDatagrams);
+            _isOpen = true;
+            emit opened(true, QString());
+            break;
+        }
+
+        case LocalSocket:
+            localSocket = new QLocalSocket(this);
+            connect(localSocket, &QLocalSocket::connected, [this]()
+                    {
+                        _isOpen = true;
+                        emit opened(true, QString());
+                    });
+            connect(localSocket, &QLocalSocket::readyRead, this, &DataSource::readStream);
+            connect(localSocket, &QLocalSocket::errorOccurred, [this]()
+                    {
+                        fail(localSocket->errorString());
+                    });
+            localSocket->connectToServer(address, QIODevice::ReadOnly);
+            break;
+
+        case Pipe:
+            if (openPipe())
+            {
+                _isOpen = true;
+                emit opened(true, QString());
+            }
+            break;
+    }
+}
+
+bool DataSource::openPipe()
+{
+#ifdef Q_OS_UNIX
+    // non blocking so that opening doesn't wait for a writer
+    pipeFd = ::open(_address.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK);
+    if (pipeFd < 0)
+    {
+        fail(QString::fromLocal8Bit(strerror(errno)));
+        return false;
+    }
+    pipeNotifier = new QSocketNotifier(pipeFd, QSocketNotifier::Read, this);
+    connect(pipeNotifier, &QSocketNotifier::activated, this, &DataSource::readPipe);
+    return true;
+#else
+    // named pipes are served by local socket on windows
+    fail(tr("Use Local Socket type for named pipes on this platform"));
+    return false;
+#endif
+}
+
+void DataSource::close()
+{
+    bool wasOpen = _isOpen;
+    _isOpen = false;
+
+    // sockets are deleted later, we may be called from their signals
+    if (tcpSocket != nullptr)
+    {
+        tcpSocket->disconnect(this);
+        tcpSocket->abort();
+        tcpSocket->deleteLater();
+        tcpSocket = nullptr;
+    }
+    if (udpSocket != nullptr)
+    {
+        udpSocket->disconnect(this);
+        udpSocket->close();
+        udpSocket->deleteLater();
+        udpSocket = nullptr;
+    }
+    if (localSocket != nullptr)
+    {
+        localSocket->disconnect(this);
+        localSocket->abort();
+        localSocket->deleteLater();
+        localSocket = nullptr;
+    }
+    if (pipeNotifier != nullptr)
+    {
+        pipeNotifier->setEnabled(false);
+        pipeNotifier->deleteLater();
+        pipeNotifier = nullptr;
+    }
+#ifdef Q_OS_UNIX
+    if (pipeFd >= 0)
+    {
+        ::close(pipeFd);
+        pipeFd = -1;
+    }
+#endif
+
+    if (wasOpen) emit closed();
+}
+
+void DataSource::fail(QString error)
+{
+    bool wasOpen = _isOpen;
+    qWarning() << "Data source" << _address << "error:" << error;
+    close();
+    if (!wasOpen) emit opened(false, error);
+}
+
+void DataSource::received(const QByteArray& data, unsigned packets)
+{
+    _bytesReceived += data.size();
+    _packetsReceived += packets;
+    _device.append(data);
+}
+
+void DataSource::readStream()
+{
+    QIODevice* socket = tcpSocket != nullptr ?
+        static_cast<QIODevice*>(tcpSocket) : static_cast<QIODevice*>(localSocket);
+    Q_ASSERT(socket != nullptr);
+
+    // everything buffered by the socket is read in one chunk
+    QByteArray data = socket->readAll();
+    if (!data.isEmpty()) received(data, 1);
+}
+
+void DataSource::readDatagrams()
+{
+    QByteArray data;
+    unsigned packets = 0;
+    while (udpSocket->hasPendingDatagrams())
+    {
+        qint64 size = udpSocket->pendingDatagramSize();
+        qsizetype offset = data.size();
+        data.resize(offset + qMax(size, qint64(0)));
+        qint64 r = udpSocket->readDatagram(data.data() + offset, size);
+        data.resize(offset + qMax(r, qint64(0)));
+        packets++;
+    }
+    if (!data.isEmpty()) received(data, packets);
+}
+
+void DataSource::readPipe()
+{
+#ifdef Q_OS_UNIX
+    QByteArray data;
+    unsigned packets = 0;
+    bool eof = false;
+    forever
+    {
+        qsizetype offset = data.size();
+        data.resize(offset + READ_CHUNK_SIZE);
+        ssize_t r = ::read(pipeFd, data.data() + offset, READ_CHUNK_SIZE);
+        data.resize(offset + qMax(r, ssize_t(0)));
+
+        if (r > 0)
+        {
+            packets++;
+            // don't starve event loop with a fast writer
+            if (data.size() >= 16 * READ_CHUNK_SIZE) break;
+        }
+        else
+        {
+            eof = (r == 0);
+            if (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                fail(QString::fromLocal8Bit(strerror(errno)));
+                return;
+            }
+            break;
+        }
+    }
+
+    if (!data.isEmpty()) received(data, packets);
+
+    if (eof && QFileInfo(_address).isFile())
+    {
+        // regular file is read until the end
+        close();
+    }
+    else if (eof)
+    {
+        // writer has closed, re-open to wait for the next writer
+        // instead of busy looping on EOF
+        pipeNotifier->setEnabled(false);
+        pipeNotifier->deleteLater();
+        ::close(pipeFd);
+        pipeFd = ::open(_address.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK);
+        if (pipeFd < 0)
+        {
+            pipeNotifier = nullptr;
+            fail(QString::fromLocal8Bit(strerror(errno)));
+            return;
+        }
+        pipeNotifier = new QSocketNotifier(pipeFd, QSocketNotifier::Read, this);
+        connect(pipeNotifier, &QSocketNotifier::activated, this, &DataSource::readPipe);
+    }
+#endif
+}
@@ -0,0 +1,117 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATASOURCE_H
+#define DATASOURCE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <QLocalSocket>
+#include <QSocketNotifier>
+
+#include "chunkdevice.h"
+
+/**
+ * A non-serial data source: TCP client, UDP listener, local socket
+ * (unix domain socket or windows named pipe), a named pipe (FIFO) or
+ * a regular file.
+ *
+ * Received data is read in large chunks and fed to `device()`, which
+ * readers can read from just like a serial port.
+ */
+class DataSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Type
+    {
+        TcpClient,   ///< address is "host:port"
+        Udp,         ///< address is "port" or "bind address:port"
+        LocalSocket, ///< address is socket name or path
+        Pipe         ///< address is path of a FIFO or a regular file
+    };
+
+    explicit DataSource(QObject* parent = 0);
+    ~DataSource();
+
+    /// Returns the device that received data is fed to
+    QIODevice* device();
+
+    /// Returns true if source is open
+    bool isOpen() const;
+    Type type() const {return _type;}
+    QString address() const {return _address;}
+
+    /// Total number of bytes received since opening
+    quint64 bytesReceived() const {return _bytesReceived;}
+    /**
+     * Total number of packets received since opening. A packet is a
+     * datagram for UDP and a read chunk for other types.
+     */
+    quint64 packetsReceived() const {return _packetsReceived;}
+
+    /// Returns display names of types, in `Type` order
+    static QStringList typeNames();
+
+public slots:
+    /**
+     * Opens the source. Result is reported with `opened` signal,
+     * possibly later (when connection is established).
+     */
+    void open(Type type, QString address);
+    /// Closes the source
+    void close();
+
+signals:
+    /// Emitted after an `open` request, `error` is empty on success
+    void opened(bool success, QString error);
+    /// Emitted when source is closed, by request or because of an error
+    void closed();
+
+private:
+    Type _type;
+    QString _address;
+    bool _isOpen;
+    quint64 _bytesReceived;
+    quint64 _packetsReceived;
+
+    ChunkDevice _device;
+    QTcpSocket* tcpSocket;
+    QUdpSocket* udpSocket;
+    QLocalSocket* localSocket;
+    int pipeFd;
+    QSocketNotifier* pipeNotifier;
+
+    /// Splits "host:port", returns false if port is invalid
+    static bool parseAddress(QString address, QString* host, quint16* port);
+    void received(const QByteArray& data, unsigned packets);
+    void fail(QString error);
+    bool openPipe();
+
+private slots:
+    void readStream();
+    void readDatagrams();
+    void readPipe();
+};
+
+#endif // DATASOURCE_H
@@ -58,7 +58,7 @@ void DemoReader::enable(bool enabled)
     AbstractReader::enable(enabled);
 }
 
-unsigned DemoReader::numChannels() const
+unsigned DemoReader::numReadChannels() const
 {
     return _numChannels;
 }
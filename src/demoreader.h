@@ -42,7 +42,7 @@ public:
     explicit DemoReader(QIODevice* device, QObject* parent = 0);
 
     QWidget* settingsWidget();
-    unsigned numChannels() const;
+    unsigned numReadChannels() const override;
     void enable(bool enabled = true) override;
 
 public slots:
@@ -0,0 +1,129 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <math.h>
+#include <QtGlobal>
+
+#include "fftplan.h"
+
+FftPlan::FftPlan(unsigned n)
+{
+    Q_ASSERT(isValidSize(n));
+
+    _n = n;
+    unsigned m = n / 2;
+
+    // periodic Hann window
+    window.resize(n);
+    double wsum = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        window[i] = 0.5 - 0.5 * cos(2 * M_PI * i / n);
+        wsum += window[i];
+    }
+    // one sided spectrum, amplitude `A` gives `A/2` at +f and -f
+    scale = 4. / (wsum * wsum);
+
+    unsigned bits = 0;
+    while ((1u << bits) < m) bits++;
+
+    bitrev.resize(m);
+    for (unsigned i = 0; i < m; i++)
+    {
+        unsigned r = 0;
+        for (unsigned b = 0; b < bits; b++)
+        {
+            if (i & (1u << b)) r |= 1u << (bits - 1 - b);
+        }
+        bitrev[i] = r;
+    }
+
+    twiddle.resize(m / 2);
+    for (unsigned k = 0; k < m / 2; k++)
+    {
+        twiddle[k] = std::polar(1., -2 * M_PI * k / m);
+    }
+
+    split.resize(m + 1);
+    for (unsigned k = 0; k <= m; k++)
+    {
+        split[k] = std::polar(1., -2 * M_PI * k / n);
+    }
+
+    work.resize(m);
+}
+
+bool FftPlan::isValidSize(unsigned n)
+{
+    return n >= 4 && (n & (n - 1)) == 0;
+}
+
+unsigned FftPlan::size() const
+{
+    return _n;
+}
+
+unsigned FftPlan::numBins() const
+{
+    return _n / 2 + 1;
+}
+
+void FftPlan::power(const double* in, double* out)
+{
+    unsigned m = _n / 2;
+
+    // pack even/odd samples as real/imaginary parts, in bit reversed order
+    for (unsigned i = 0; i < m; i++)
+    {
+        work[bitrev[i]] = Complex(in[2*i] * window[2*i], in[2*i+1] * window[2*i+1]);
+    }
+
+    // iterative radix-2 complex FFT
+    for (unsigned len = 2; len <= m; len <<= 1)
+    {
+        unsigned half = len / 2;
+        unsigned step = m / len;
+        for (unsigned i = 0; i < m; i += len)
+        {
+            for (unsigned j = 0; j < half; j++)
+            {
+                Complex u = work[i + j];
+                Complex v = work[i + j + half] * twiddle[j * step];
+                work[i + j] = u + v;
+                work[i + j + half] = u - v;
+            }
+        }
+    }
+
+    // split into spectrum of real input
+    for (unsigned k = 0; k <= m; k++)
+    {
+        Complex zk = work[k % m];
+        Complex zc = std::conj(work[(m - k) % m]);
+        Complex even = (zk + zc) * 0.5;
+        Complex odd = (zk - zc) * Complex(0, -0.5);
+        Complex x = even + split[k] * odd;
+        out[k] = std::norm(x) * scale;
+    }
+
+    // DC and Nyquist bins aren't mirrored
+    out[0] /= 4;
+    out[m] /= 4;
+}
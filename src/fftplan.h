@@ -0,0 +1,70 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef FFTPLAN_H
+#define FFTPLAN_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * Precomputed plan for real input FFT of a power of 2 size.
+ *
+ * Window function, bit reversal table and twiddle factors are
+ * calculated once at construction. Real input of `n` samples is
+ * transformed with a `n/2` point complex FFT followed by a split step.
+ */
+class FftPlan
+{
+public:
+    /// @param n transform size, must be a power of 2 and at least 4
+    explicit FftPlan(unsigned n);
+
+    /// Transform size
+    unsigned size() const;
+    /// Number of output bins, `size()/2+1`
+    unsigned numBins() const;
+
+    /**
+     * Calculates power spectrum of given data after applying a Hann
+     * window. Output is normalized so that a sine wave of amplitude `A`
+     * reads `A^2` at its bin.
+     *
+     * @param in `size()` samples
+     * @param out `numBins()` values
+     */
+    void power(const double* in, double* out);
+
+    /// Returns true if `n` is a valid transform size
+    static bool isValidSize(unsigned n);
+
+private:
+    typedef std::complex<double> Complex;
+
+    unsigned _n;
+    double scale;                 ///< power normalization factor
+    std::vector<double> window;   ///< Hann window coefficients
+    std::vector<unsigned> bitrev; ///< bit reversal table for `n/2` points
+    std::vector<Complex> twiddle; ///< twiddle factors of `n/2` point FFT
+    std::vector<Complex> split;   ///< twiddle factors of split step
+    std::vector<Complex> work;    ///< FFT work area
+};
+
+#endif // FFTPLAN_H
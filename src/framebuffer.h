@@ -40,6 +40,32 @@ public:
     virtual double sample(unsigned i) const = 0;
     /// Returns minimum and maximum of the buffer values.
     virtual Range limits() const = 0;
+    /**
+     * Returns minimum and maximum of values in index range [start, end).
+     *
+     * Default implementation scans the range, buffers that keep
+     * summaries of their data should re-implement.
+     */
+    virtual Range limits(unsigned start, unsigned end) const
+    {
+        if (start >= end) return {0, 0};
+        Range r = {sample(start), sample(start)};
+        for (unsigned i = start + 1; i < end; i++)
+        {
+            double v = sample(i);
+            if (v < r.start) r.start = v;
+            if (v > r.end) r.end = v;
+        }
+        return r;
+    }
+    /// Returns mean of values in index range [start, end), see `limits(start, end)`
+    virtual double mean(unsigned start, unsigned end) const
+    {
+        if (start >= end) return 0;
+        double sum = 0;
+        for (unsigned i = start; i < end; i++) sum += sample(i);
+        return sum / (end - start);
+    }
 };
 
 /// Common base class for index and writable frame buffers
@@ -79,6 +105,36 @@ public:
      * index is returned (not closer one).
      */
     virtual int findIndex(double value) const = 0;
+
+    /**
+     * Finds index range [start, end) of samples with values in
+     * [xMin, xMax]. Range is empty (start == end) if there are none.
+     */
+    void findRange(double xMin, double xMax, unsigned* start, unsigned* end) const
+    {
+        auto lim = limits();
+        if (size() == 0 || xMax < lim.start || xMin > lim.end)
+        {
+            *start = *end = 0;
+            return;
+        }
+
+        // `findIndex` returns the sample before given value
+        int s = findIndex(xMin);
+        if (s == OUT_OF_RANGE)
+        {
+            *start = 0;
+        }
+        else
+        {
+            *start = sample(s) < xMin ? s + 1 : s;
+        }
+
+        int e = findIndex(xMax);
+        *end = e == OUT_OF_RANGE ? size() : e + 1;
+
+        if (*start > *end) *start = *end;
+    }
 };
 
 #endif // FRAMEBUFFER_H
@@ -18,6 +18,7 @@
 */
 
 #include <math.h>
+#include <algorithm>
 #include "framebufferseries.h"
 
 FrameBufferSeries::FrameBufferSeries(const XFrameBuffer* x, const FrameBuffer* y)
@@ -26,7 +27,7 @@ FrameBufferSeries::FrameBufferSeries(const XFrameBuffer* x, const FrameBuffer* y
     _y = y;
 
     int_index_start = 0;
-    int_index_end = _y->size();
+    int_index_end = _y->size()-1;
 }
 
 void FrameBufferSeries::setX(const XFrameBuffer* x)
@@ -34,6 +35,16 @@ void FrameBufferSeries::setX(const XFrameBuffer* x)
     _x = x;
 }
 
+const XFrameBuffer* FrameBufferSeries::xBuffer() const
+{
+    return _x;
+}
+
+const FrameBuffer* FrameBufferSeries::yBuffer() const
+{
+    return _y;
+}
+
 size_t FrameBufferSeries::size() const
 {
     return int_index_end - int_index_start + 1;
@@ -48,7 +59,21 @@ QPointF FrameBufferSeries::sample(size_t i) const
 QRectF FrameBufferSeries::boundingRect() const
 {
     QRectF rect;
-    auto yLim = _y->limits();
+    // Y limits of only the data in view, so that autoscale fits the
+    // visible window when plot width is smaller than the buffer. Note
+    // that rectangle of interest may be outdated if buffer is resized.
+    unsigned size = _y->size();
+    unsigned start = int_index_start;
+    unsigned end = std::min(unsigned(int_index_end + 1), size);
+    Range yLim;
+    if (start < end && (start > 0 || end < size))
+    {
+        yLim = _y->limits(start, end);
+    }
+    else
+    {
+        yLim = _y->limits();
+    }
     auto xLim = _x->limits();
     rect.setBottom(yLim.start);
     rect.setTop(yLim.end);
@@ -60,6 +85,16 @@ QRectF FrameBufferSeries::boundingRect() const
 
 void FrameBufferSeries::setRectOfInterest(const QRectF& rect)
 {
+    // `findIndex` reports `OUT_OF_RANGE` for both sides of the data,
+    // so check if rectangle misses the data altogether first
+    auto xLim = _x->limits();
+    if (rect.right() < xLim.start || rect.left() > xLim.end)
+    {
+        int_index_start = 0;
+        int_index_end = -1;
+        return;
+    }
+
     int_index_start = _x->findIndex(rect.left());
     int_index_end = _x->findIndex(rect.right());
 
@@ -38,6 +38,10 @@ public:
     FrameBufferSeries(const XFrameBuffer* x, const FrameBuffer* y);
 
     void setX(const XFrameBuffer* x);
+    /// Underlying X buffer
+    const XFrameBuffer* xBuffer() const;
+    /// Underlying Y buffer
+    const FrameBuffer* yBuffer() const;
 
     // QwtSeriesData implementations
     size_t size() const;
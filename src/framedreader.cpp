@@ -19,24 +19,46 @@
 
 #include <QtDebug>
 #include <QtEndian>
-#include <QDateTime>
 #include <cstring>
 
 #include "framedreader.h"
+#include "protocoltrace.h"
+
+/**
+ * Reads `N` bytes as an unsigned integer. With a constant `N` this
+ * compiles to a single (byte swapped) load.
+ */
+template <unsigned N>
+static inline quint64 loadBits(const uint8_t* data, bool isLittleEndian)
+{
+    quint64 v = 0;
+    for (unsigned i = 0; i < N; i++)
+    {
+        unsigned shift = isLittleEndian ? i * 8 : (N - 1 - i) * 8;
+        v |= quint64(data[i]) << shift;
+    }
+    return v;
+}
 
 FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     AbstractReader(device, parent),
     _numChannels(1),
-    hasSizeByte(true),
-    isSizeField2B(false),
+    framing(FramedReaderSettings::Framing::SyncWord),
     frameSize(64),
+    frameLength(0),
     debugModeEnabled(false),
     _settingsValid(false),
-    sync_i(0),
-    gotSync(false),
-    gotSize(false),
-    _frameBuffer(nullptr),
-    _frameBufferSize(0)
+    _frameBufferSize(65535),
+    pendingOffset(0),
+    batchNumRows(0),
+    gotDelimiter(false),
+    hunting(false),
+    huntSkipped(0),
+    mFrames(Metrics::instance().counter("framedreader.frames")),
+    mChecksumFailures(Metrics::instance().counter("framedreader.checksum_failures")),
+    mResyncs(Metrics::instance().counter("framedreader.resyncs")),
+    mBytesDiscarded(Metrics::instance().counter("framedreader.bytes_discarded")),
+    mUnknownMessages(Metrics::instance().counter("framedreader.unknown_messages"))
 {
     paused = false;
 
@@ -46,22 +68,13 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     
     // initial settings
     _numChannels = _settingsWidget.numOfChannels();
-    hasSizeByte = false;  // Size field removed - frame format is now fixed
-    isSizeField2B = false;
+    framing = _settingsWidget.framing();
     syncWord = _settingsWidget.syncWord();
+    lengthField = _settingsWidget.lengthField();
+    messageId = _settingsWidget.messageId();
+    layouts = _settingsWidget.messageLayouts();
     debugModeEnabled = _settingsWidget.isDebugModeEnabled();
-    
-    // Calculate frame size: Total Frame Length - sync word - checksum
-    unsigned totalLength = _settingsWidget.totalFrameLength();
-    unsigned frameStartLength = syncWord.size();
-    unsigned checksumLength = _checksumConfig.enabled ? ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
-    int calculatedFrameSize = totalLength - frameStartLength - checksumLength;
-    frameSize = calculatedFrameSize > 0 ? calculatedFrameSize : 1;
-    // Endianness is now per-channel
-
-    // Allocate frame buffer
-    _frameBuffer = new uint8_t[65535];
-    _frameBufferSize = 65535;
+    recalculateFrameSize();
 
     checkSettings();
 
@@ -72,8 +85,17 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &FramedReaderSettings::syncWordChanged,
             this, &FramedReader::onSyncWordChanged);
 
+    connect(&_settingsWidget, &FramedReaderSettings::framingChanged,
+            this, &FramedReader::onFramingChanged);
+
     connect(&_settingsWidget, &FramedReaderSettings::checksumChanged,
-            [this](bool enabled){ _checksumConfig.enabled = enabled; reset(); });
+            [this](bool enabled)
+            {
+                _checksumConfig.enabled = enabled;
+                recalculateFrameSize();
+                checkSettings();
+                reset();
+            });
 
     connect(&_settingsWidget, &FramedReaderSettings::debugModeChanged,
             [this](bool enabled){ debugModeEnabled = enabled; });
@@ -87,6 +109,12 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &FramedReaderSettings::totalFrameLengthChanged,
             this, &FramedReader::onTotalFrameLengthChanged);
 
+    connect(&_settingsWidget, &FramedReaderSettings::lengthFieldChanged,
+            this, &FramedReader::onLengthFieldChanged);
+
+    connect(&_settingsWidget, &FramedReaderSettings::messageIdChanged,
+            this, &FramedReader::onMessageIdChanged);
+
     reset();
 }
 
@@ -95,7 +123,7 @@ QWidget* FramedReader::settingsWidget()
     return &_settingsWidget;
 }
 
-unsigned FramedReader::numChannels() const
+unsigned FramedReader::numReadChannels() const
 {
     return _numChannels;
 }
@@ -107,7 +135,7 @@ void FramedReader::checkSettings()
                  << "frameSize =" << frameSize;
 
     // Validate sync word
-    if (syncWord.isEmpty())
+    if (framing == FramedReaderSettings::Framing::SyncWord && syncWord.isEmpty())
     {
         _settingsValid = false;
         _lastErrorMessage = "Frame Start is invalid!";
@@ -117,10 +145,58 @@ void FramedReader::checkSettings()
         return;
     }
 
+    // Validate length field, it should be after sync word and fit in the frame
+    if (lengthField.enabled)
+    {
+        QString error;
+        if (lengthField.offset < frameStartLength())
+        {
+            error = "Length field overlaps Frame Start!";
+        }
+        else if (lengthField.offset + lengthField.width + checksumSize() > frameLength)
+        {
+            error = "Length field doesn't fit in Total Frame Length!";
+        }
+
+        if (!error.isEmpty())
+        {
+            _settingsValid = false;
+            _lastErrorMessage = error;
+            _settingsWidget.showMessage(_lastErrorMessage, true);
+            return;
+        }
+    }
+
+    // Validate message ID field and layouts
+    if (messageId.enabled && !buildLayoutTable())
+    {
+        _settingsValid = false;
+        _settingsWidget.showMessage(_lastErrorMessage, true);
+        return;
+    }
+
     // Validate channel mappings (use total frame size including sync word)
     QString errorMsg;
-    unsigned totalFrameSize = syncWord.size() + frameSize;
-    if (!_channelMapping.isValid(totalFrameSize, errorMsg))
+    unsigned totalFrameSize = frameLength - checksumSize();
+    bool mappingValid = true;
+    if (messageId.enabled)
+    {
+        for (auto& layout : layouts)
+        {
+            if (!layout.mapping.isValid(totalFrameSize, errorMsg))
+            {
+                errorMsg = QString("Message 0x%1: %2").arg(layout.id, 0, 16).arg(errorMsg);
+                mappingValid = false;
+                break;
+            }
+        }
+    }
+    else
+    {
+        mappingValid = _channelMapping.isValid(totalFrameSize, errorMsg);
+    }
+
+    if (!mappingValid)
     {
         _settingsValid = false;
         _lastErrorMessage = errorMsg;
@@ -139,7 +215,8 @@ void FramedReader::checkSettings()
 void FramedReader::onNumOfChannelsChanged(unsigned value)
 {
     _numChannels = value;
-    _channelMapping.setNumChannels(value);
+    // in message ID mode channels are set by message layouts
+    if (!messageId.enabled) _channelMapping.setNumChannels(value);
     checkSettings();
     reset();
     updateNumChannels();
@@ -155,6 +232,14 @@ void FramedReader::onSyncWordChanged(QByteArray word)
     reset();
 }
 
+void FramedReader::onFramingChanged(FramedReaderSettings::Framing value)
+{
+    framing = value;
+    recalculateFrameSize();
+    checkSettings();
+    reset();
+}
+
 void FramedReader::onChannelMappingChanged()
 {
     _channelMapping = _settingsWidget.channelMapping();
@@ -181,34 +266,116 @@ void FramedReader::onTotalFrameLengthChanged()
     reset();
 }
 
+void FramedReader::onLengthFieldChanged()
+{
+    lengthField = _settingsWidget.lengthField();
+    recalculateFrameSize();
+    checkSettings();
+    reset();
+}
+
+void FramedReader::onMessageIdChanged()
+{
+    messageId = _settingsWidget.messageId();
+    layouts = _settingsWidget.messageLayouts();
+    checkSettings();
+    reset();
+}
+
+bool FramedReader::buildLayoutTable()
+{
+    if (messageId.offset < frameStartLength())
+    {
+        _lastErrorMessage = "Message ID overlaps Frame Start!";
+        return false;
+    }
+    if (messageId.offset + messageId.width + checksumSize() > frameLength)
+    {
+        _lastErrorMessage = "Message ID doesn't fit in Total Frame Length!";
+        return false;
+    }
+    if (layouts.empty())
+    {
+        _lastErrorMessage = "No message layouts!";
+        return false;
+    }
+
+    layoutTable.assign(1 << (8 * messageId.width), -1);
+    layoutFirstChannel.resize(layouts.size());
+
+    unsigned numChannels = 0;
+    for (unsigned i = 0; i < layouts.size(); i++)
+    {
+        unsigned id = layouts[i].id;
+        if (id >= layoutTable.size())
+        {
+            _lastErrorMessage = QString("Message ID 0x%1 doesn't fit in message ID field!").arg(id, 0, 16);
+            return false;
+        }
+        if (layoutTable[id] >= 0)
+        {
+            _lastErrorMessage = QString("Message ID 0x%1 is used more than once!").arg(id, 0, 16);
+            return false;
+        }
+        layoutTable[id] = i;
+        layoutFirstChannel[i] = numChannels;
+        numChannels += layouts[i].mapping.numChannels();
+    }
+
+    // number of channels is updated separately, wait for it
+    if (numChannels != _numChannels)
+    {
+        _lastErrorMessage = "Number of channels doesn't match message layouts!";
+        return false;
+    }
+
+    return true;
+}
+
 void FramedReader::recalculateFrameSize()
 {
     // Calculate frame size: Total Frame Length - sync word - checkCode
     unsigned totalLength = _settingsWidget.totalFrameLength();
-    unsigned frameStartLength = syncWord.size();
-    unsigned checksumLength = _checksumConfig.enabled ? ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
+    unsigned frameStartLength = this->frameStartLength();
+    unsigned checksumLength = checksumSize();
     int calculatedFrameSize = totalLength - frameStartLength - checksumLength;
     frameSize = calculatedFrameSize > 0 ? calculatedFrameSize : 1;
+    frameLength = qMin(frameStartLength + frameSize + checksumLength, _frameBufferSize);
+}
+
+unsigned FramedReader::checksumSize() const
+{
+    return _checksumConfig.enabled ?
+        ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
+}
+
+unsigned FramedReader::frameStartLength() const
+{
+    return framing == FramedReaderSettings::Framing::SyncWord ? syncWord.size() : 0;
 }
 
 void FramedReader::reset()
 {
-    if (debugModeEnabled)
-        qDebug() << "reset() called: resetting sync state";
-    sync_i = 0;
-    gotSync = false;
-    gotSize = false;
-    if (hasSizeByte) frameSize = 0;
+    // partial frame is dropped, keep stream offsets consistent for trace
+    pendingOffset += pending.size();
+    pending.clear();
+    gotDelimiter = false;
+    hunting = false;
+    lastValues.assign(_numChannels, 0.0);
 }
 
-double FramedReader::extractChannelValue(const ChannelMapping& ch, const uint8_t* buffer)
+double FramedReader::extractChannelValue(const ChannelMapping& ch, const uint8_t* frame,
+                                         unsigned dataLength, unsigned sample)
 {
-    // Buffer now contains complete frame (sync word + payload)
-    unsigned totalFrameSize = syncWord.size() + frameSize;
-    if (ch.byteOffset + ch.byteLength > totalFrameSize)
+    // channels beyond the end of a short (variable length) frame read as 0
+    unsigned offset = ch.byteOffset + sample * ch.sampleStride();
+    if (offset + ch.byteLength > dataLength)
         return 0.0;
 
-    const uint8_t* data = buffer + ch.byteOffset;
+    const uint8_t* data = frame + offset;
+    if (ch.isBitField())
+        return extractBitField(ch, data);
+
     double value = 0.0;
 
     switch (ch.numberFormat)
@@ -325,69 +492,146 @@ double FramedReader::extractChannelValue(const ChannelMapping& ch, const uint8_t
     return value;
 }
 
+double FramedReader::extractBitField(const ChannelMapping& ch, const uint8_t* data)
+{
+    const bool le = ch.endianness == LittleEndian;
+
+    // common packings (12-in-16, 3x10-in-32, 2x12-in-24) hit fixed size loads
+    quint64 v;
+    switch (ch.byteLength)
+    {
+        case 1: v = loadBits<1>(data, le); break;
+        case 2: v = loadBits<2>(data, le); break;
+        case 3: v = loadBits<3>(data, le); break;
+        case 4: v = loadBits<4>(data, le); break;
+        case 5: v = loadBits<5>(data, le); break;
+        case 6: v = loadBits<6>(data, le); break;
+        case 7: v = loadBits<7>(data, le); break;
+        case 8: v = loadBits<8>(data, le); break;
+        default: return 0.0;
+    }
+
+    const unsigned unused = 64 - ch.bitWidth;
+    v <<= unused - ch.bitOffset;    // drop bits above the field
+    if (ch.isSigned())
+    {
+        return double(qint64(v) >> unused);
+    }
+    else
+    {
+        return double(v >> unused);
+    }
+}
+
 uint32_t FramedReader::calculateFrameChecksum(const uint8_t* data, unsigned dataLength)
 {
-    if (!_checksumConfig.enabled)
+    if (!_checksumConfig.enabled || dataLength == 0)
         return 0;
 
-    // Build complete frame data (sync word + payload) for checksum calculation
-    QByteArray completeFrame = syncWord;
-    completeFrame.append((const char*)data, dataLength);
-    
-    // Now use 0-based indexing on the complete frame
-    unsigned totalFrameLength = completeFrame.size();
+    // 0-based indexing on the complete frame (sync word + payload)
     unsigned startByte = _checksumConfig.startByte;
     unsigned endByte = _checksumConfig.endByte;
 
-    // Clamp byte range to actual complete frame data
-    if (startByte >= totalFrameLength)
+    // Clamp byte range to actual complete frame data, variable length
+    // frames are always covered up to the checkCode
+    if (startByte >= dataLength)
         startByte = 0;
-    if (endByte >= totalFrameLength)
-        endByte = totalFrameLength - 1;
+    if (lengthField.enabled || endByte >= dataLength)
+        endByte = dataLength - 1;
 
     unsigned length = (endByte >= startByte) ? (endByte - startByte + 1) : 0;
 
     if (length == 0)
         return 0;
 
-    return ChecksumCalculator::calculate(_checksumConfig.algorithm, 
-                                       (const uint8_t*)completeFrame.data() + startByte, 
+    return ChecksumCalculator::calculate(_checksumConfig.algorithm,
+                                       data + startByte,
                                        length);
 }
 
-void FramedReader::readFrameDataAndExtractChannels()
+unsigned FramedReader::findSync(const char* data, unsigned pos, unsigned size) const
 {
-    if (paused)
+    const char* sync = syncWord.constData();
+    const unsigned syncSize = syncWord.size();
+
+    while (pos < size)
     {
-        _device->read(_frameBufferSize);
-        return;
+        const char* p = (const char*) memchr(data + pos, sync[0], size - pos);
+        if (p == nullptr) return size;
+
+        pos = p - data;
+        unsigned n = qMin(syncSize, size - pos);
+        if (memcmp(p, sync, n) == 0) return pos;
+        pos++;
     }
 
-    // Read complete frame data including sync word
-    // First, put sync word at the beginning of buffer
-    std::memcpy(_frameBuffer, syncWord.data(), syncWord.size());
-    
-    // Then read payload data after sync word
-    if (debugModeEnabled)
-        qDebug() << "Reading frame data: frameSize=" << frameSize 
-                 << "totalFrameLength=" << _settingsWidget.totalFrameLength()
-                 << "syncWordSize=" << syncWord.size();
-    _device->read((char*)_frameBuffer + syncWord.size(), frameSize);
+    return size;
+}
 
-    // Verify checksum if enabled
-    if (_checksumConfig.enabled)
+void FramedReader::discard(const char* data, unsigned pos, unsigned end)
+{
+    // only the first missed byte is traced, rest is counted
+    if (!hunting)
     {
-        // Read checksum from device
-        unsigned checksumSize = ChecksumCalculator::getOutputSize(_checksumConfig.algorithm);
-        uint8_t receivedChecksum[4] = {0};
-        _device->read((char*)receivedChecksum, checksumSize);
+        if (debugModeEnabled)
+        {
+            // length of the partially matched sync word and the missed byte
+            unsigned matched = 0;
+            while (framing == FramedReaderSettings::Framing::SyncWord &&
+                   matched < (unsigned) syncWord.size() - 1 &&
+                   pos + matched + 1 < end &&
+                   data[pos + matched] == syncWord[matched])
+            {
+                matched++;
+            }
+            ProtocolTrace::instance().record(
+                ProtocolTrace::SyncLost, pendingOffset + pos + matched, matched,
+                (const uint8_t*) data + pos + matched, 1);
+        }
+        huntSkipped = 0;
+        hunting = true;
+    }
+
+    mBytesDiscarded.add(end - pos);
+    huntSkipped += end - pos;
+}
+
+quint32 FramedReader::readField(const uint8_t* field, unsigned width, bool isLittleEndian)
+{
+    quint32 value = 0;
+    for (unsigned i = 0; i < width; i++)
+    {
+        unsigned shift = isLittleEndian ? i * 8 : (width - 1 - i) * 8;
+        value |= quint32(field[i]) << shift;
+    }
+    return value;
+}
 
-        // Calculate expected checksum (only for payload data, skip sync word)
-        uint32_t expectedChecksum = calculateFrameChecksum(_frameBuffer + syncWord.size(), frameSize);
+int FramedReader::findLayout(const uint8_t* frame, unsigned dataLength) const
+{
+    // a short (variable length) frame may end before the message ID
+    if (messageId.offset + messageId.width > dataLength) return -1;
+
+    quint32 id = readField(frame + messageId.offset, messageId.width, messageId.isLittleEndian);
+    return layoutTable[id];
+}
+
+void FramedReader::processFrame(const uint8_t* frame, unsigned length, quint64 offset)
+{
+    if (paused) return;
+
+    const unsigned csSize = checksumSize();
+    const unsigned dataLength = length - csSize;
+
+    // Verify checksum if enabled, it is placed right after frame data
+    if (_checksumConfig.enabled)
+    {
+        const uint8_t* receivedChecksum = frame + dataLength;
+        uint32_t expectedChecksum = calculateFrameChecksum(frame, dataLength);
 
         // Compare (handle different sizes and endianness)
         bool checksumOk = true;
-        for (unsigned i = 0; i < checksumSize; i++)
+        for (unsigned i = 0; i < csSize; i++)
         {
             uint8_t expected;
             if (_checksumConfig.isLittleEndian)
@@ -398,9 +642,9 @@ void FramedReader::readFrameDataAndExtractChannels()
             else
             {
                 // Big endian: MSB first
-                expected = (expectedChecksum >> ((checksumSize - 1 - i) * 8)) & 0xFF;
+                expected = (expectedChecksum >> ((csSize - 1 - i) * 8)) & 0xFF;
             }
-            
+
             if (receivedChecksum[i] != expected)
             {
                 checksumOk = false;
@@ -410,179 +654,350 @@ void FramedReader::readFrameDataAndExtractChannels()
 
         if (!checksumOk)
         {
-            // Format timestamp as YYYY:MM:DD HH:MM:SS
-            QString timestamp = QDateTime::currentDateTime().toString("yyyy:MM:dd HH:mm:ss");
-            
-            // Format received checksum value
-            QString receivedStr;
-            for (unsigned i = 0; i < checksumSize; i++)
-            {
-                if (i > 0) receivedStr += " ";
-                receivedStr += QString("0x%1").arg(receivedChecksum[i], 2, 16, QChar('0')).toUpper();
-            }
-            
-            // Format calculated checksum value (respecting configured endianness)
-            QString calculatedStr;
-            for (unsigned i = 0; i < checksumSize; i++)
+            if (debugModeEnabled)
             {
-                if (i > 0) calculatedStr += " ";
-                uint8_t calculatedByte;
-                if (_checksumConfig.isLittleEndian)
-                {
-                    // Little endian: LSB first
-                    calculatedByte = (expectedChecksum >> (i * 8)) & 0xFF;
-                }
-                else
+                // received checksum in configured byte order for comparison
+                uint32_t received = 0;
+                for (unsigned i = 0; i < csSize; i++)
                 {
-                    // Big endian: MSB first
-                    calculatedByte = (expectedChecksum >> ((checksumSize - 1 - i) * 8)) & 0xFF;
+                    unsigned shift = _checksumConfig.isLittleEndian ?
+                        i * 8 : (csSize - 1 - i) * 8;
+                    received |= uint32_t(receivedChecksum[i]) << shift;
                 }
-                calculatedStr += QString("0x%1").arg(calculatedByte, 2, 16, QChar('0')).toUpper();
+                uint32_t mask = csSize < 4 ? (1u << (csSize * 8)) - 1 : 0xFFFFFFFF;
+                ProtocolTrace::instance().record(
+                    ProtocolTrace::ChecksumFailure, offset, csSize,
+                    frame, dataLength,
+                    expectedChecksum & mask, received);
             }
-            
-            if (debugModeEnabled)
+            mChecksumFailures.add();
+            return;
+        }
+    }
+
+    // Extract channels, a burst frame gives multiple samples of each channel
+    if (messageId.enabled)
+    {
+        int li = findLayout(frame, dataLength);
+        if (li < 0)
+        {
+            mUnknownMessages.add();
+            return;
+        }
+
+        // channels of other messages hold their last values
+        const ChannelMappingConfig& mapping = layouts[li].mapping;
+        double* values = lastValues.data() + layoutFirstChannel[li];
+        for (unsigned r = 0; r < mapping.repeat(); r++)
+        {
+            for (unsigned i = 0; i < mapping.numChannels(); i++)
             {
-                qCritical() << timestamp << "CheckCode failed! Received:" << receivedStr 
-                           << "Calculated:" << calculatedStr;
-                
-                // Provide additional diagnostic information
-                QString endianStr = _checksumConfig.isLittleEndian ? "Little Endian" : "Big Endian";
-                qCritical() << "Frame size:" << frameSize << "bytes, CheckCode algorithm:" 
-                           << ChecksumCalculator::algorithmToString(_checksumConfig.algorithm)
-                           << "Byte order:" << endianStr;
+                const ChannelMapping& ch = mapping.channel(i);
+                values[i] = ch.enabled ? extractChannelValue(ch, frame, dataLength, r) : 0.0;
             }
-            return;
+            batch.insert(batch.end(), lastValues.begin(), lastValues.end());
         }
+        batchNumRows += mapping.repeat();
+    }
+    else
+    {
+        const unsigned repeat = _channelMapping.repeat();
+        for (unsigned r = 0; r < repeat; r++)
+        {
+            for (unsigned i = 0; i < _numChannels; i++)
+            {
+                const ChannelMapping& ch = _channelMapping.channel(i);
+                batch.push_back(ch.enabled ? extractChannelValue(ch, frame, dataLength, r) : 0.0);
+            }
+        }
+        batchNumRows += repeat;
     }
 
-    // Extract channels
-    SamplePack samples(_numChannels > 0 ? 1 : 0, _numChannels);
+    mFrames.add();
+}
 
-    for (unsigned i = 0; i < _numChannels; i++)
+void FramedReader::feedBatch()
+{
+    if (!batchNumRows) return;
+
+    const unsigned nc = _numChannels;
+    Q_ASSERT(batch.size() == batchNumRows * nc);
+
+    // transpose frames into channel buffers
+    SamplePack samples(batchNumRows, nc);
+    for (unsigned ci = 0; ci < nc; ci++)
     {
-        const ChannelMapping& ch = _channelMapping.channel(i);
-        if (ch.enabled)
+        double* chData = samples.data(ci);
+        const double* src = batch.data() + ci;
+        for (unsigned i = 0; i < batchNumRows; i++)
         {
-            samples.data(i)[0] = extractChannelValue(ch, _frameBuffer);
+            chData[i] = src[i * nc];
         }
     }
 
+    batch.clear();
+    batchNumRows = 0;
+
     feedOut(samples);
 }
 
-unsigned FramedReader::readData()
+void FramedReader::frameFound(quint64 offset)
 {
-    unsigned numBytesRead = 0;
-    
-    if (debugModeEnabled && _device->bytesAvailable() > 0)
-        qDebug() << "readData: bytes available =" << _device->bytesAvailable() 
-                 << "gotSync =" << gotSync << "frameSize =" << frameSize;
-
-    if (!_settingsValid)
+    if (hunting)
     {
+        mResyncs.add();
+        hunting = false;
         if (debugModeEnabled)
-            qDebug() << "readData: Settings invalid, skipping data read";
-        return numBytesRead;
+        {
+            ProtocolTrace::instance().record(
+                ProtocolTrace::SyncFound, offset, huntSkipped);
+        }
     }
+}
+
+unsigned FramedReader::readSyncFrames(const char* data, unsigned size)
+{
+    const unsigned syncSize = syncWord.size();
+    const unsigned csSize = checksumSize();
+    const unsigned fieldEnd = lengthField.offset + lengthField.width;
+    unsigned pos = 0;
 
-    unsigned bytesAvailable;
-    while ((bytesAvailable = _device->bytesAvailable()))
+    while (pos < size)
     {
-        if (!gotSync)
+        unsigned syncPos = findSync(data, pos, size);
+        if (syncPos > pos)
         {
-            // Read sync word
-            char c;
-            _device->getChar(&c);
-            numBytesRead++;
+            discard(data, pos, syncPos);
+            pos = syncPos;
+        }
 
-            if (debugModeEnabled)
-                qDebug() << "Sync check: received byte" << QString("0x%1").arg((uint8_t)c, 2, 16, QChar('0')).toUpper() 
-                         << "expected" << QString("0x%1").arg((uint8_t)syncWord[sync_i], 2, 16, QChar('0')).toUpper()
-                         << "position" << sync_i;
+        // wait for rest of the sync word
+        if (size - pos < syncSize) break;
+
+        unsigned length = frameLength;
+        if (lengthField.enabled)
+        {
+            if (size - pos < fieldEnd) break;
 
-            if (c == syncWord[sync_i])
+            quint32 value = readField((const uint8_t*) data + pos + lengthField.offset,
+                                      lengthField.width, lengthField.isLittleEndian);
+            length = value <= frameLength ? lengthField.frameLength(value, csSize) : 0;
+            if (length < fieldEnd + csSize || length > frameLength)
             {
-                sync_i++;
-                if (sync_i == (unsigned)syncWord.length())
+                if (debugModeEnabled)
                 {
-                    gotSync = true;
-                    if (debugModeEnabled)
-                        qDebug() << "Sync word found";
+                    ProtocolTrace::instance().record(
+                        ProtocolTrace::FrameSizeError, pendingOffset + pos, value);
                 }
-            }
-            else
-            {
-                if (debugModeEnabled && sync_i > 0)
-                    qCritical() << "Missed sync byte at position" << sync_i;
-                sync_i = 0;
+                // not a real frame start, continue hunting from next byte
+                discard(data, pos, pos + 1);
+                pos++;
+                continue;
             }
         }
-        else if (hasSizeByte && !gotSize)
-        {
-            // Read size field
-            if (isSizeField2B)
-            {
-                if (bytesAvailable < 2) break;
 
-                uint16_t frameSize16 = 0;
-                _device->read((char*)&frameSize16, 2);
-                numBytesRead += 2;
+        // wait for the complete frame
+        if (size - pos < length) break;
 
-                // Default to little endian since size fields are removed
-                frameSize = qFromLittleEndian(frameSize16);
-            }
-            else
-            {
-                frameSize = 0;
-                _device->getChar((char*)&frameSize);
-                numBytesRead++;
-            }
+        frameFound(pendingOffset + pos);
+        processFrame((const uint8_t*) data + pos, length, pendingOffset + pos);
+        pos += length;
+    }
 
-            if (frameSize == 0)
-            {
-                if (debugModeEnabled)
-                    qCritical() << "Frame size is 0!";
-                reset();
-            }
-            else if (frameSize > _frameBufferSize)
-            {
-                if (debugModeEnabled)
-                    qCritical() << "Frame size" << frameSize << "exceeds buffer!";
-                reset();
-            }
-            else
+    return pos;
+}
+
+/**
+ * Decodes a COBS encoded frame (without delimiter) into `out`, which
+ * should have room for `size` bytes.
+ *
+ * @return decoded size, -1 if frame is invalid
+ */
+static int decodeCobs(const uint8_t* in, unsigned size, uint8_t* out)
+{
+    unsigned i = 0;
+    unsigned n = 0;
+    while (i < size)
+    {
+        unsigned code = in[i++];
+        unsigned len = code - 1;
+        if (code == 0 || len > size - i) return -1;
+
+        std::memcpy(out + n, in + i, len);
+        n += len;
+        i += len;
+
+        // a zero follows every block except the longest and the last
+        if (code != 0xFF && i < size) out[n++] = 0;
+    }
+    return n;
+}
+
+/**
+ * Decodes a SLIP or HDLC escaped frame (without delimiters) into
+ * `out`, which should have room for `size` bytes. Runs of bytes between
+ * escapes are copied as a whole.
+ *
+ * @return decoded size, -1 if frame is invalid
+ */
+static int decodeEscaped(const uint8_t* in, unsigned size, uint8_t* out, bool isHdlc)
+{
+    const uint8_t esc = isHdlc ? 0x7D : 0xDB;
+    const uint8_t* end = in + size;
+    unsigned n = 0;
+
+    while (in < end)
+    {
+        const uint8_t* e = (const uint8_t*) memchr(in, esc, end - in);
+        unsigned run = (e != nullptr ? e : end) - in;
+        std::memcpy(out + n, in, run);
+        n += run;
+        if (e == nullptr) break;
+
+        // escape can't be the last byte of frame
+        if (e + 1 == end) return -1;
+
+        uint8_t c = e[1];
+        if (isHdlc)
+            out[n++] = c ^ 0x20;
+        else if (c == 0xDC)     // ESC_END
+            out[n++] = 0xC0;
+        else if (c == 0xDD)     // ESC_ESC
+            out[n++] = 0xDB;
+        else
+            return -1;
+        in = e + 2;
+    }
+    return n;
+}
+
+unsigned FramedReader::readStuffedFrames(const char* data, unsigned size)
+{
+    const char delimiter =
+        framing == FramedReaderSettings::Framing::COBS ? 0x00 :
+        framing == FramedReaderSettings::Framing::SLIP ? char(0xC0) : 0x7E;
+    // every byte may be escaped in the worst case
+    const unsigned maxStuffedSize = 2 * frameLength + 2;
+    unsigned pos = 0;
+
+    while (pos < size)
+    {
+        const char* d = (const char*) memchr(data + pos, delimiter, size - pos);
+        if (d == nullptr)
+        {
+            // data that can't fit in a frame, wait for the next delimiter
+            if (size - pos > maxStuffedSize)
             {
-                if (debugModeEnabled)
-                    qDebug() << "Frame size:" << frameSize;
-                gotSize = true;
+                discard(data, pos, size);
+                gotDelimiter = false;
+                pos = size;
             }
+            break;
         }
-        else
+
+        unsigned end = d - data;
+        if (!gotDelimiter)
+        {
+            // data before the first delimiter is a partial frame
+            if (end > pos) discard(data, pos, end);
+            gotDelimiter = true;
+        }
+        else if (end > pos) // back to back delimiters are empty frames
         {
-            // Read payload
-            unsigned checksumSize = _checksumConfig.enabled ? 
-                ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
-            unsigned totalFrameSize = frameSize + checksumSize;
+            processStuffedFrame((const uint8_t*) data + pos, end - pos, pendingOffset + pos);
+        }
+        pos = end + 1;
+    }
 
-            if (debugModeEnabled)
-                qDebug() << "Ready to read payload: frameSize =" << frameSize 
-                         << "checksumSize =" << checksumSize 
-                         << "totalFrameSize =" << totalFrameSize
-                         << "bytesAvailable =" << bytesAvailable;
+    return pos;
+}
 
-            if (bytesAvailable < totalFrameSize)
-            {
-                if (debugModeEnabled)
-                    qDebug() << "Not enough bytes available, waiting...";
-                break;
-            }
+void FramedReader::processStuffedFrame(const uint8_t* raw, unsigned rawSize, quint64 offset)
+{
+    if (decoded.size() < rawSize) decoded.resize(rawSize);
 
-            readFrameDataAndExtractChannels();
-            numBytesRead += totalFrameSize;
-            reset();
+    int n = framing == FramedReaderSettings::Framing::COBS ?
+        decodeCobs(raw, rawSize, decoded.data()) :
+        decodeEscaped(raw, rawSize, decoded.data(),
+                      framing == FramedReaderSettings::Framing::HDLC);
+    if (n < 0)
+    {
+        if (debugModeEnabled)
+        {
+            ProtocolTrace::instance().record(
+                ProtocolTrace::DecodeError, offset, rawSize, raw, rawSize);
         }
+        mBytesDiscarded.add(rawSize);
+        return;
     }
 
+    // frame size is known from delimiters, length field should agree
+    const unsigned length = n;
+    const unsigned csSize = checksumSize();
+    bool sizeOk = length > csSize && length <= frameLength;
+    if (sizeOk && lengthField.enabled)
+    {
+        const unsigned fieldEnd = lengthField.offset + lengthField.width;
+        sizeOk = length >= fieldEnd + csSize;
+        if (sizeOk)
+        {
+            quint32 value = readField(decoded.data() + lengthField.offset,
+                                      lengthField.width, lengthField.isLittleEndian);
+            sizeOk = value <= frameLength && lengthField.frameLength(value, csSize) == length;
+        }
+    }
+
+    if (!sizeOk)
+    {
+        if (debugModeEnabled)
+        {
+            ProtocolTrace::instance().record(
+                ProtocolTrace::FrameSizeError, offset, length);
+        }
+        mBytesDiscarded.add(rawSize);
+        return;
+    }
+
+    frameFound(offset);
+    processFrame(decoded.data(), length, offset);
+}
+
+unsigned FramedReader::readData()
+{
+    QByteArray bytes = _device->readAll();
+    unsigned numBytesRead = bytes.size();
+
+    if (!_settingsValid)
+    {
+        return numBytesRead;
+    }
+
+    // avoid a copy when there is no partial frame left from previous read
+    if (pending.isEmpty())
+    {
+        pending = bytes;
+    }
+    else
+    {
+        pending.append(bytes);
+    }
+
+    unsigned pos;
+    if (framing == FramedReaderSettings::Framing::SyncWord)
+    {
+        pos = readSyncFrames(pending.constData(), pending.size());
+    }
+    else
+    {
+        pos = readStuffedFrames(pending.constData(), pending.size());
+    }
+
+    feedBatch();
+
+    // keep the incomplete frame for next read
+    pending.remove(0, pos);
+    pendingOffset += pos;
+
     return numBytesRead;
 }
 
@@ -601,18 +1016,14 @@ void FramedReader::loadSettings(QSettings* settings)
     
     // Reload from settings widget
     _numChannels = _settingsWidget.numOfChannels();
-    hasSizeByte = false;  // Size field removed - frame format is now fixed
-    isSizeField2B = false;
+    framing = _settingsWidget.framing();
     syncWord = _settingsWidget.syncWord();
+    lengthField = _settingsWidget.lengthField();
+    messageId = _settingsWidget.messageId();
+    layouts = _settingsWidget.messageLayouts();
     debugModeEnabled = _settingsWidget.isDebugModeEnabled();
-    
-    // Calculate frame size: Total Frame Length - sync word - checksum
-    unsigned totalLength = _settingsWidget.totalFrameLength();
-    unsigned frameStartLength = syncWord.size();
-    unsigned checksumLength = _checksumConfig.enabled ? ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
-    int calculatedFrameSize = totalLength - frameStartLength - checksumLength;
-    frameSize = calculatedFrameSize > 0 ? calculatedFrameSize : 1;
-    // Endianness is now per-channel
-    
+    recalculateFrameSize();
+
     checkSettings();
+    reset();
 }
@@ -22,8 +22,10 @@
 
 #include <QSettings>
 #include <map>
+#include <vector>
 
 #include "abstractreader.h"
+#include "metrics.h"
 #include "framedreadersettings.h"
 #include "channelmapping.h"
 #include "checksumcalculator.h"
@@ -39,7 +41,7 @@ class FramedReader : public AbstractReader
 public:
     explicit FramedReader(QIODevice* device, QObject *parent = 0);
     QWidget* settingsWidget();
-    unsigned numChannels() const;
+    unsigned numReadChannels() const override;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -49,16 +51,25 @@ private:
     // settings related members
     FramedReaderSettings _settingsWidget;
     unsigned _numChannels;
+    FramedReaderSettings::Framing framing;
     QByteArray syncWord;
-    bool hasSizeByte;
-    bool isSizeField2B;
-    unsigned frameSize;
-    bool debugModeEnabled;
+    LengthFieldConfig lengthField;
+    MessageIdConfig messageId;
+    unsigned frameSize;     ///< payload size of fixed length frames
+    /// Total length of fixed frames, maximum length in length field mode
+    unsigned frameLength;
+    bool debugModeEnabled;  ///< records protocol events to `ProtocolTrace`
     
     // Channel mapping and checksum
     ChannelMappingConfig _channelMapping;
     ChecksumConfig _checksumConfig;
 
+    // Message ID dispatch
+    std::vector<MessageLayout> layouts;
+    std::vector<int> layoutTable;   ///< layout index of each message ID, -1 if unknown
+    std::vector<unsigned> layoutFirstChannel; ///< first channel of each layout
+    std::vector<double> lastValues; ///< held channel values in message ID mode
+
     /// Checks the validity of settings
     void checkSettings();
     QString getLastErrorMessage() const;
@@ -66,19 +77,97 @@ private:
     QString _lastErrorMessage;
 
     // read state related members
-    unsigned sync_i;
-    bool gotSync;
-    bool gotSize;
-    uint8_t* _frameBuffer;
-    unsigned _frameBufferSize;
+    const unsigned _frameBufferSize; ///< upper limit of any frame length
+    QByteArray pending;     ///< read data waiting for a complete frame
+    quint64 pendingOffset;  ///< stream offset of the first byte of `pending`
+    std::vector<double> batch; ///< extracted values in frame order
+    unsigned batchNumRows;     ///< number of frames in `batch`
+    std::vector<uint8_t> decoded; ///< unstuffed frame of stuffed framing
+    bool gotDelimiter;      ///< a delimiter is seen since reset (stuffed framing)
+    /// Bytes were discarded since the last found sync word
+    bool hunting;
+    unsigned huntSkipped;   ///< bytes discarded while hunting, for trace
+
+    // performance metrics, shared by all framed readers
+    MetricCounter& mFrames;
+    MetricCounter& mChecksumFailures;
+    MetricCounter& mResyncs;
+    MetricCounter& mBytesDiscarded;
+    MetricCounter& mUnknownMessages;
 
     void reset();
-    void readFrameDataAndExtractChannels();
-    
-    /// Extract a single value from buffer according to channel mapping
-    double extractChannelValue(const ChannelMapping& ch, const uint8_t* buffer);
-    
-    /// Calculate checksum based on configuration
+
+    /// Size of the checkCode at the end of frame, 0 if disabled
+    unsigned checksumSize() const;
+
+    /// Size of the sync word, stuffed frames don't have one
+    unsigned frameStartLength() const;
+
+    /**
+     * Finds and processes sync word framed frames in `data`.
+     *
+     * @return number of bytes consumed, rest is an incomplete frame
+     */
+    unsigned readSyncFrames(const char* data, unsigned size);
+
+    /**
+     * Finds, unstuffs and processes delimited frames in `data`.
+     *
+     * @return number of bytes consumed, rest is an incomplete frame
+     */
+    unsigned readStuffedFrames(const char* data, unsigned size);
+
+    /// Unstuffs a frame (without delimiters) and processes it
+    void processStuffedFrame(const uint8_t* raw, unsigned rawSize, quint64 offset);
+
+    /// Counts a resync if we were hunting for a frame
+    void frameFound(quint64 offset);
+
+    /**
+     * Returns the position of the first sync word in `data` starting
+     * from `pos`. A partial sync word at the end of data is also
+     * returned as a match. Returns `size` if not found.
+     */
+    unsigned findSync(const char* data, unsigned pos, unsigned size) const;
+
+    /// Discards bytes `[pos, end)` while hunting for the sync word
+    void discard(const char* data, unsigned pos, unsigned end);
+
+    /// Reads an unsigned integer field of `width` bytes
+    static quint32 readField(const uint8_t* field, unsigned width, bool isLittleEndian);
+
+    /**
+     * Builds message ID lookup table and channel groups of layouts.
+     *
+     * @return `false` and sets `_lastErrorMessage` if layouts are invalid
+     */
+    bool buildLayoutTable();
+
+    /// Returns the message layout index of frame, -1 if message ID is unknown
+    int findLayout(const uint8_t* frame, unsigned dataLength) const;
+
+    /**
+     * Verifies the checkCode of a complete frame and adds its channel
+     * values to the current batch.
+     *
+     * @param frame frame data starting from sync word
+     * @param length total frame length including checkCode
+     * @param offset stream offset of the frame, for trace
+     */
+    void processFrame(const uint8_t* frame, unsigned length, quint64 offset);
+
+    /// Feeds out the batched frames as a single `SamplePack`
+    void feedBatch();
+
+    /// Extract a single value (`sample` of a burst frame) from frame
+    /// according to channel mapping
+    double extractChannelValue(const ChannelMapping& ch, const uint8_t* frame,
+                               unsigned dataLength, unsigned sample = 0);
+
+    /// Extract a bit field channel, `data` points to its first byte
+    static double extractBitField(const ChannelMapping& ch, const uint8_t* data);
+
+    /// Calculate checksum of a frame (without checkCode) based on configuration
     uint32_t calculateFrameChecksum(const uint8_t* data, unsigned dataLength);
 
     unsigned readData() override;
@@ -89,6 +178,9 @@ private slots:
     void onChecksumConfigChanged();
     void onTotalFrameLengthChanged();
     void onSyncWordChanged(QByteArray);
+    void onFramingChanged(FramedReaderSettings::Framing);
+    void onLengthFieldChanged();
+    void onMessageIdChanged();
 
 private:
     void recalculateFrameSize();
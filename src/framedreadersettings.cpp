@@ -24,11 +24,13 @@
 #include "channelmappingdialog.h"
 #include "checksumconfigdialog.h"
 #include "checksumcalculator.h"
+#include "messagelayoutsdialog.h"
 
 FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::FramedReaderSettings),
-    fbGroup(this)
+    fbGroup(this),
+    traceView(nullptr)
 {
     ui->setupUi(this);
 
@@ -60,12 +62,17 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
     connect(ui->pbChecksumConfig, &QPushButton::clicked,
             this, &FramedReaderSettings::onChecksumConfigClicked);
 
+    connect(ui->pbShowTrace, &QPushButton::clicked,
+            this, &FramedReaderSettings::onShowTraceClicked);
+
     // Size field is now fixed (no dynamic sizing)
 
     connect(ui->spNumOfChannels, &QSpinBox::valueChanged,
             [this](int value)
             {
-                _channelMapping.setNumChannels(value);
+                // in message ID mode channels are set by message layouts
+                if (!ui->cbMessageId->isChecked())
+                    _channelMapping.setNumChannels(value);
                 emit numOfChannelsChanged(value);
             });
 
@@ -77,9 +84,51 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
     connect(ui->leSyncWord, &QLineEdit::textChanged,
             this, &FramedReaderSettings::updatePayloadSize);
 
+    connect(ui->cbFraming, &QComboBox::currentIndexChanged,
+            [this]()
+            {
+                ui->leSyncWord->setEnabled(framing() == Framing::SyncWord);
+                updatePayloadSize();
+                emit framingChanged(framing());
+            });
+
     // Update payload size when checkCode config changes
     connect(this, &FramedReaderSettings::checksumConfigChanged,
             this, &FramedReaderSettings::updatePayloadSize);
+
+    // length field widgets are only meaningful when enabled
+    connect(ui->cbLengthField, &QCheckBox::toggled,
+            [this](bool enabled)
+            {
+                ui->spLengthFieldPosition->setEnabled(enabled);
+                ui->cbLengthFieldWidth->setEnabled(enabled);
+                ui->cbLengthFieldEndianness->setEnabled(enabled);
+                ui->cbLengthFieldCovers->setEnabled(enabled);
+                ui->spTotalFrameLength->setToolTip(enabled ?
+                    tr("Maximum frame length in bytes (including frame start, payload, and checkCode)") :
+                    tr("Enter the total frame length in bytes (including frame start, payload, and checkCode)"));
+            });
+    connect(ui->cbLengthField, &QCheckBox::toggled,
+            this, &FramedReaderSettings::onLengthFieldEdited);
+    connect(ui->spLengthFieldPosition, &QSpinBox::valueChanged,
+            this, &FramedReaderSettings::onLengthFieldEdited);
+    connect(ui->cbLengthFieldWidth, &QComboBox::currentIndexChanged,
+            this, &FramedReaderSettings::onLengthFieldEdited);
+    connect(ui->cbLengthFieldEndianness, &QComboBox::currentIndexChanged,
+            this, &FramedReaderSettings::onLengthFieldEdited);
+    connect(ui->cbLengthFieldCovers, &QComboBox::currentIndexChanged,
+            this, &FramedReaderSettings::onLengthFieldEdited);
+
+    connect(ui->cbMessageId, &QCheckBox::toggled,
+            this, &FramedReaderSettings::onMessageIdToggled);
+    connect(ui->spMessageIdPosition, &QSpinBox::valueChanged,
+            this, &FramedReaderSettings::onMessageIdEdited);
+    connect(ui->cbMessageIdWidth, &QComboBox::currentIndexChanged,
+            this, &FramedReaderSettings::onMessageIdEdited);
+    connect(ui->cbMessageIdEndianness, &QComboBox::currentIndexChanged,
+            this, &FramedReaderSettings::onMessageIdEdited);
+    connect(ui->pbMessageLayouts, &QPushButton::clicked,
+            this, &FramedReaderSettings::onMessageLayoutsClicked);
 }
 
 FramedReaderSettings::~FramedReaderSettings()
@@ -107,6 +156,16 @@ unsigned FramedReaderSettings::numOfChannels()
 
 // NumberFormat method removed - each channel now has its own format
 
+FramedReaderSettings::Framing FramedReaderSettings::framing() const
+{
+    return (Framing) qBound(0, ui->cbFraming->currentIndex(), (int) Framing::HDLC);
+}
+
+unsigned FramedReaderSettings::frameStartLength()
+{
+    return framing() == Framing::SyncWord ? syncWord().size() : 0;
+}
+
 QByteArray FramedReaderSettings::syncWord()
 {
     QString text = ui->leSyncWord->text().remove(' ');
@@ -158,11 +217,96 @@ ChecksumConfig& FramedReaderSettings::checksumConfig()
     return _checksumConfig;
 }
 
+LengthFieldConfig FramedReaderSettings::lengthField() const
+{
+    const unsigned widths[] = {1, 2, 4};
+
+    LengthFieldConfig config;
+    config.enabled = ui->cbLengthField->isChecked();
+    config.offset = ui->spLengthFieldPosition->value() - 1;
+    config.width = widths[qBound(0, ui->cbLengthFieldWidth->currentIndex(), 2)];
+    config.isLittleEndian = ui->cbLengthFieldEndianness->currentIndex() == 0;
+    config.covers = (LengthFieldConfig::Covers) qBound(
+        0, ui->cbLengthFieldCovers->currentIndex(), (int) LengthFieldConfig::CoversFrame);
+    return config;
+}
+
+void FramedReaderSettings::onLengthFieldEdited()
+{
+    emit lengthFieldChanged();
+}
+
+MessageIdConfig FramedReaderSettings::messageId() const
+{
+    MessageIdConfig config;
+    config.enabled = ui->cbMessageId->isChecked();
+    config.offset = ui->spMessageIdPosition->value() - 1;
+    config.width = ui->cbMessageIdWidth->currentIndex() == 1 ? 2 : 1;
+    config.isLittleEndian = ui->cbMessageIdEndianness->currentIndex() == 0;
+    return config;
+}
+
+const std::vector<MessageLayout>& FramedReaderSettings::messageLayouts() const
+{
+    return _messageLayouts;
+}
+
+void FramedReaderSettings::onMessageIdToggled(bool enabled)
+{
+    ui->spMessageIdPosition->setEnabled(enabled);
+    ui->cbMessageIdWidth->setEnabled(enabled);
+    ui->cbMessageIdEndianness->setEnabled(enabled);
+    ui->pbMessageLayouts->setEnabled(enabled);
+    ui->pbChannelMapping->setEnabled(!enabled);
+    ui->spNumOfChannels->setEnabled(!enabled);
+
+    // start with current channel mapping as the first message
+    if (enabled && _messageLayouts.empty())
+    {
+        MessageLayout layout;
+        layout.mapping = _channelMapping;
+        _messageLayouts.push_back(layout);
+    }
+
+    updateLayoutChannels();
+    emit messageIdChanged();
+}
+
+void FramedReaderSettings::onMessageIdEdited()
+{
+    emit messageIdChanged();
+}
+
+void FramedReaderSettings::updateLayoutChannels()
+{
+    unsigned numChannels = _channelMapping.numChannels();
+    if (ui->cbMessageId->isChecked())
+    {
+        numChannels = 0;
+        for (auto& layout : _messageLayouts)
+            numChannels += layout.mapping.numChannels();
+    }
+    ui->spNumOfChannels->setValue(numChannels);
+}
+
+void FramedReaderSettings::onMessageLayoutsClicked()
+{
+    unsigned checksumLength = _checksumConfig.enabled ?
+        ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
+    unsigned maxId = messageId().width == 1 ? 0xFF : 0xFFFF;
+    MessageLayoutsDialog dialog(_messageLayouts, totalFrameLength() - checksumLength, maxId, this);
+    if (dialog.exec() == QDialog::Accepted)
+    {
+        updateLayoutChannels();
+        emit messageIdChanged();
+    }
+}
+
 void FramedReaderSettings::onChannelMappingClicked()
 {
     ChannelMappingDialog dialog(_channelMapping, this);
     // Pass total frame size (sync word + payload) since positions are now absolute
-    unsigned totalFrameSize = syncWord().size() + ui->spSize->value();
+    unsigned totalFrameSize = frameStartLength() + ui->spSize->value();
     dialog.setTotalFrameSize(totalFrameSize);
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -179,12 +323,74 @@ void FramedReaderSettings::onChecksumConfigClicked()
     }
 }
 
+void FramedReaderSettings::onShowTraceClicked()
+{
+    if (traceView == nullptr) traceView = new ProtocolTraceView(this);
+    traceView->show();
+    traceView->raise();
+    traceView->activateWindow();
+}
+
+/// Saves channel mapping into current group of settings
+static void saveChannelMapping(QSettings* settings, const ChannelMappingConfig& mapping)
+{
+    settings->beginGroup(SG_CustomFrame_ChannelMapping);
+    settings->setValue(SG_CustomFrame_SamplesPerFrame, mapping.repeat());
+    for (unsigned i = 0; i < mapping.numChannels(); i++)
+    {
+        const ChannelMapping& ch = mapping.channel(i);
+        QString chKey = QString("%1_%2").arg(SG_CustomFrame_Channel).arg(i);
+        settings->beginGroup(chKey);
+        settings->setValue(SG_CustomFrame_ChannelByteOffset, ch.byteOffset);
+        settings->setValue(SG_CustomFrame_ChannelByteLength, ch.byteLength);
+        settings->setValue(SG_CustomFrame_ChannelFormat, numberFormatToStr(ch.numberFormat));
+        settings->setValue(SG_CustomFrame_ChannelEndianness, ch.endianness == LittleEndian ? "little" : "big");
+        settings->setValue(SG_CustomFrame_ChannelEnabled, ch.enabled);
+        settings->setValue(SG_CustomFrame_ChannelBitOffset, ch.bitOffset);
+        settings->setValue(SG_CustomFrame_ChannelBitWidth, ch.bitWidth);
+        settings->setValue(SG_CustomFrame_ChannelStride, ch.stride);
+        settings->endGroup();
+    }
+    settings->endGroup();
+}
+
+/// Loads channel mapping from current group of settings
+static void loadChannelMapping(QSettings* settings, ChannelMappingConfig& mapping)
+{
+    settings->beginGroup(SG_CustomFrame_ChannelMapping);
+    mapping.setRepeat(settings->value(SG_CustomFrame_SamplesPerFrame, mapping.repeat()).toUInt());
+    for (unsigned i = 0; i < mapping.numChannels(); i++)
+    {
+        ChannelMapping& ch = mapping.channel(i);
+        QString chKey = QString("%1_%2").arg(SG_CustomFrame_Channel).arg(i);
+        if (settings->childGroups().contains(chKey))
+        {
+            settings->beginGroup(chKey);
+            ch.byteOffset = settings->value(SG_CustomFrame_ChannelByteOffset, ch.byteOffset).toInt();
+            ch.byteLength = settings->value(SG_CustomFrame_ChannelByteLength, ch.byteLength).toInt();
+            ch.numberFormat = strToNumberFormat(settings->value(SG_CustomFrame_ChannelFormat, "uint8").toString());
+            QString endiStr = settings->value(SG_CustomFrame_ChannelEndianness, "little").toString();
+            ch.endianness = (endiStr == "little") ? LittleEndian : BigEndian;
+            ch.enabled = settings->value(SG_CustomFrame_ChannelEnabled, true).toBool();
+            ch.bitOffset = settings->value(SG_CustomFrame_ChannelBitOffset, 0).toUInt();
+            ch.bitWidth = settings->value(SG_CustomFrame_ChannelBitWidth, 0).toUInt();
+            ch.stride = settings->value(SG_CustomFrame_ChannelStride, 0).toUInt();
+            if (ch.isBitField()) ch.byteLength = ch.dataLength();
+            settings->endGroup();
+        }
+    }
+    settings->endGroup();
+}
+
 void FramedReaderSettings::saveSettings(QSettings* settings)
 {
     settings->beginGroup(SettingGroup_CustomFrame);
-    settings->setValue(SG_CustomFrame_NumOfChannels, numOfChannels());
+    // in message ID mode number of channels is the total of layouts
+    settings->setValue(SG_CustomFrame_NumOfChannels, _channelMapping.numChannels());
     settings->setValue(SG_CustomFrame_TotalFrameLength, totalFrameLength());
     settings->setValue(SG_CustomFrame_FrameStart, ui->leSyncWord->text());
+    const char* framingStr[] = {"sync", "cobs", "slip", "hdlc"};
+    settings->setValue(SG_CustomFrame_Framing, framingStr[(int) framing()]);
     settings->setValue(SG_CustomFrame_FixedFrameSize, fixedFrameSize());
     settings->setValue(SG_CustomFrame_Checksum, ui->cbChecksum->isChecked());
     settings->setValue(SG_CustomFrame_DebugMode, ui->cbDebugMode->isChecked());
@@ -195,18 +401,34 @@ void FramedReaderSettings::saveSettings(QSettings* settings)
     settings->setValue(SG_CustomFrame_ChecksumEndByte, _checksumConfig.endByte);
     settings->setValue(SG_CustomFrame_ChecksumEndianness, _checksumConfig.isLittleEndian ? "little" : "big");
 
+    // Save length field configuration
+    const char* coversStr[] = {"payload", "payloadAndChecksum", "frame"};
+    LengthFieldConfig lf = lengthField();
+    settings->setValue(SG_CustomFrame_LengthField, lf.enabled);
+    settings->setValue(SG_CustomFrame_LengthFieldOffset, lf.offset);
+    settings->setValue(SG_CustomFrame_LengthFieldWidth, lf.width);
+    settings->setValue(SG_CustomFrame_LengthFieldEndianness, lf.isLittleEndian ? "little" : "big");
+    settings->setValue(SG_CustomFrame_LengthFieldCovers, coversStr[lf.covers]);
+
     // Save channel mapping
-    settings->beginGroup(SG_CustomFrame_ChannelMapping);
-    for (unsigned i = 0; i < _channelMapping.numChannels(); i++)
+    saveChannelMapping(settings, _channelMapping);
+
+    // Save message ID configuration and layouts
+    MessageIdConfig mid = messageId();
+    settings->setValue(SG_CustomFrame_MessageId, mid.enabled);
+    settings->setValue(SG_CustomFrame_MessageIdOffset, mid.offset);
+    settings->setValue(SG_CustomFrame_MessageIdWidth, mid.width);
+    settings->setValue(SG_CustomFrame_MessageIdEndianness, mid.isLittleEndian ? "little" : "big");
+
+    settings->beginGroup(SG_CustomFrame_MessageLayouts);
+    settings->remove("");       // forget removed layouts
+    for (unsigned i = 0; i < _messageLayouts.size(); i++)
     {
-        const ChannelMapping& ch = _channelMapping.channel(i);
-        QString chKey = QString("%1_%2").arg(SG_CustomFrame_Channel).arg(i);
-        settings->beginGroup(chKey);
-        settings->setValue(SG_CustomFrame_ChannelByteOffset, ch.byteOffset);
-        settings->setValue(SG_CustomFrame_ChannelByteLength, ch.byteLength);
-        settings->setValue(SG_CustomFrame_ChannelFormat, numberFormatToStr(ch.numberFormat));
-        settings->setValue(SG_CustomFrame_ChannelEndianness, ch.endianness == LittleEndian ? "little" : "big");
-        settings->setValue(SG_CustomFrame_ChannelEnabled, ch.enabled);
+        const MessageLayout& layout = _messageLayouts[i];
+        settings->beginGroup(QString("%1_%2").arg(SG_CustomFrame_Layout).arg(i));
+        settings->setValue(SG_CustomFrame_LayoutId, layout.id);
+        settings->setValue(SG_CustomFrame_NumOfChannels, layout.mapping.numChannels());
+        saveChannelMapping(settings, layout.mapping);
         settings->endGroup();
     }
     settings->endGroup();
@@ -218,9 +440,12 @@ void FramedReaderSettings::loadSettings(QSettings* settings)
 {
     settings->beginGroup(SettingGroup_CustomFrame);
 
-    // load number of channels
-    ui->spNumOfChannels->setValue(
-        settings->value(SG_CustomFrame_NumOfChannels, numOfChannels()).toInt());
+    // load number of channels, mapping is resized also in message ID mode
+    unsigned numChannels = qBound(
+        1u, settings->value(SG_CustomFrame_NumOfChannels, _channelMapping.numChannels()).toUInt(),
+        MAX_NUM_CHANNELS);
+    ui->spNumOfChannels->setValue(numChannels);
+    _channelMapping.setNumChannels(numChannels);
 
     // load total frame length
     ui->spTotalFrameLength->setValue(
@@ -237,6 +462,12 @@ void FramedReaderSettings::loadSettings(QSettings* settings)
         ui->leSyncWord->setText(frameStartSetting);
     }
 
+    // load framing
+    QString framingStr = settings->value(SG_CustomFrame_Framing, "sync").toString();
+    ui->cbFraming->setCurrentIndex(framingStr == "cobs" ? 1 :
+                                   framingStr == "slip" ? 2 :
+                                   framingStr == "hdlc" ? 3 : 0);
+
     // load fixed frame size
     ui->spSize->setValue(
         settings->value(SG_CustomFrame_FixedFrameSize, ui->spSize->value()).toInt());
@@ -257,26 +488,66 @@ void FramedReaderSettings::loadSettings(QSettings* settings)
     QString endiannessStr = settings->value(SG_CustomFrame_ChecksumEndianness, "little").toString();
     _checksumConfig.isLittleEndian = (endiannessStr == "little");
 
+    // Load length field configuration
+    ui->spLengthFieldPosition->setValue(
+        settings->value(SG_CustomFrame_LengthFieldOffset,
+                        ui->spLengthFieldPosition->value() - 1).toInt() + 1);
+    unsigned lfWidth = settings->value(SG_CustomFrame_LengthFieldWidth, 1).toUInt();
+    ui->cbLengthFieldWidth->setCurrentIndex(lfWidth == 4 ? 2 : lfWidth == 2 ? 1 : 0);
+    ui->cbLengthFieldEndianness->setCurrentIndex(
+        settings->value(SG_CustomFrame_LengthFieldEndianness, "little").toString() == "little" ? 0 : 1);
+    QString coversStr = settings->value(SG_CustomFrame_LengthFieldCovers, "payload").toString();
+    ui->cbLengthFieldCovers->setCurrentIndex(
+        coversStr == "frame" ? 2 : coversStr == "payloadAndChecksum" ? 1 : 0);
+    ui->cbLengthField->setChecked(
+        settings->value(SG_CustomFrame_LengthField, ui->cbLengthField->isChecked()).toBool());
+
     // Load channel mapping
-    settings->beginGroup(SG_CustomFrame_ChannelMapping);
-    for (unsigned i = 0; i < _channelMapping.numChannels(); i++)
+    loadChannelMapping(settings, _channelMapping);
+
+    // Load message ID configuration and layouts
+    ui->spMessageIdPosition->setValue(
+        settings->value(SG_CustomFrame_MessageIdOffset,
+                        ui->spMessageIdPosition->value() - 1).toInt() + 1);
+    ui->cbMessageIdWidth->setCurrentIndex(
+        settings->value(SG_CustomFrame_MessageIdWidth, 1).toUInt() == 2 ? 1 : 0);
+    ui->cbMessageIdEndianness->setCurrentIndex(
+        settings->value(SG_CustomFrame_MessageIdEndianness, "little").toString() == "little" ? 0 : 1);
+
+    settings->beginGroup(SG_CustomFrame_MessageLayouts);
+    QStringList layoutKeys = settings->childGroups();
+    if (!layoutKeys.isEmpty())
     {
-        ChannelMapping& ch = _channelMapping.channel(i);
-        QString chKey = QString("%1_%2").arg(SG_CustomFrame_Channel).arg(i);
-        if (settings->childGroups().contains(chKey))
+        _messageLayouts.clear();
+        for (unsigned i = 0; ; i++)
         {
-            settings->beginGroup(chKey);
-            ch.byteOffset = settings->value(SG_CustomFrame_ChannelByteOffset, ch.byteOffset).toInt();
-            ch.byteLength = settings->value(SG_CustomFrame_ChannelByteLength, ch.byteLength).toInt();
-            ch.numberFormat = strToNumberFormat(settings->value(SG_CustomFrame_ChannelFormat, "uint8").toString());
-            QString endiStr = settings->value(SG_CustomFrame_ChannelEndianness, "little").toString();
-            ch.endianness = (endiStr == "little") ? LittleEndian : BigEndian;
-            ch.enabled = settings->value(SG_CustomFrame_ChannelEnabled, true).toBool();
+            QString layoutKey = QString("%1_%2").arg(SG_CustomFrame_Layout).arg(i);
+            if (!layoutKeys.contains(layoutKey)) break;
+
+            settings->beginGroup(layoutKey);
+            MessageLayout layout;
+            layout.id = settings->value(SG_CustomFrame_LayoutId, 0).toUInt();
+            layout.mapping.setNumChannels(
+                qBound(1u, settings->value(SG_CustomFrame_NumOfChannels, 1).toUInt(), MAX_NUM_CHANNELS));
+            loadChannelMapping(settings, layout.mapping);
+            _messageLayouts.push_back(layout);
             settings->endGroup();
         }
     }
     settings->endGroup();
 
+    bool messageIdEnabled = settings->value(SG_CustomFrame_MessageId, ui->cbMessageId->isChecked()).toBool();
+    if (messageIdEnabled == ui->cbMessageId->isChecked())
+    {
+        // layouts may have changed even if the mode hasn't
+        updateLayoutChannels();
+        emit messageIdChanged();
+    }
+    else
+    {
+        ui->cbMessageId->setChecked(messageIdEnabled);
+    }
+
     settings->endGroup();
     updatePayloadSize();
 }
@@ -295,7 +566,7 @@ void FramedReaderSettings::updatePayloadSize()
 void FramedReaderSettings::updatePayloadSizeInternal()
 {
     unsigned totalLength = totalFrameLength();
-    unsigned frameStartLength = syncWord().size();
+    unsigned frameStartLength = this->frameStartLength();
     unsigned checksumLength = _checksumConfig.enabled ? ChecksumCalculator::getOutputSize(_checksumConfig.algorithm) : 0;
     
     // No size field length - frame format is now fixed
@@ -29,6 +29,7 @@
 #include "endiannessbox.h"
 #include "channelmapping.h"
 #include "checksumcalculator.h"
+#include "protocoltraceview.h"
 
 namespace Ui {
 class FramedReaderSettings;
@@ -45,17 +46,81 @@ struct ChecksumConfig
     ChecksumConfig() : algorithm(ChecksumAlgorithm::None), startByte(0), endByte(0), enabled(false), isLittleEndian(true) {}
 };
 
+/**
+ * Describes the length field of variable length frames.
+ */
+struct LengthFieldConfig
+{
+    /// What the value of length field counts
+    enum Covers
+    {
+        CoversPayload,              ///< bytes after the field, excluding checkCode
+        CoversPayloadAndChecksum,   ///< bytes after the field, including checkCode
+        CoversFrame                 ///< whole frame, including frame start
+    };
+
+    bool enabled;
+    unsigned offset;      ///< position from frame start (0-based internally, 1-based in UI)
+    unsigned width;       ///< size of the field in bytes (1, 2 or 4)
+    bool isLittleEndian;
+    Covers covers;
+
+    LengthFieldConfig() : enabled(false), offset(2), width(1), isLittleEndian(true), covers(CoversPayload) {}
+
+    /**
+     * Returns total frame length (from frame start to the end of
+     * checkCode) for a given field value.
+     */
+    unsigned frameLength(unsigned value, unsigned checksumSize) const
+    {
+        switch (covers)
+        {
+            case CoversPayload:
+                return offset + width + value + checksumSize;
+            case CoversPayloadAndChecksum:
+                return offset + width + value;
+            case CoversFrame:
+                return value;
+        }
+        return value;
+    }
+};
+
+/**
+ * Describes the message ID field of frames carrying different message
+ * types, each with its own `MessageLayout`.
+ */
+struct MessageIdConfig
+{
+    bool enabled;
+    unsigned offset;      ///< position from frame start (0-based internally, 1-based in UI)
+    unsigned width;       ///< size of the field in bytes (1 or 2)
+    bool isLittleEndian;
+
+    MessageIdConfig() : enabled(false), offset(2), width(1), isLittleEndian(true) {}
+};
+
 class FramedReaderSettings : public QWidget
 {
     Q_OBJECT
 
 public:
+    /// How frames are delimited in the stream
+    enum class Framing
+    {
+        SyncWord,   ///< frames start with 'Frame Start' bytes
+        COBS,       ///< consistent overhead byte stuffing, 0x00 delimited
+        SLIP,       ///< RFC 1055, 0xC0 delimited
+        HDLC        ///< asynchronous HDLC (RFC 1662), 0x7E delimited
+    };
+
     explicit FramedReaderSettings(QWidget *parent = 0);
     ~FramedReaderSettings();
 
     void showMessage(QString message, bool error = false);
 
     unsigned numOfChannels();
+    Framing framing() const;
     QByteArray syncWord();
     unsigned fixedFrameSize() const;
     unsigned totalFrameLength() const;
@@ -64,6 +129,9 @@ public:
     
     ChannelMappingConfig& channelMapping();
     ChecksumConfig& checksumConfig();
+    LengthFieldConfig lengthField() const;
+    MessageIdConfig messageId() const;
+    const std::vector<MessageLayout>& messageLayouts() const;
     
     /// Save settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -74,6 +142,7 @@ signals:
     /// If sync word is invalid (empty or 1 nibble missing at the end)
     /// signaled with an empty array
     void syncWordChanged(QByteArray);
+    void framingChanged(Framing);
     void fixedFrameSizeChanged(unsigned);
     void totalFrameLengthChanged(unsigned);
     void checksumChanged(bool);
@@ -81,22 +150,36 @@ signals:
     void debugModeChanged(bool);
     void channelMappingChanged();
     void checksumConfigChanged();
+    void lengthFieldChanged();
+    /// Message ID field or message layouts are changed
+    void messageIdChanged();
 
 private:
     Ui::FramedReaderSettings *ui;
     QButtonGroup fbGroup;
     ChannelMappingConfig _channelMapping;
     ChecksumConfig _checksumConfig;
+    std::vector<MessageLayout> _messageLayouts;
+    ProtocolTraceView* traceView; ///< created when first shown
     
 private:
     void updatePayloadSizeInternal();
+    /// Size of frame start, stuffed frames don't have one
+    unsigned frameStartLength();
+    /// Sets number of channels to the total of message layouts
+    void updateLayoutChannels();
 
 private slots:
     void onSyncWordEdited();
     void onChannelMappingClicked();
     void onChecksumConfigClicked();
+    void onShowTraceClicked();
     void onTotalFrameLengthChanged();
     void updatePayloadSize();
+    void onLengthFieldEdited();
+    void onMessageIdToggled(bool enabled);
+    void onMessageIdEdited();
+    void onMessageLayoutsClicked();
 };
 
 #endif // FRAMEDREADERSETTINGS_H
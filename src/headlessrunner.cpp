@@ -0,0 +1,439 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <csignal>
+#include <string.h>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTextStream>
+#include <QtDebug>
+
+#include "headlessrunner.h"
+#include "setting_defines.h"
+#include "tracer.h"
+
+/// Interval of checking for signals and limits, in milliseconds
+#define POLL_INTERVAL 100
+
+/// Set by signal handler, checked periodically from the event loop
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void signalHandler(int signal)
+{
+    Q_UNUSED(signal);
+    stopRequested = 1;
+}
+
+HeadlessRunner::HeadlessRunner(QObject* parent) :
+    QObject(parent),
+    reader(&serialPort, this)
+{
+    csvSeparator = ",";
+    csvTimestamp = DataRecorder::TimestampOption::disabled;
+    csvHeader = true;
+    duration = 0;
+    statsInterval = 1;
+    lastStatsTime = 0;
+    totalBytes = 0;
+    totalSamples = 0;
+    intervalSamples = 0;
+    intervalBytes = 0;
+    bufferedBytes = 0;
+    running = false;
+
+    connect(&pollTimer, &QTimer::timeout, this, &HeadlessRunner::onPoll);
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    if (running) stop();
+}
+
+bool HeadlessRunner::isRequested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0) return true;
+    }
+    return false;
+}
+
+bool HeadlessRunner::setup(const QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsCompactedShortOptions);
+    parser.setApplicationDescription(
+        "Headless mode: acquire and record data from serial port without GUI.\n"
+        "Settings are loaded from the configuration file, or from the last session if not given.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption headlessOpt("headless", "Run without GUI.");
+    QCommandLineOption configOpt({"c", "config"}, "Load configuration from file.", "filename");
+    QCommandLineOption portOpt({"p", "port"}, "Set port name.", "port name");
+    QCommandLineOption baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate");
+    QCommandLineOption openPortOpt({"o", "open"}, "Ignored, port is always opened in headless mode.");
+    QCommandLineOption csvOpt("record-csv", "Record parsed data to CSV file.", "filename");
+    QCommandLineOption rawOpt("record-raw", "Record raw data to binary file.", "filename");
+    QCommandLineOption durationOpt("duration", "Stop after given number of seconds.", "seconds");
+    QCommandLineOption traceOpt("trace", "Record a trace and save it to file when stopped.", "filename");
+    QCommandLineOption statsOpt("stats-interval",
+                                "Print statistics every given number of seconds, 0 to disable. Default is 1.",
+                                "seconds");
+
+    parser.addOption(headlessOpt);
+    parser.addOption(configOpt);
+    parser.addOption(portOpt);
+    parser.addOption(baudrateOpt);
+    parser.addOption(openPortOpt);
+    parser.addOption(csvOpt);
+    parser.addOption(rawOpt);
+    parser.addOption(durationOpt);
+    parser.addOption(statsOpt);
+    parser.addOption(traceOpt);
+
+    parser.process(app);
+
+    if (parser.isSet(configOpt))
+    {
+        QString fileName = parser.value(configOpt);
+        QFileInfo fileInfo(fileName);
+
+        if (fileInfo.exists() && fileInfo.isFile())
+        {
+            QSettings settings(fileName, QSettings::IniFormat);
+            loadSettings(&settings);
+        }
+        else
+        {
+            qCritical() << "Configuration file not exist:" << fileName;
+            return false;
+        }
+    }
+    else
+    {
+        QSettings settings(PROGRAM_NAME, PROGRAM_NAME);
+        loadSettings(&settings);
+    }
+
+    if (parser.isSet(portOpt))
+    {
+        serialPort.setPortName(parser.value(portOpt));
+    }
+
+    if (parser.isSet(baudrateOpt))
+    {
+        bool ok;
+        qint32 baudRate = parser.value(baudrateOpt).toInt(&ok);
+        if (!ok || baudRate <= 0)
+        {
+            qCritical() << "Invalid baud rate:" << parser.value(baudrateOpt);
+            return false;
+        }
+        serialPort.setBaudRate(baudRate);
+    }
+
+    csvFileName = parser.value(csvOpt);
+    rawFileName = parser.value(rawOpt);
+    traceFileName = parser.value(traceOpt);
+
+    if (parser.isSet(durationOpt))
+    {
+        bool ok;
+        duration = parser.value(durationOpt).toUInt(&ok);
+        if (!ok)
+        {
+            qCritical() << "Invalid duration:" << parser.value(durationOpt);
+            return false;
+        }
+    }
+
+    if (parser.isSet(statsOpt))
+    {
+        bool ok;
+        statsInterval = parser.value(statsOpt).toUInt(&ok);
+        if (!ok)
+        {
+            qCritical() << "Invalid statistics interval:" << parser.value(statsOpt);
+            return false;
+        }
+    }
+
+    if (serialPort.portName().isEmpty())
+    {
+        qCritical() << "No port is selected, use --port option.";
+        return false;
+    }
+
+    return true;
+}
+
+void HeadlessRunner::loadSettings(QSettings* settings)
+{
+    // port settings
+    settings->beginGroup(SettingGroup_Port);
+    serialPort.setPortName(settings->value(SG_Port_SelectedPort).toString());
+    serialPort.setBaudRate(settings->value(SG_Port_BaudRate, 9600).toInt());
+
+    QString parity = settings->value(SG_Port_Parity).toString();
+    if (parity == "odd")
+    {
+        serialPort.setParity(QSerialPort::OddParity);
+    }
+    else if (parity == "even")
+    {
+        serialPort.setParity(QSerialPort::EvenParity);
+    }
+    else
+    {
+        serialPort.setParity(QSerialPort::NoParity);
+    }
+
+    int dataBits = settings->value(SG_Port_DataBits, QSerialPort::Data8).toInt();
+    if (dataBits >= 5 && dataBits <= 8)
+    {
+        serialPort.setDataBits((QSerialPort::DataBits) dataBits);
+    }
+
+    int stopBits = settings->value(SG_Port_StopBits, QSerialPort::OneStop).toInt();
+    serialPort.setStopBits(stopBits == QSerialPort::TwoStop ?
+                           QSerialPort::TwoStop : QSerialPort::OneStop);
+
+    QString flowControl = settings->value(SG_Port_FlowControl).toString();
+    if (flowControl == "hardware")
+    {
+        serialPort.setFlowControl(QSerialPort::HardwareControl);
+    }
+    else if (flowControl == "software")
+    {
+        serialPort.setFlowControl(QSerialPort::SoftwareControl);
+    }
+    else
+    {
+        serialPort.setFlowControl(QSerialPort::NoFlowControl);
+    }
+    settings->endGroup();
+
+    // reader settings
+    settings->beginGroup(SettingGroup_DataFormat);
+    reader.setFirstChannelAsX(settings->value(SG_DataFormat_FirstChannelAsX, false).toBool());
+    settings->endGroup();
+    reader.loadSettings(settings);
+
+    // channel names
+    stream.loadSettings(settings);
+
+    // record settings, same as record panel
+    settings->beginGroup(SettingGroup_Record);
+    csvHeader = settings->value(SG_Record_Header, true).toBool();
+    csvSeparator = settings->value(SG_Record_Separator, ",").toString();
+    csvSeparator.replace("\\t", "\t");
+    csvRecorder.setDecimals(settings->value(SG_Record_Decimals, 6).toUInt());
+    csvRecorder.disableBuffering = settings->value(SG_Record_DisableBuffering, false).toBool();
+    csvRecorder.windowsLE = settings->value("windowsLineEnding", false).toBool();
+    rawRecorder.disableBuffering = settings->value("rawDisableBuffering", false).toBool();
+
+    csvTimestamp = DataRecorder::TimestampOption::disabled;
+    if (settings->value(SG_Record_Timestamp, false).toBool())
+    {
+        QString tsFormat = settings->value(SG_Record_TimestampFormat).toString();
+        if (tsFormat == "seconds_with_precision")
+        {
+            csvTimestamp = DataRecorder::TimestampOption::seconds_precision;
+        }
+        else if (tsFormat == "milliseconds")
+        {
+            csvTimestamp = DataRecorder::TimestampOption::milliseconds;
+        }
+        else
+        {
+            csvTimestamp = DataRecorder::TimestampOption::seconds;
+        }
+    }
+    settings->endGroup();
+}
+
+bool HeadlessRunner::start()
+{
+    // raw data must be captured before reader consumes it
+    connect(&serialPort, &QIODevice::readyRead, this, &HeadlessRunner::onReadyRead);
+    connect(&serialPort, &QSerialPort::errorOccurred, this, &HeadlessRunner::onPortError);
+
+    reader.enable(true);
+    connect(&serialPort, &QIODevice::readyRead,
+            [this]()
+            {
+                bufferedBytes = serialPort.bytesAvailable();
+            });
+    reader.connectSink(&stream);
+    stream.connectFollower(this);
+
+    if (!rawFileName.isEmpty() && !rawRecorder.startRecording(rawFileName))
+    {
+        qCritical() << "Failed to start raw recording:" << rawFileName;
+        return false;
+    }
+
+    if (!csvFileName.isEmpty())
+    {
+        QStringList channelNames;
+        if (csvHeader)
+        {
+            channelNames = stream.infoModel()->channelNames();
+            if (stream.hasX()) channelNames.prepend("x");
+        }
+
+        if (!csvRecorder.startRecording(csvFileName, csvSeparator, channelNames, csvTimestamp))
+        {
+            qCritical() << "Failed to start CSV recording:" << csvFileName;
+            rawRecorder.stopRecording();
+            return false;
+        }
+        stream.connectFollower(&csvRecorder);
+    }
+
+    if (!serialPort.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Failed to open port" << serialPort.portName()
+                    << ":" << serialPort.errorString();
+        if (!csvFileName.isEmpty())
+        {
+            stream.disconnectFollower(&csvRecorder);
+            csvRecorder.stopRecording();
+        }
+        rawRecorder.stopRecording();
+        return false;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
+    if (!traceFileName.isEmpty()) Tracer::start();
+
+    running = true;
+    runTime.start();
+    pollTimer.start(POLL_INTERVAL);
+
+    QTextStream(stdout) << "Opened " << serialPort.portName()
+                        << " at " << serialPort.baudRate() << " baud" << Qt::endl;
+    return true;
+}
+
+void HeadlessRunner::stop(int exitCode)
+{
+    if (!running) return;
+    running = false;
+    pollTimer.stop();
+
+    if (serialPort.isOpen()) serialPort.close();
+
+    if (!csvFileName.isEmpty())
+    {
+        stream.disconnectFollower(&csvRecorder);
+        csvRecorder.stopRecording();
+    }
+    rawRecorder.stopRecording();
+
+    if (!traceFileName.isEmpty())
+    {
+        Tracer::stop();
+        if (!Tracer::save(traceFileName))
+        {
+            qCritical() << "Failed to save trace:" << traceFileName;
+        }
+    }
+
+    printStats(true);
+    QCoreApplication::exit(exitCode);
+}
+
+void HeadlessRunner::feedIn(const SamplePack& data)
+{
+    intervalSamples += data.numSamples();
+}
+
+void HeadlessRunner::onReadyRead()
+{
+    // bytes left in the buffer by the reader (a partial frame) are
+    // already recorded, only record the new ones
+    QByteArray data = serialPort.peek(serialPort.bytesAvailable()).mid(bufferedBytes);
+    intervalBytes += data.size();
+    if (rawRecorder.isRecording()) rawRecorder.onDataReceived(data);
+}
+
+void HeadlessRunner::onPortError(QSerialPort::SerialPortError error)
+{
+    // device is gone (unplugged for ex.)
+    if (error == QSerialPort::ResourceError && running)
+    {
+        qCritical() << "Port error:" << serialPort.errorString();
+        stop(1);
+    }
+}
+
+void HeadlessRunner::onPoll()
+{
+    if (stopRequested)
+    {
+        QTextStream(stdout) << "Stopping on signal" << Qt::endl;
+        stop();
+        return;
+    }
+
+    qint64 elapsed = runTime.elapsed();
+    if (statsInterval && elapsed - lastStatsTime >= statsInterval * 1000)
+    {
+        printStats();
+    }
+
+    if (duration && elapsed >= qint64(duration) * 1000)
+    {
+        stop();
+    }
+}
+
+void HeadlessRunner::printStats(bool final)
+{
+    qint64 elapsed = runTime.elapsed();
+    double interval = (elapsed - lastStatsTime) / 1000.;
+    lastStatsTime = elapsed;
+
+    totalBytes += intervalBytes;
+    totalSamples += intervalSamples;
+
+    QTextStream out(stdout);
+    if (final)
+    {
+        out << QString("Total: %1s, %2 bytes, %3 samples")
+            .arg(elapsed / 1000., 0, 'f', 1).arg(totalBytes).arg(totalSamples);
+    }
+    else if (interval > 0)
+    {
+        out << QString("%1s: %2 B/s, %3 sps, total %4 bytes, %5 samples")
+            .arg(elapsed / 1000., 0, 'f', 1)
+            .arg(intervalBytes / interval, 0, 'f', 0)
+            .arg(intervalSamples / interval, 0, 'f', 0)
+            .arg(totalBytes).arg(totalSamples);
+    }
+    out << Qt::endl;
+
+    intervalBytes = 0;
+    intervalSamples = 0;
+}
@@ -0,0 +1,115 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QSerialPort>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QString>
+
+#include "framedreader.h"
+#include "stream.h"
+#include "datarecorder.h"
+#include "rawdatarecorder.h"
+#include "sink.h"
+
+/**
+ * Acquires and records data without constructing any of the GUI.
+ *
+ * Port, reader, channel and record settings are loaded from a
+ * configuration file (as saved from the GUI). Parsed data is recorded
+ * as CSV and/or raw bytes are recorded as is. Throughput statistics are
+ * periodically printed to stdout. Runs until a duration limit is
+ * reached, SIGINT/SIGTERM is received or the port is lost.
+ */
+class HeadlessRunner : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit HeadlessRunner(QObject* parent = 0);
+    ~HeadlessRunner();
+
+    /// Returns true if headless mode is requested in command line arguments
+    static bool isRequested(int argc, char* argv[]);
+
+    /**
+     * Parses command line options and loads the configuration. Exits
+     * for `--help` and `--version`. Returns false on error.
+     */
+    bool setup(const QCoreApplication& app);
+
+    /// Opens the port and starts recording. Returns false on error.
+    bool start();
+
+public slots:
+    /// Stops recording, closes the port and exits the event loop
+    void stop(int exitCode = 0);
+
+protected:
+    /// Counts samples for statistics
+    void feedIn(const SamplePack& data) override;
+
+private:
+    // sinks are declared first, so that they outlive the reader
+    Stream stream;
+    DataRecorder csvRecorder;
+    RawDataRecorder rawRecorder;
+    QSerialPort serialPort;
+    FramedReader reader;
+
+    QString csvFileName;
+    QString rawFileName;
+    QString traceFileName;
+    QString csvSeparator;
+    DataRecorder::TimestampOption csvTimestamp;
+    bool csvHeader;
+
+    /// Run duration in seconds, 0 for no limit
+    unsigned duration;
+    /// Statistics interval in seconds, 0 to disable
+    unsigned statsInterval;
+
+    QTimer pollTimer;
+    QElapsedTimer runTime;
+    qint64 lastStatsTime;
+    quint64 totalBytes;
+    quint64 totalSamples;
+    quint64 intervalSamples;
+    quint64 intervalBytes;
+    /// Number of bytes left in port buffer after reader, already recorded
+    qint64 bufferedBytes;
+    bool running;
+
+    /// Loads port, reader, channel and record settings
+    void loadSettings(QSettings* settings);
+    /// Prints statistics line to stdout
+    void printStats(bool final = false);
+
+private slots:
+    void onReadyRead();
+    void onPortError(QSerialPort::SerialPortError error);
+    void onPoll();
+};
+
+#endif // HEADLESSRUNNER_H
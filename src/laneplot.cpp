@@ -0,0 +1,360 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <QPolygonF>
+#include <qwt_scale_engine.h>
+#include <math.h>
+#include <limits.h>
+#include <algorithm>
+
+#include "laneplot.h"
+#include "framebufferseries.h"
+
+static const int MIN_LANE_HEIGHT = 48;
+static const int LANE_MARGIN = 3;   ///< space between lane border and curves
+
+LanePlot::LanePlot(QWidget* parent) :
+    QAbstractScrollArea(parent)
+{
+    _xMin = 0;
+    _xMax = 1;
+    isAutoScaled = true;
+    yMin = 0;
+    yMax = 1;
+    gridShown = true;
+    darkShown = false;
+    demoShown = false;
+
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+
+    xScale = new QwtScaleWidget(QwtScaleDraw::BottomScale, this);
+    setXAxis(_xMin, _xMax);
+}
+
+void LanePlot::setCurves(const QList<QwtPlotCurve*>& curves)
+{
+    _curves = curves;
+    replot();
+}
+
+void LanePlot::setLanes(const QVector<QList<unsigned>>& lanes, const QStringList& names)
+{
+    _lanes = lanes;
+    laneNames = names;
+    replot();
+}
+
+void LanePlot::setXAxis(double xMin, double xMax)
+{
+    if (xMin == _xMin && xMax == _xMax && !xDiv.isEmpty()) return;
+
+    _xMin = xMin;
+    _xMax = xMax;
+
+    QwtLinearScaleEngine engine;
+    xDiv = engine.divideScale(xMin, xMax, 10, 5);
+    xScale->setScaleDiv(xDiv);
+    viewport()->update();
+}
+
+void LanePlot::setYAxis(bool autoScaled, double yAxisMin, double yAxisMax)
+{
+    isAutoScaled = autoScaled;
+    yMin = yAxisMin;
+    yMax = yAxisMax;
+    viewport()->update();
+}
+
+void LanePlot::showGrid(bool show)
+{
+    gridShown = show;
+    viewport()->update();
+}
+
+void LanePlot::darkBackground(bool enabled)
+{
+    darkShown = enabled;
+    viewport()->update();
+}
+
+void LanePlot::showDemoIndicator(bool show)
+{
+    demoShown = show;
+    viewport()->update();
+}
+
+void LanePlot::replot()
+{
+    updateLayout();
+    viewport()->update();
+}
+
+int LanePlot::laneHeight() const
+{
+    int numVisible = visibleLanes.size();
+    if (numVisible == 0) return viewport()->height();
+
+    // fill the view when all lanes fit, scroll otherwise
+    return std::max(MIN_LANE_HEIGHT, viewport()->height() / numVisible);
+}
+
+int LanePlot::contentHeight() const
+{
+    return visibleLanes.size() * laneHeight();
+}
+
+void LanePlot::updateLayout()
+{
+    visibleLanes.clear();
+    for (int li = 0; li < _lanes.size(); li++)
+    {
+        for (unsigned ci : _lanes[li])
+        {
+            if ((int) ci < _curves.size() && _curves[ci]->isVisible())
+            {
+                visibleLanes.append(li);
+                break;
+            }
+        }
+    }
+
+    int scaleHeight = xScale->sizeHint().height();
+    setViewportMargins(0, 0, 0, scaleHeight);
+    QRect vr = viewport()->geometry();
+    xScale->setGeometry(vr.left(), vr.bottom() + 1, vr.width(), scaleHeight);
+
+    auto bar = verticalScrollBar();
+    bar->setRange(0, std::max(0, contentHeight() - viewport()->height()));
+    bar->setPageStep(viewport()->height());
+    bar->setSingleStep(laneHeight());
+}
+
+void LanePlot::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateLayout();
+}
+
+void LanePlot::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    viewport()->update();
+}
+
+void LanePlot::paintEvent(QPaintEvent* event)
+{
+    // lanes always span the full width, only vertical extent is limited
+    QPainter painter(viewport());
+    QRect rect(0, event->rect().top(), viewport()->width(), event->rect().height());
+    drawContents(&painter, verticalScrollBar()->value(), rect);
+
+    QColor textColor = darkShown ? Qt::white : Qt::black;
+    if (visibleLanes.isEmpty())
+    {
+        painter.setPen(textColor);
+        painter.drawText(viewport()->rect(), Qt::AlignCenter, tr("No Visible Channels"));
+    }
+
+    if (demoShown)
+    {
+        QString text(" DEMO RUNNING ");  // looks better with spaces
+        QRect textRect = painter.fontMetrics().boundingRect(text);
+        textRect.moveBottomLeft(viewport()->rect().bottomLeft() + QPoint(4, -4));
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::darkRed);
+        painter.drawRoundedRect(textRect, 4, 4);
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignCenter, text);
+    }
+}
+
+void LanePlot::drawContents(QPainter* painter, int offset, const QRect& rect) const
+{
+    painter->fillRect(rect, darkShown ? Qt::black : Qt::white);
+
+    const int lh = laneHeight();
+    if (visibleLanes.isEmpty() || lh <= 0) return;
+
+    // only the lanes that intersect with `rect` are drawn
+    int first = std::max(0, (offset + rect.top()) / lh);
+    int last = std::min((int) visibleLanes.size() - 1, (offset + rect.bottom()) / lh);
+    for (int i = first; i <= last; i++)
+    {
+        QRect laneRect(rect.left(), i * lh - offset, rect.width(), lh);
+        drawLane(painter, visibleLanes[i], laneRect);
+    }
+}
+
+void LanePlot::drawLane(QPainter* painter, int lane, const QRect& rect) const
+{
+    QColor textColor = darkShown ? Qt::white : Qt::black;
+    QColor gridColor;
+    gridColor.setHsvF(0, 0, darkShown ? 0.30 : 0.75);
+
+    // curves are aligned with the X scale
+    QRectF plotRect = QRectF(rect).adjusted(xScale->startBorderDist(), LANE_MARGIN,
+                                            -xScale->endBorderDist(), -LANE_MARGIN);
+    if (plotRect.width() <= 0 || plotRect.height() <= 0 || _xMax == _xMin) return;
+
+    // separator and grid
+    painter->setPen(gridColor);
+    painter->drawLine(rect.bottomLeft(), rect.bottomRight());
+    if (gridShown)
+    {
+        const double xs = plotRect.width() / (_xMax - _xMin);
+        for (double tick : xDiv.ticks(QwtScaleDiv::MajorTick))
+        {
+            double px = plotRect.left() + (tick - _xMin) * xs;
+            painter->drawLine(QPointF(px, rect.top()), QPointF(px, rect.bottom()));
+        }
+        double cy = plotRect.center().y();
+        painter->drawLine(QPointF(plotRect.left(), cy), QPointF(plotRect.right(), cy));
+    }
+
+    // Y range of the lane
+    double y0 = yMin, y1 = yMax;
+    if (isAutoScaled)
+    {
+        bool found = false;
+        for (unsigned ci : _lanes[lane])
+        {
+            if ((int) ci >= _curves.size() || !_curves[ci]->isVisible()) continue;
+
+            auto series = static_cast<const FrameBufferSeries*>(_curves[ci]->data());
+            auto lim = series->yBuffer()->limits();
+            y0 = found ? std::min(y0, lim.start) : lim.start;
+            y1 = found ? std::max(y1, lim.end) : lim.end;
+            found = true;
+        }
+    }
+    if (y1 <= y0)
+    {
+        y0 -= 0.5;
+        y1 += 0.5;
+    }
+
+    painter->save();
+    painter->setClipRect(rect);
+    for (unsigned ci : _lanes[lane])
+    {
+        if ((int) ci >= _curves.size() || !_curves[ci]->isVisible()) continue;
+        drawCurve(painter, _curves[ci], plotRect, y0, y1);
+    }
+    painter->restore();
+
+    // lane title followed by channel names in their colors
+    QFont font = painter->font();
+    font.setPointSizeF(font.pointSizeF() * 0.85);
+    painter->setFont(font);
+    const int lineHeight = painter->fontMetrics().height();
+    QPointF textPos(rect.left() + 4, rect.top() + 2 + painter->fontMetrics().ascent());
+    if (lane < laneNames.size() && !laneNames[lane].isEmpty())
+    {
+        painter->setPen(textColor);
+        painter->drawText(textPos, laneNames[lane]);
+        textPos.rx() += painter->fontMetrics().horizontalAdvance(laneNames[lane] + "  ");
+    }
+    for (unsigned ci : _lanes[lane])
+    {
+        if ((int) ci >= _curves.size() || !_curves[ci]->isVisible()) continue;
+
+        QString title = _curves[ci]->title().text();
+        painter->setPen(_curves[ci]->pen().color());
+        painter->drawText(textPos, title);
+        textPos.rx() += painter->fontMetrics().horizontalAdvance(title + "  ");
+    }
+
+    // Y range labels
+    painter->setPen(textColor);
+    QRect labelRect = rect.adjusted(0, 2, -4, -2);
+    painter->drawText(labelRect, Qt::AlignRight | Qt::AlignTop, QString::number(y1, 'g', 4));
+    if (rect.height() > 2 * lineHeight)
+    {
+        painter->drawText(labelRect, Qt::AlignRight | Qt::AlignBottom, QString::number(y0, 'g', 4));
+    }
+}
+
+void LanePlot::drawCurve(QPainter* painter, const QwtPlotCurve* curve,
+                         const QRectF& rect, double y0, double y1) const
+{
+    auto series = static_cast<const FrameBufferSeries*>(curve->data());
+    auto xBuf = series->xBuffer();
+    auto yBuf = series->yBuffer();
+    const unsigned n = std::min(xBuf->size(), yBuf->size());
+    if (n == 0) return;
+
+    const double xs = rect.width() / (_xMax - _xMin);
+    const double ys = rect.height() / (y1 - y0);
+
+    // reduce samples falling on the same pixel column to
+    // first/min/max/last, shape of the curve is preserved
+    QPolygonF points;
+    points.reserve(std::min<unsigned>(n, rect.width() * 4 + 8));
+    int column = INT_MIN;
+    unsigned count = 0;
+    double first = 0, minY = 0, maxY = 0, last = 0, firstX = 0;
+    auto flush = [&]()
+    {
+        if (count == 1)
+        {
+            points.append(QPointF(firstX, first));
+        }
+        else if (count > 1)
+        {
+            points.append(QPointF(column, first));
+            points.append(QPointF(column, minY));
+            points.append(QPointF(column, maxY));
+            points.append(QPointF(column, last));
+        }
+    };
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        double px = rect.left() + (xBuf->sample(i) - _xMin) * xs;
+        if (px < rect.left() - 1 || px > rect.right() + 1) continue;
+
+        double py = rect.bottom() - (yBuf->sample(i) - y0) * ys;
+        int c = floor(px);
+        if (c != column)
+        {
+            flush();
+            column = c;
+            count = 0;
+            first = minY = maxY = py;
+            firstX = px;
+        }
+        else
+        {
+            minY = std::min(minY, py);
+            maxY = std::max(maxY, py);
+        }
+        last = py;
+        count++;
+    }
+    flush();
+
+    QPen pen = curve->pen();
+    painter->setPen(pen);
+    painter->drawPolyline(points);
+}
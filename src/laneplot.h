@@ -0,0 +1,114 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LANEPLOT_H
+#define LANEPLOT_H
+
+#include <QAbstractScrollArea>
+#include <QList>
+#include <QVector>
+#include <QStringList>
+#include <QColor>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_widget.h>
+#include <qwt_scale_div.h>
+
+/**
+ * A lightweight alternative to a stack of `Plot` widgets for displaying
+ * many plots at once.
+ *
+ * All lanes are drawn on a single scrollable canvas and share a single
+ * X axis. Lanes are plain data, creating hundreds of them costs
+ * nothing. Only the lanes in view are painted and long curves are
+ * reduced to first/min/max/last points per pixel column.
+ *
+ * Curves are owned by `PlotManager`, their title, pen, visibility and
+ * data (`FrameBufferSeries`) are read at paint time. Zooming, symbols
+ * and legend options of `Plot` aren't supported.
+ */
+class LanePlot : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit LanePlot(QWidget* parent = 0);
+
+    /// Sets displayed curves, data of curves must be `FrameBufferSeries`
+    void setCurves(const QList<QwtPlotCurve*>& curves);
+    /**
+     * Sets grouping of curves into lanes.
+     *
+     * @param lanes curve indexes for each lane
+     * @param names lane names, can be empty
+     */
+    void setLanes(const QVector<QList<unsigned>>& lanes, const QStringList& names);
+
+    /// Height of all lanes, used for exporting
+    int contentHeight() const;
+    /**
+     * Draws lanes that intersect with `rect`.
+     *
+     * @param offset vertical position of `painter` origin in contents
+     * @param rect area to draw in painter coordinates, lanes span its
+     * whole width
+     */
+    void drawContents(QPainter* painter, int offset, const QRect& rect) const;
+
+public slots:
+    void setXAxis(double xMin, double xMax);
+    void setYAxis(bool autoScaled, double yMin = 0, double yMax = 1);
+    void showGrid(bool show = true);
+    void darkBackground(bool enabled = true);
+    void showDemoIndicator(bool show = true);
+    /// Updates lane visibility and repaints lanes in view
+    void replot();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    QList<QwtPlotCurve*> _curves;
+    QVector<QList<unsigned>> _lanes;
+    QStringList laneNames;
+    QVector<int> visibleLanes; ///< lanes with at least one visible curve
+
+    double _xMin, _xMax;
+    bool isAutoScaled;
+    double yMin, yMax;
+    bool gridShown;
+    bool darkShown;
+    bool demoShown;
+
+    QwtScaleWidget* xScale;
+    QwtScaleDiv xDiv;
+
+    /// Height of a single lane
+    int laneHeight() const;
+    /// Updates visible lanes, scroll range and scale position
+    void updateLayout();
+    /// Draws a single lane to given rectangle
+    void drawLane(QPainter* painter, int lane, const QRect& rect) const;
+    /// Draws a curve reduced to pixel resolution
+    void drawCurve(QPainter* painter, const QwtPlotCurve* curve,
+                   const QRectF& rect, double y0, double y1) const;
+};
+
+#endif // LANEPLOT_H
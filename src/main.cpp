@@ -23,6 +23,7 @@
 #include <iostream>
 
 #include "mainwindow.h"
+#include "headlessrunner.h"
 #include "tooltipfilter.h"
 #include "version.h"
 
@@ -70,10 +71,27 @@ void messageHandler(QtMsgType type, const QMessageLogContext &context,
 
 int main(int argc, char *argv[])
 {
+    bool headless = HeadlessRunner::isRequested(argc, argv);
+
+    // readers still create their settings widgets, they are never shown
+    if (headless && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication a(argc, argv);
     QApplication::setApplicationName(PROGRAM_NAME);
     QApplication::setApplicationVersion(VERSION_STRING);
 
+    if (headless)
+    {
+        qInstallMessageHandler(messageHandler);
+
+        HeadlessRunner runner;
+        if (!runner.setup(a) || !runner.start()) return 1;
+        return a.exec();
+    }
+
 #ifdef Q_OS_WIN
     QIcon::setFallbackSearchPaths(QIcon::fallbackSearchPaths() << ":icons");
     QIcon::setThemeName("tango");
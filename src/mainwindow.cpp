@@ -40,6 +40,8 @@
 
 #include <plot.h>
 #include <barplot.h>
+#include "spectrumplot.h"
+#include "tracer.h"
 
 #include "framebufferseries.h"
 #include "defines.h"
@@ -59,7 +61,13 @@ const QMap<int, QString> panelSettingMap({
         {3, "Commands"},
         {4, "Record"},
         {5, "TextView"},
-        {6, "Log"}
+        {6, "Trigger"},
+        {7, "MultiPort"},
+        {8, "Replay"},
+        {9, "Source"},
+        {10, "Metrics"},
+        {11, "Statistics"},
+        {12, "Log"}
     });
 
 MainWindow::MainWindow(QWidget *parent) :
@@ -72,10 +80,16 @@ MainWindow::MainWindow(QWidget *parent) :
     commandPanel(&serialPort),
     dataFormatPanel(&serialPort),
     recordPanel(&stream),
+    triggerPanel(&stream),
+    portSessionsPanel(&merger),
+    replayPanel(&replayDevice),
+    sourcePanel(&dataSource),
+    statsPanel(&stream),
     textView(&stream),
     updateCheckDialog(this),
     bpsLabel(&portControl, &dataFormatPanel, this),
-    activeRawRecorder(nullptr)
+    activeRawRecorder(nullptr),
+    inputDevice(nullptr)
 {
     ui->setupUi(this);
 
@@ -94,6 +108,12 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->tabWidget->insertTab(3, &commandPanel, "Commands");
     ui->tabWidget->insertTab(4, &recordPanel, "Record");
     ui->tabWidget->insertTab(5, &textView, "Text View");
+    ui->tabWidget->insertTab(6, &triggerPanel, "Trigger");
+    ui->tabWidget->insertTab(7, &portSessionsPanel, "Multi-Port");
+    ui->tabWidget->insertTab(8, &replayPanel, "Replay");
+    ui->tabWidget->insertTab(9, &sourcePanel, "Source");
+    ui->tabWidget->insertTab(10, &metricsPanel, "Metrics");
+    ui->tabWidget->insertTab(11, &statsPanel, "Statistics");
     ui->tabWidget->setCurrentIndex(0);
     auto tbPortControl = portControl.toolBar();
     addToolBar(tbPortControl);
@@ -131,6 +151,8 @@ MainWindow::MainWindow(QWidget *parent) :
     // Secondary plot menu signals
     connect(ui->actionBarPlot, &QAction::triggered,
             this, &MainWindow::showBarPlot);
+    connect(ui->actionSpectrum, &QAction::triggered,
+            this, &MainWindow::showSpectrum);
 
     connect(ui->actionVertical, &QAction::triggered,
             [this](bool checked)
@@ -167,6 +189,9 @@ MainWindow::MainWindow(QWidget *parent) :
     QObject::connect(ui->actionLoadSettings, &QAction::triggered,
                      this, &MainWindow::onLoadSettings);
 
+    QObject::connect(ui->actionTrace, &QAction::toggled,
+                     this, &MainWindow::onTraceToggled);
+
     ui->actionQuit->setShortcutContext(Qt::ApplicationShortcut);
 
     QObject::connect(ui->actionQuit, &QAction::triggered,
@@ -201,6 +226,9 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(&plotControlPanel, &PlotControlPanel::configureMappingRequested,
             plotMan, &PlotManager::showChannelMappingDialog);
 
+    connect(plotMan, &PlotManager::visibleXRangeChanged,
+            &statsPanel, &StatsPanel::setVisibleRange);
+
     // plot toolbar signals
     QObject::connect(ui->actionClear, SIGNAL(triggered(bool)),
                      this, SLOT(clearPlot()));
@@ -275,26 +303,31 @@ MainWindow::MainWindow(QWidget *parent) :
                      plotMan, &PlotManager::showDemoIndicator);
 
     // init stream connections
+    mainInput = merger.addInput();
+    merger.connectSink(&stream);
     connect(&dataFormatPanel, &DataFormatPanel::sourceChanged,
             this, &MainWindow::onSourceChanged);
     onSourceChanged(dataFormatPanel.activeSource());
 
+    // replay a capture or read a non-serial source instead of the serial port
+    connect(&replayPanel, &ReplayPanel::inputEnabledChanged,
+            [this](bool enabled)
+            {
+                if (!enabled) replayDevice.pause();
+                updateInputDevice();
+            });
+    connect(&dataSource, &DataSource::opened, this, &MainWindow::updateInputDevice);
+    connect(&dataSource, &DataSource::closed, this, &MainWindow::updateInputDevice);
+
 
+    // raw data view and recorder are connected to the selected input
+    updateInputDevice();
 
-    // Connect to serial port for raw data handling
-    connect(&serialPort, &QIODevice::readyRead, [this]() {
-        if (serialPort.isOpen()) {
-            // Peek at data without consuming it for raw data display and recording
-            QByteArray data = serialPort.peek(serialPort.bytesAvailable());
-            if (!data.isEmpty()) {
-                commandPanel.getRawDataView()->addReceivedData(data);
-                // Also send to raw data recorder if recording
-                if (activeRawRecorder && activeRawRecorder->isRecording()) {
-                    activeRawRecorder->onDataReceived(data);
-                }
-            }
-        }
-    });
+    // nothing reads the serial port while another input is selected
+    connect(&serialPort, &QIODevice::readyRead, [this]()
+            {
+                if (inputDevice != &serialPort) serialPort.readAll();
+            });
 
     // Connect raw recording signals from record panel
     connect(&recordPanel, &RecordPanel::rawRecordingStarted,
@@ -333,6 +366,13 @@ MainWindow::MainWindow(QWidget *parent) :
 
 MainWindow::~MainWindow()
 {
+    // save trace requested from command line
+    if (Tracer::enabled() && !traceFileName.isEmpty())
+    {
+        Tracer::stop();
+        Tracer::save(traceFileName);
+    }
+
     if (serialPort.isOpen())
     {
         serialPort.close();
@@ -425,7 +465,7 @@ void MainWindow::onPortToggled(bool open)
 
 void MainWindow::onSourceChanged(Source* source)
 {
-    source->connectSink(&stream);
+    source->connectSink(mainInput);
     source->connectSink(&sampleCounter);
 }
 
@@ -450,6 +490,47 @@ void MainWindow::onSpsChanged(float sps)
     spsLabel.setText(QString::number(sps, 'f', precision) + "sps");
 }
 
+void MainWindow::updateInputDevice()
+{
+    QIODevice* device;
+    if (replayPanel.isInputEnabled())
+    {
+        device = &replayDevice;
+    }
+    else if (dataSource.isOpen())
+    {
+        device = dataSource.device();
+    }
+    else
+    {
+        device = &serialPort;
+    }
+
+    if (device == inputDevice) return;
+    inputDevice = device;
+
+    // raw data is peeked, so it should be connected before the reader
+    disconnect(rawDataConnection);
+    rawDataConnection = connect(device, &QIODevice::readyRead,
+                                this, &MainWindow::onRawDataReady);
+    dataFormatPanel.setDevice(device);
+}
+
+void MainWindow::onRawDataReady()
+{
+    if (!inputDevice->isOpen()) return;
+
+    // peek at data without consuming it, reader reads it afterwards
+    QByteArray data = inputDevice->peek(inputDevice->bytesAvailable());
+    if (data.isEmpty()) return;
+
+    commandPanel.getRawDataView()->addReceivedData(data);
+    if (activeRawRecorder && activeRawRecorder->isRecording())
+    {
+        activeRawRecorder->onDataReceived(data);
+    }
+}
+
 bool MainWindow::isDemoRunning()
 {
     return ui->actionDemoMode->isChecked();
@@ -509,6 +590,7 @@ void MainWindow::showBarPlot(bool show)
                        plotControlPanel.yMax());
         connect(&plotControlPanel, &PlotControlPanel::yScaleChanged,
                 plot, &BarPlot::setYAxis);
+        ui->actionSpectrum->setChecked(false);
         showSecondary(plot);
     }
     else
@@ -517,6 +599,19 @@ void MainWindow::showBarPlot(bool show)
     }
 }
 
+void MainWindow::showSpectrum(bool show)
+{
+    if (show)
+    {
+        ui->actionBarPlot->setChecked(false);
+        showSecondary(new SpectrumPlot(&stream, &plotMenu));
+    }
+    else
+    {
+        hideSecondary();
+    }
+}
+
 void MainWindow::onExportCsv()
 {
     bool wasPaused = ui->actionPause->isChecked();
@@ -579,6 +674,10 @@ void MainWindow::saveAllSettings(QSettings* settings)
     dataFormatPanel.saveSettings(settings);
     stream.saveSettings(settings);
     plotControlPanel.saveSettings(settings);
+    triggerPanel.saveSettings(settings);
+    portSessionsPanel.saveSettings(settings);
+    replayPanel.saveSettings(settings);
+    sourcePanel.saveSettings(settings);
     plotMenu.saveSettings(settings);
     commandPanel.saveSettings(settings);
     recordPanel.saveSettings(settings);
@@ -594,6 +693,10 @@ void MainWindow::loadAllSettings(QSettings* settings)
     dataFormatPanel.loadSettings(settings);
     stream.loadSettings(settings);
     plotControlPanel.loadSettings(settings);
+    triggerPanel.loadSettings(settings);
+    portSessionsPanel.loadSettings(settings);
+    replayPanel.loadSettings(settings);
+    sourcePanel.loadSettings(settings);
     plotMenu.loadSettings(settings);
     commandPanel.loadSettings(settings);
     recordPanel.loadSettings(settings);
@@ -679,6 +782,35 @@ void MainWindow::onLoadSettings()
     }
 }
 
+void MainWindow::onTraceToggled(bool enabled)
+{
+    if (enabled)
+    {
+        Tracer::start();
+        ui->statusBar->showMessage(tr("Recording trace..."), 5000);
+        return;
+    }
+
+    Tracer::stop();
+
+    QString fileName = traceFileName;
+    if (fileName.isEmpty())
+    {
+        fileName = QFileDialog::getSaveFileName(
+            this, tr("Save Trace"), QString(), tr("Trace Event JSON (*.json)"));
+        if (fileName.isNull()) return; // user canceled
+    }
+
+    if (Tracer::save(fileName))
+    {
+        ui->statusBar->showMessage(tr("Trace is saved to %1").arg(fileName), 5000);
+    }
+    else
+    {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to save trace to %1").arg(fileName));
+    }
+}
+
 void MainWindow::handleCommandLineOptions(const QCoreApplication &app)
 {
     QCommandLineParser parser;
@@ -691,11 +823,17 @@ void MainWindow::handleCommandLineOptions(const QCoreApplication &app)
     QCommandLineOption portOpt({"p", "port"}, "Set port name.", "port name");
     QCommandLineOption baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate");
     QCommandLineOption openPortOpt({"o", "open"}, "Open serial port.");
+    QCommandLineOption traceOpt("trace", "Record a trace and save it to file at exit.", "filename");
+    QCommandLineOption headlessOpt("headless",
+                                   "Run without GUI, only acquire and record data. "
+                                   "See --headless --help for options.");
 
     parser.addOption(configOpt);
     parser.addOption(portOpt);
     parser.addOption(baudrateOpt);
     parser.addOption(openPortOpt);
+    parser.addOption(traceOpt);
+    parser.addOption(headlessOpt);
 
     parser.process(app);
 
@@ -730,4 +868,10 @@ void MainWindow::handleCommandLineOptions(const QCoreApplication &app)
     {
         portControl.openPort();
     }
+
+    if (parser.isSet(traceOpt))
+    {
+        traceFileName = parser.value(traceOpt);
+        ui->actionTrace->setChecked(true);
+    }
 }
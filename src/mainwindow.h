@@ -39,6 +39,15 @@
 #include "dataformatpanel.h"
 #include "recordpanel.h"
 #include "plotcontrolpanel.h"
+#include "triggerpanel.h"
+#include "portsessionspanel.h"
+#include "replaypanel.h"
+#include "replaydevice.h"
+#include "sourcepanel.h"
+#include "datasource.h"
+#include "metricspanel.h"
+#include "statspanel.h"
+#include "streammerger.h"
 #include "ui_about_dialog.h"
 #include "stream.h"
 #include "snapshotmanager.h"
@@ -73,6 +82,10 @@ private:
     void setupAboutDialog();
 
     QSerialPort serialPort;
+    /// Replays raw captures in place of `serialPort`
+    ReplayDevice replayDevice;
+    /// Network, local socket or pipe source in place of `serialPort`
+    DataSource dataSource;
     PortControl portControl;
 
     unsigned int numOfSamples;
@@ -80,6 +93,9 @@ private:
     QList<QwtPlotCurve*> curves;
     // ChannelManager channelMan;
     Stream stream;
+    /// Merges main port with additional port sessions into `stream`
+    StreamMerger merger;
+    Sink* mainInput;
     PlotManager* plotMan;
     QWidget* secondaryPlot;
     SnapshotManager snapshotMan;
@@ -90,6 +106,12 @@ private:
     DataFormatPanel dataFormatPanel;
     RecordPanel recordPanel;
     PlotControlPanel plotControlPanel;
+    TriggerPanel triggerPanel;
+    PortSessionsPanel portSessionsPanel;
+    ReplayPanel replayPanel;
+    SourcePanel sourcePanel;
+    MetricsPanel metricsPanel;
+    StatsPanel statsPanel;
     PlotMenu plotMenu;
     DataTextView textView;
     UpdateCheckDialog updateCheckDialog;
@@ -97,9 +119,20 @@ private:
 
     // Raw data recorder pointer for active recording
     RawDataRecorder* activeRawRecorder;
+    /// Input selected by `updateInputDevice()`
+    QIODevice* inputDevice;
+    /// Connects `inputDevice` to raw data view and recorder
+    QMetaObject::Connection rawDataConnection;
+
+    /// Trace file given from command line, if empty user is asked
+    QString traceFileName;
 
     void handleCommandLineOptions(const QCoreApplication &app);
 
+    /// Selects the device readers read from: replay, data source or
+    /// serial port. Raw data view and recorder follow the same device.
+    void updateInputDevice();
+
     /// Returns true if demo is running
     bool isDemoRunning();
     /// Display a secondary plot in the splitter, removing and
@@ -128,11 +161,15 @@ private slots:
     void onSpsChanged(float sps);
     void enableDemo(bool enabled);
     void showBarPlot(bool show);
+    void showSpectrum(bool show);
 
     void onExportCsv();
     void onExportSvg();
     void onSaveSettings();
     void onLoadSettings();
+    void onTraceToggled(bool enabled);
+    /// Passes unread data of `inputDevice` to raw data view and recorder
+    void onRawDataReady();
 };
 
 #endif // MAINWINDOW_H
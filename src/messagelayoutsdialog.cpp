@@ -0,0 +1,176 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QDialogButtonBox>
+#include <QMessageBox>
+#include <QSpinBox>
+#include <algorithm>
+#include <set>
+
+#include "defines.h"
+#include "messagelayoutsdialog.h"
+#include "channelmappingdialog.h"
+
+enum Column {ColId, ColChannels, ColMapping, NumColumns};
+
+MessageLayoutsDialog::MessageLayoutsDialog(std::vector<MessageLayout>& layouts,
+                                           unsigned totalFrameSize, unsigned maxId,
+                                           QWidget* parent) :
+    QDialog(parent),
+    _layouts(layouts),
+    editLayouts(layouts),
+    pbAdd(tr("Add")),
+    pbRemove(tr("Remove"))
+{
+    _totalFrameSize = totalFrameSize;
+    _maxId = maxId;
+
+    setWindowTitle(tr("Message Layouts"));
+
+    table.setColumnCount(NumColumns);
+    table.setHorizontalHeaderLabels({tr("Message ID"), tr("Channels"), tr("Mapping")});
+    table.horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table.verticalHeader()->setVisible(false);
+    table.setSelectionBehavior(QAbstractItemView::SelectRows);
+    table.setSelectionMode(QAbstractItemView::SingleSelection);
+
+    table.setRowCount(editLayouts.size());
+    for (unsigned i = 0; i < editLayouts.size(); i++)
+    {
+        setupRow(i);
+    }
+
+    auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+
+    auto buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(&pbAdd);
+    buttonLayout->addWidget(&pbRemove);
+    buttonLayout->addStretch();
+
+    auto layout = new QVBoxLayout(this);
+    layout->addWidget(&table);
+    layout->addLayout(buttonLayout);
+    layout->addWidget(buttonBox);
+
+    connect(&pbAdd, &QPushButton::clicked, this, &MessageLayoutsDialog::onAdd);
+    connect(&pbRemove, &QPushButton::clicked, this, &MessageLayoutsDialog::onRemove);
+    connect(buttonBox, &QDialogButtonBox::accepted, this, &MessageLayoutsDialog::onAccepted);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    resize(420, 300);
+}
+
+void MessageLayoutsDialog::setupRow(int row)
+{
+    MessageLayout& layout = editLayouts[row];
+
+    auto spId = new QSpinBox();
+    spId->setDisplayIntegerBase(16);
+    spId->setPrefix("0x");
+    spId->setRange(0, _maxId);
+    spId->setValue(layout.id);
+    connect(spId, &QSpinBox::valueChanged,
+            [this, row](int value) { editLayouts[row].id = value; });
+    table.setCellWidget(row, ColId, spId);
+
+    auto spChannels = new QSpinBox();
+    spChannels->setRange(1, MAX_NUM_CHANNELS);
+    spChannels->setValue(layout.mapping.numChannels());
+    connect(spChannels, &QSpinBox::valueChanged,
+            [this, row](int value) { editLayouts[row].mapping.setNumChannels(value); });
+    table.setCellWidget(row, ColChannels, spChannels);
+
+    auto pbMapping = new QPushButton(tr("Configure..."));
+    connect(pbMapping, &QPushButton::clicked,
+            [this, row]()
+            {
+                ChannelMappingDialog dialog(editLayouts[row].mapping, this);
+                dialog.setTotalFrameSize(_totalFrameSize);
+                dialog.exec();
+            });
+    table.setCellWidget(row, ColMapping, pbMapping);
+}
+
+void MessageLayoutsDialog::onAdd()
+{
+    // next unused ID
+    unsigned id = 0;
+    for (auto& l : editLayouts) id = std::max(id, l.id + 1);
+
+    MessageLayout layout;
+    layout.id = std::min(id, _maxId);
+    layout.mapping.setNumChannels(1);
+    editLayouts.push_back(layout);
+
+    table.setRowCount(editLayouts.size());
+    setupRow(editLayouts.size() - 1);
+}
+
+void MessageLayoutsDialog::onRemove()
+{
+    int row = table.currentRow();
+    if (row < 0 || row >= (int) editLayouts.size()) return;
+
+    editLayouts.erase(editLayouts.begin() + row);
+
+    // row widgets refer to layouts by index, re-create them
+    table.setRowCount(0);
+    table.setRowCount(editLayouts.size());
+    for (unsigned i = 0; i < editLayouts.size(); i++)
+    {
+        setupRow(i);
+    }
+}
+
+void MessageLayoutsDialog::onAccepted()
+{
+    if (editLayouts.empty())
+    {
+        QMessageBox::warning(this, tr("Invalid Layouts"),
+                             tr("At least one message layout is required!"));
+        return;
+    }
+
+    unsigned numChannels = 0;
+    std::set<unsigned> ids;
+    for (auto& l : editLayouts)
+    {
+        if (!ids.insert(l.id).second)
+        {
+            QMessageBox::warning(this, tr("Invalid Layouts"),
+                                 tr("Message ID 0x%1 is used more than once!").arg(l.id, 0, 16));
+            return;
+        }
+        numChannels += l.mapping.numChannels();
+    }
+
+    if (numChannels > MAX_NUM_CHANNELS)
+    {
+        QMessageBox::warning(this, tr("Invalid Layouts"),
+                             tr("Total number of channels can't be more than %1!").arg(MAX_NUM_CHANNELS));
+        return;
+    }
+
+    _layouts = editLayouts;
+    accept();
+}
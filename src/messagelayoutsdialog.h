@@ -0,0 +1,68 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MESSAGELAYOUTSDIALOG_H
+#define MESSAGELAYOUTSDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QPushButton>
+#include <vector>
+
+#include "channelmapping.h"
+
+/**
+ * Edits the list of message layouts. Each layout has a message ID and
+ * its own channel mapping. Changes are written back only when
+ * accepted.
+ */
+class MessageLayoutsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param layouts layouts to edit
+     * @param totalFrameSize maximum frame size excluding checkCode
+     * @param maxId largest ID that fits in the message ID field
+     */
+    MessageLayoutsDialog(std::vector<MessageLayout>& layouts,
+                         unsigned totalFrameSize, unsigned maxId,
+                         QWidget* parent = nullptr);
+
+private:
+    std::vector<MessageLayout>& _layouts;
+    std::vector<MessageLayout> editLayouts; ///< working copy
+    unsigned _totalFrameSize;
+    unsigned _maxId;
+    QTableWidget table;
+    QPushButton pbAdd;
+    QPushButton pbRemove;
+
+    /// Creates row widgets of the layout
+    void setupRow(int row);
+
+private slots:
+    void onAdd();
+    void onRemove();
+    void onAccepted();
+};
+
+#endif // MESSAGELAYOUTSDIALOG_H
@@ -0,0 +1,216 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QDateTime>
+#include <QStringList>
+#include <QtAlgorithms>
+
+#include "metrics.h"
+
+void MetricGauge::set(qint64 value)
+{
+    _value.storeRelaxed(value);
+
+    qint64 m = _max.loadRelaxed();
+    while (value > m && !_max.testAndSetRelaxed(m, value, m));
+}
+
+void MetricGauge::reset()
+{
+    _value.storeRelaxed(0);
+    _max.storeRelaxed(0);
+}
+
+MetricHistogram::MetricHistogram() :
+    _count(0), _sum(0), _max(0)
+{
+    for (auto& b : buckets) b.storeRelaxed(0);
+}
+
+void MetricHistogram::record(qint64 ns)
+{
+    if (ns < 0) ns = 0;
+
+    int i = 64 - qCountLeadingZeroBits(quint64(ns));
+    buckets[qMin(i, int(NumBuckets) - 1)].fetchAndAddRelaxed(1);
+    _count.fetchAndAddRelaxed(1);
+    _sum.fetchAndAddRelaxed(ns);
+
+    qint64 m = _max.loadRelaxed();
+    while (ns > m && !_max.testAndSetRelaxed(m, ns, m));
+}
+
+double MetricHistogram::mean() const
+{
+    quint64 n = count();
+    return n ? double(_sum.loadRelaxed()) / n : 0.;
+}
+
+qint64 MetricHistogram::percentile(double p) const
+{
+    quint64 n = count();
+    if (n == 0) return 0;
+
+    quint64 target = qMax(quint64(1), quint64(n * p / 100. + 0.5));
+    quint64 total = 0;
+    for (int i = 0; i < NumBuckets; i++)
+    {
+        total += buckets[i].loadRelaxed();
+        if (total >= target)
+        {
+            // upper bound of the bucket, but never more than max
+            return qMin(i ? (qint64(1) << i) - 1 : qint64(0), max());
+        }
+    }
+    return max();
+}
+
+void MetricHistogram::reset()
+{
+    for (auto& b : buckets) b.storeRelaxed(0);
+    _count.storeRelaxed(0);
+    _sum.storeRelaxed(0);
+    _max.storeRelaxed(0);
+}
+
+Metrics& Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+template <typename T>
+static T& findOrCreate(std::map<QString, std::unique_ptr<T>>& map, const QString& name)
+{
+    auto& m = map[name];
+    if (!m) m.reset(new T());
+    return *m;
+}
+
+MetricCounter& Metrics::counter(const QString& name)
+{
+    QMutexLocker locker(&lock);
+    return findOrCreate(counters, name);
+}
+
+MetricGauge& Metrics::gauge(const QString& name)
+{
+    QMutexLocker locker(&lock);
+    return findOrCreate(gauges, name);
+}
+
+MetricHistogram& Metrics::histogram(const QString& name)
+{
+    QMutexLocker locker(&lock);
+    return findOrCreate(histograms, name);
+}
+
+QList<Metrics::Value> Metrics::values() const
+{
+    QMutexLocker locker(&lock);
+    std::map<QString, Value> sorted;
+
+    for (auto& c : counters)
+    {
+        sorted[c.first] = {c.first, Counter, c.second->value(), 0, 0, 0, 0, 0};
+    }
+    for (auto& g : gauges)
+    {
+        sorted[g.first] = {g.first, Gauge, quint64(g.second->value()),
+                           0, 0, 0, 0, g.second->max()};
+    }
+    for (auto& h : histograms)
+    {
+        auto& hist = *h.second;
+        sorted[h.first] = {h.first, Histogram, 0, hist.count(), hist.mean(),
+                           hist.percentile(50), hist.percentile(99), hist.max()};
+    }
+
+    QList<Value> result;
+    for (auto& v : sorted) result.append(v.second);
+    return result;
+}
+
+void Metrics::reset()
+{
+    QMutexLocker locker(&lock);
+    for (auto& c : counters) c.second->reset();
+    for (auto& g : gauges) g.second->reset();
+    for (auto& h : histograms) h.second->reset();
+}
+
+QString Metrics::typeName(Type type)
+{
+    switch (type)
+    {
+        case Counter: return "counter";
+        case Gauge: return "gauge";
+        case Histogram: return "histogram";
+    }
+    return QString();
+}
+
+QJsonObject Metrics::toJson() const
+{
+    QJsonObject metrics;
+    for (auto& v : values())
+    {
+        QJsonObject obj;
+        obj["type"] = typeName(v.type);
+        switch (v.type)
+        {
+            case Counter:
+                obj["value"] = double(v.value);
+                break;
+            case Gauge:
+                obj["value"] = double(qint64(v.value));
+                obj["max"] = double(v.max);
+                break;
+            case Histogram:
+                obj["count"] = double(v.count);
+                obj["mean_ns"] = v.mean;
+                obj["p50_ns"] = double(v.p50);
+                obj["p99_ns"] = double(v.p99);
+                obj["max_ns"] = double(v.max);
+                break;
+        }
+        metrics[v.name] = obj;
+    }
+
+    QJsonObject root;
+    root["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    root["metrics"] = metrics;
+    return root;
+}
+
+QString Metrics::toCsv() const
+{
+    QStringList lines;
+    lines << "name,type,value,count,mean_ns,p50_ns,p99_ns,max";
+    for (auto& v : values())
+    {
+        QString value = v.type == Gauge ? QString::number(qint64(v.value)) :
+                                          QString::number(v.value);
+        lines << QString("%1,%2,%3,%4,%5,%6,%7,%8")
+            .arg(v.name, typeName(v.type), value)
+            .arg(v.count).arg(v.mean, 0, 'f', 0)
+            .arg(v.p50).arg(v.p99).arg(v.max);
+    }
+    return lines.join("\n") + "\n";
+}
@@ -0,0 +1,166 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <map>
+#include <memory>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+
+/// A monotonically increasing counter, safe to update from any thread.
+class MetricCounter
+{
+public:
+    MetricCounter() : _value(0) {}
+
+    void add(quint64 n = 1) {_value.fetchAndAddRelaxed(n);}
+    quint64 value() const {return _value.loadRelaxed();}
+    void reset() {_value.storeRelaxed(0);}
+
+private:
+    QAtomicInteger<quint64> _value;
+};
+
+/// Current value and high water mark of a level, a queue depth for ex.
+class MetricGauge
+{
+public:
+    MetricGauge() : _value(0), _max(0) {}
+
+    void set(qint64 value);
+    qint64 value() const {return _value.loadRelaxed();}
+    qint64 max() const {return _max.loadRelaxed();}
+    void reset();
+
+private:
+    QAtomicInteger<qint64> _value;
+    QAtomicInteger<qint64> _max;
+};
+
+/**
+ * Histogram of durations in nanoseconds. Buckets are powers of 2, so
+ * recording is a few atomic increments and percentiles are accurate
+ * to a factor of 2.
+ */
+class MetricHistogram
+{
+public:
+    /// Bucket `i` holds values in range [2^(i-1), 2^i)
+    enum {NumBuckets = 48};
+
+    MetricHistogram();
+
+    void record(qint64 ns);
+
+    quint64 count() const {return _count.loadRelaxed();}
+    /// Mean of recorded values, 0 if empty
+    double mean() const;
+    qint64 max() const {return _max.loadRelaxed();}
+    /**
+     * Returns an upper bound for the `p` percentile (0-100) of the
+     * recorded values, 0 if empty.
+     */
+    qint64 percentile(double p) const;
+    void reset();
+
+private:
+    QAtomicInteger<quint64> buckets[NumBuckets];
+    QAtomicInteger<quint64> _count;
+    QAtomicInteger<quint64> _sum;
+    QAtomicInteger<qint64> _max;
+};
+
+/// Measures the lifetime of a scope and records it to a histogram
+class MetricTimer
+{
+public:
+    explicit MetricTimer(MetricHistogram& histogram) : _histogram(histogram)
+    {
+        timer.start();
+    }
+    ~MetricTimer()
+    {
+        _histogram.record(timer.nsecsElapsed());
+    }
+
+private:
+    MetricHistogram& _histogram;
+    QElapsedTimer timer;
+};
+
+/**
+ * Registry of application wide performance metrics.
+ *
+ * Metrics are created on first request by name and live until the
+ * application exits. Looking up by name locks, so references should be
+ * obtained once and kept. Updating metrics doesn't lock.
+ */
+class Metrics
+{
+public:
+    static Metrics& instance();
+
+    MetricCounter& counter(const QString& name);
+    MetricGauge& gauge(const QString& name);
+    MetricHistogram& histogram(const QString& name);
+
+    enum Type {Counter, Gauge, Histogram};
+
+    /// A metric snapshot, histogram values are in nanoseconds
+    struct Value
+    {
+        QString name;
+        Type type;
+        quint64 value;  ///< counter value or gauge value
+        quint64 count;  ///< number of recorded values
+        double mean;
+        qint64 p50;
+        qint64 p99;
+        qint64 max;     ///< gauge or histogram max
+    };
+
+    /// Returns a snapshot of all metrics, ordered by name
+    QList<Value> values() const;
+    /// Resets all metrics
+    void reset();
+
+    /// Returns snapshot as a JSON object
+    QJsonObject toJson() const;
+    /// Returns snapshot as CSV text with a header line
+    QString toCsv() const;
+
+    /// Returns display name of a type
+    static QString typeName(Type type);
+
+private:
+    Metrics() {}
+
+    mutable QMutex lock;
+    std::map<QString, std::unique_ptr<MetricCounter>> counters;
+    std::map<QString, std::unique_ptr<MetricGauge>> gauges;
+    std::map<QString, std::unique_ptr<MetricHistogram>> histograms;
+};
+
+#endif // METRICS_H
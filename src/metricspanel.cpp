@@ -0,0 +1,164 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonDocument>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+#include "metricspanel.h"
+#include "metrics.h"
+
+/// Table update interval in milliseconds
+#define UPDATE_INTERVAL 500
+
+enum Column {ColName, ColValue, ColCount, ColMean, ColP50, ColP99, ColMax, NumColumns};
+
+/// Formats a duration in nanoseconds for display
+static QString formatDuration(double ns)
+{
+    if (ns < 1e3) return QString("%1 ns").arg(ns, 0, 'f', 0);
+    if (ns < 1e6) return QString("%1 µs").arg(ns / 1e3, 0, 'f', 1);
+    if (ns < 1e9) return QString("%1 ms").arg(ns / 1e6, 0, 'f', 1);
+    return QString("%1 s").arg(ns / 1e9, 0, 'f', 2);
+}
+
+MetricsPanel::MetricsPanel(QWidget* parent) :
+    QWidget(parent)
+{
+    table.setColumnCount(NumColumns);
+    table.setHorizontalHeaderLabels(
+        {tr("Metric"), tr("Value"), tr("Count"), tr("Mean"), tr("p50"), tr("p99"), tr("Max")});
+    table.verticalHeader()->hide();
+    table.horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table.horizontalHeader()->setStretchLastSection(true);
+    table.setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table.setSelectionMode(QAbstractItemView::NoSelection);
+
+    pbReset.setText(tr("Reset"));
+    pbExportCsv.setText(tr("Export CSV..."));
+    pbExportJson.setText(tr("Export JSON..."));
+
+    auto buttons = new QVBoxLayout();
+    buttons->addWidget(&pbReset);
+    buttons->addWidget(&pbExportCsv);
+    buttons->addWidget(&pbExportJson);
+    buttons->addStretch();
+
+    auto layout = new QHBoxLayout(this);
+    layout->addWidget(&table, 1);
+    layout->addLayout(buttons);
+
+    connect(&updateTimer, &QTimer::timeout, this, &MetricsPanel::updateTable);
+    connect(&pbReset, &QPushButton::clicked, this, &MetricsPanel::onReset);
+    connect(&pbExportCsv, &QPushButton::clicked, [this]()
+            {
+                exportData(tr("CSV Files (*.csv)"), "csv",
+                           Metrics::instance().toCsv().toUtf8());
+            });
+    connect(&pbExportJson, &QPushButton::clicked, [this]()
+            {
+                exportData(tr("JSON Files (*.json)"), "json",
+                           QJsonDocument(Metrics::instance().toJson()).toJson());
+            });
+}
+
+void MetricsPanel::showEvent(QShowEvent* event)
+{
+    // only update while visible, to not cost anything otherwise
+    updateTable();
+    updateTimer.start(UPDATE_INTERVAL);
+    QWidget::showEvent(event);
+}
+
+void MetricsPanel::hideEvent(QHideEvent* event)
+{
+    updateTimer.stop();
+    QWidget::hideEvent(event);
+}
+
+void MetricsPanel::updateTable()
+{
+    auto values = Metrics::instance().values();
+    table.setRowCount(values.size());
+
+    for (int row = 0; row < values.size(); row++)
+    {
+        auto& v = values[row];
+        QString cells[NumColumns];
+        cells[ColName] = v.name;
+
+        switch (v.type)
+        {
+            case Metrics::Counter:
+                cells[ColValue] = QString::number(v.value);
+                break;
+            case Metrics::Gauge:
+                cells[ColValue] = QString::number(qint64(v.value));
+                cells[ColMax] = QString::number(v.max);
+                break;
+            case Metrics::Histogram:
+                cells[ColCount] = QString::number(v.count);
+                if (v.count)
+                {
+                    cells[ColMean] = formatDuration(v.mean);
+                    cells[ColP50] = formatDuration(v.p50);
+                    cells[ColP99] = formatDuration(v.p99);
+                    cells[ColMax] = formatDuration(v.max);
+                }
+                break;
+        }
+
+        for (int col = 0; col < NumColumns; col++)
+        {
+            auto item = table.item(row, col);
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                if (col != ColName) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                table.setItem(row, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
+}
+
+void MetricsPanel::onReset()
+{
+    Metrics::instance().reset();
+    updateTable();
+}
+
+void MetricsPanel::exportData(QString filter, QString suffix, QByteArray data)
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export Metrics"), QString(), filter);
+    if (fileName.isEmpty()) return;
+    if (QFileInfo(fileName).suffix().isEmpty()) fileName += "." + suffix;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+    {
+        QMessageBox::critical(this, tr("Error"),
+                              tr("Failed to export metrics: %1").arg(file.errorString()));
+    }
+}
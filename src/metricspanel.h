@@ -0,0 +1,58 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef METRICSPANEL_H
+#define METRICSPANEL_H
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QTimer>
+
+/**
+ * Shows performance metrics of the application (see `Metrics`) and
+ * exports them as CSV or JSON.
+ */
+class MetricsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsPanel(QWidget* parent = 0);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    QTableWidget table;
+    QPushButton pbReset;
+    QPushButton pbExportCsv;
+    QPushButton pbExportJson;
+    QTimer updateTimer;
+
+    /// Writes `data` to a file selected by user
+    void exportData(QString filter, QString suffix, QByteArray data);
+
+private slots:
+    void updateTable();
+    void onReset();
+};
+
+#endif // METRICSPANEL_H
@@ -0,0 +1,447 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtGlobal>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#include "multiringbuffer.h"
+
+/// Copying is split over threads only for large packs of many channels
+static const unsigned PARALLEL_MIN_CHANNELS = 64;
+static const unsigned PARALLEL_MIN_SAMPLES = 256 * 1024; ///< total of all channels
+/// Number of samples per statistics block
+static const unsigned BLOCK_SIZE = 256;
+/// Number of blocks per super block
+static const unsigned SUPER_BLOCKS = 64;
+static const unsigned SUPER_SIZE = BLOCK_SIZE * SUPER_BLOCKS;
+
+double MultiRingBuffer::Stats::variance() const
+{
+    return count ? m2 / count : 0;
+}
+
+double MultiRingBuffer::Stats::stdDev() const
+{
+    return std::sqrt(variance());
+}
+
+double MultiRingBuffer::Stats::rms() const
+{
+    return std::sqrt(mean * mean + variance());
+}
+
+double MultiRingBuffer::Stats::peakToPeak() const
+{
+    return max - min;
+}
+
+void MultiRingBuffer::Stats::merge(const Stats& other)
+{
+    if (other.count == 0) return;
+    if (count == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    // parallel variance algorithm of Chan et al.
+    double n = double(count) + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / n;
+    m2 += other.m2 + delta * delta * (double(count) * other.count / n);
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+MultiRingBuffer::Stats MultiRingBuffer::Stats::of(const double* data, unsigned n)
+{
+    Stats s;
+    if (n == 0) return s;
+
+    // independent accumulators so that loops can be vectorized
+    double sum[4] = {0, 0, 0, 0};
+    double mn[4] = {data[0], data[0], data[0], data[0]};
+    double mx[4] = {data[0], data[0], data[0], data[0]};
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        for (unsigned k = 0; k < 4; k++)
+        {
+            sum[k] += data[i+k];
+            mn[k] = std::min(mn[k], data[i+k]);
+            mx[k] = std::max(mx[k], data[i+k]);
+        }
+    }
+    for (; i < n; i++)
+    {
+        sum[0] += data[i];
+        mn[0] = std::min(mn[0], data[i]);
+        mx[0] = std::max(mx[0], data[i]);
+    }
+
+    s.count = n;
+    s.mean = (sum[0] + sum[1] + sum[2] + sum[3]) / n;
+    s.min = std::min(std::min(mn[0], mn[1]), std::min(mn[2], mn[3]));
+    s.max = std::max(std::max(mx[0], mx[1]), std::max(mx[2], mx[3]));
+
+    // second pass around the mean is exact, data is in cache already
+    double m2[4] = {0, 0, 0, 0};
+    for (i = 0; i + 4 <= n; i += 4)
+    {
+        for (unsigned k = 0; k < 4; k++)
+        {
+            double d = data[i+k] - s.mean;
+            m2[k] += d * d;
+        }
+    }
+    for (; i < n; i++)
+    {
+        double d = data[i] - s.mean;
+        m2[0] += d * d;
+    }
+    s.m2 = m2[0] + m2[1] + m2[2] + m2[3];
+
+    return s;
+}
+
+MultiRingBuffer::Channel::Channel(const MultiRingBuffer* buffer, unsigned index)
+{
+    _buffer = buffer;
+    _index = index;
+}
+
+unsigned MultiRingBuffer::Channel::size() const
+{
+    return _buffer->size();
+}
+
+double MultiRingBuffer::Channel::sample(unsigned i) const
+{
+    return _buffer->sample(_index, i);
+}
+
+Range MultiRingBuffer::Channel::limits() const
+{
+    return _buffer->limits(_index);
+}
+
+Range MultiRingBuffer::Channel::limits(unsigned start, unsigned end) const
+{
+    auto s = _buffer->stats(_index, start, end);
+    return {s.min, s.max};
+}
+
+double MultiRingBuffer::Channel::mean(unsigned start, unsigned end) const
+{
+    return _buffer->stats(_index, start, end).mean;
+}
+
+MultiRingBuffer::MultiRingBuffer(unsigned nc, unsigned n)
+{
+    _numChannels = nc;
+    _size = n;
+    data = new double[size_t(nc) * n]();
+    headIndex = 0;
+
+    resetBlocks();
+}
+
+MultiRingBuffer::~MultiRingBuffer()
+{
+    delete[] data;
+}
+
+unsigned MultiRingBuffer::numChannels() const
+{
+    return _numChannels;
+}
+
+unsigned MultiRingBuffer::size() const
+{
+    return _size;
+}
+
+double MultiRingBuffer::sample(unsigned channel, unsigned i) const
+{
+    Q_ASSERT(channel < _numChannels && i < _size);
+
+    unsigned index = headIndex + i;
+    if (index >= _size) index -= _size;
+    return data[size_t(channel) * _size + index];
+}
+
+Range MultiRingBuffer::limits(unsigned channel) const
+{
+    auto s = stats(channel);
+    return {s.min, s.max};
+}
+
+MultiRingBuffer::Stats MultiRingBuffer::stats(unsigned channel) const
+{
+    return storageStats(channel, 0, _size);
+}
+
+MultiRingBuffer::Stats MultiRingBuffer::stats(unsigned channel, unsigned start, unsigned end) const
+{
+    Q_ASSERT(start <= end && end <= _size);
+
+    if (start >= end) return Stats();
+
+    // logical range is at most 2 ranges in storage
+    unsigned pStart = (headIndex + start) % _size;
+    unsigned n = end - start;
+    if (pStart + n <= _size)
+    {
+        return storageStats(channel, pStart, pStart + n);
+    }
+    else
+    {
+        auto s = storageStats(channel, pStart, _size);
+        s.merge(storageStats(channel, 0, n - (_size - pStart)));
+        return s;
+    }
+}
+
+MultiRingBuffer::Stats MultiRingBuffer::storageStats(unsigned channel, unsigned start, unsigned end) const
+{
+    Q_ASSERT(channel < _numChannels);
+
+    const double* block = data + size_t(channel) * _size;
+    Stats s;
+    unsigned i = start;
+    while (i < end)
+    {
+        unsigned sb = i / SUPER_SIZE;
+        unsigned sbStart = sb * SUPER_SIZE;
+        unsigned sbEnd = std::min(sbStart + SUPER_SIZE, _size);
+        unsigned b = i / BLOCK_SIZE;
+        unsigned bStart = b * BLOCK_SIZE;
+        unsigned bEnd = std::min(bStart + BLOCK_SIZE, _size);
+
+        if (i == sbStart && sbEnd <= end)
+        {
+            s.merge(superStat(channel, sb));
+            i = sbEnd;
+        }
+        else if (i == bStart && bEnd <= end)
+        {
+            s.merge(blockStat(channel, b));
+            i = bEnd;
+        }
+        else
+        {
+            // partial block at the edges of range
+            unsigned pEnd = std::min(bEnd, end);
+            s.merge(Stats::of(block + i, pEnd - i));
+            i = pEnd;
+        }
+    }
+    return s;
+}
+
+const MultiRingBuffer::Stats& MultiRingBuffer::blockStat(unsigned channel, unsigned block) const
+{
+    size_t bi = size_t(channel) * numBlocks + block;
+    if (blockDirty[bi])
+    {
+        unsigned bStart = block * BLOCK_SIZE;
+        unsigned bEnd = std::min(bStart + BLOCK_SIZE, _size);
+        blockStats[bi] = Stats::of(data + size_t(channel) * _size + bStart, bEnd - bStart);
+        blockDirty[bi] = false;
+    }
+    return blockStats[bi];
+}
+
+const MultiRingBuffer::Stats& MultiRingBuffer::superStat(unsigned channel, unsigned super) const
+{
+    size_t si = size_t(channel) * numSupers + super;
+    if (superDirty[si])
+    {
+        Stats s;
+        unsigned bEnd = std::min((super + 1) * SUPER_BLOCKS, numBlocks);
+        for (unsigned b = super * SUPER_BLOCKS; b < bEnd; b++)
+        {
+            s.merge(blockStat(channel, b));
+        }
+        superStats[si] = s;
+        superDirty[si] = false;
+    }
+    return superStats[si];
+}
+
+void MultiRingBuffer::resetBlocks()
+{
+    numBlocks = (_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blockStats.assign(size_t(_numChannels) * numBlocks, Stats());
+    blockDirty.assign(size_t(_numChannels) * numBlocks, true);
+    numSupers = (numBlocks + SUPER_BLOCKS - 1) / SUPER_BLOCKS;
+    superStats.assign(size_t(_numChannels) * numSupers, Stats());
+    superDirty.assign(size_t(_numChannels) * numSupers, true);
+}
+
+void MultiRingBuffer::markDirty(unsigned channel, unsigned start, unsigned end)
+{
+    if (start >= end) return;
+
+    char* dirty = blockDirty.data() + size_t(channel) * numBlocks;
+    for (unsigned b = start / BLOCK_SIZE; b <= (end - 1) / BLOCK_SIZE; b++)
+    {
+        dirty[b] = true;
+    }
+    dirty = superDirty.data() + size_t(channel) * numSupers;
+    for (unsigned sb = start / SUPER_SIZE; sb <= (end - 1) / SUPER_SIZE; sb++)
+    {
+        dirty[sb] = true;
+    }
+}
+
+MultiRingBuffer::Channel* MultiRingBuffer::channel(unsigned index) const
+{
+    Q_ASSERT(index < _numChannels);
+    return new Channel(this, index);
+}
+
+void MultiRingBuffer::setNumChannels(unsigned nc)
+{
+    if (nc == _numChannels) return;
+
+    // blocks keep their layout since head is shared, no need to unwrap
+    double* newData = new double[size_t(nc) * _size];
+    size_t kept = size_t(std::min(nc, _numChannels)) * _size;
+    memcpy(newData, data, sizeof(double) * kept);
+    memset(newData + kept, 0, sizeof(double) * (size_t(nc) * _size - kept));
+
+    delete[] data;
+    data = newData;
+    _numChannels = nc;
+
+    resetBlocks();
+}
+
+void MultiRingBuffer::resize(unsigned n)
+{
+    if (n == _size) return;
+
+    realloc(_numChannels, n);
+    resetBlocks();
+}
+
+void MultiRingBuffer::realloc(unsigned nc, unsigned n)
+{
+    double* newData = new double[size_t(nc) * n];
+
+    // newest `kept` samples are moved to the end of the new block,
+    // beginning is filled with zeros when growing
+    unsigned kept = std::min(n, _size);
+    unsigned offset = n - kept;
+    unsigned start = (headIndex + _size - kept) % std::max(_size, 1u);
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        const double* src = data + size_t(ci) * _size;
+        double* dst = newData + size_t(ci) * n;
+
+        memset(dst, 0, sizeof(double) * offset);
+        unsigned firstLen = std::min(kept, _size - start);
+        memcpy(dst + offset, src + start, sizeof(double) * firstLen);
+        memcpy(dst + offset + firstLen, src, sizeof(double) * (kept - firstLen));
+    }
+
+    delete[] data;
+    data = newData;
+    _size = n;
+    headIndex = 0;
+}
+
+void MultiRingBuffer::addSamples(const SamplePack& pack)
+{
+    Q_ASSERT(pack.numChannels() == _numChannels);
+
+    const unsigned n = pack.numSamples();
+    if (n == 0 || _size == 0) return;
+
+    // all channels share the head, so wrapping is calculated only once
+    unsigned skip = 0;          // samples of pack that don't fit
+    unsigned count = n;
+    unsigned head = headIndex;
+    if (n >= _size)
+    {
+        skip = n - _size;
+        count = _size;
+        head = 0;
+    }
+    const unsigned firstLen = std::min(count, _size - head); // until the end
+    const unsigned secondLen = count - firstLen;             // from the beginning
+
+    auto copy = [this, &pack, skip, head, firstLen, secondLen](unsigned from, unsigned to)
+    {
+        for (unsigned ci = from; ci < to; ci++)
+        {
+            const double* src = pack.data(ci) + skip;
+            double* dst = data + size_t(ci) * _size;
+            memcpy(dst + head, src, sizeof(double) * firstLen);
+            memcpy(dst, src + firstLen, sizeof(double) * secondLen);
+            markDirty(ci, head, head + firstLen);
+            markDirty(ci, 0, secondLen);
+        }
+    };
+
+    unsigned numThreads = QThreadPool::globalInstance()->maxThreadCount();
+    if (_numChannels >= PARALLEL_MIN_CHANNELS &&
+        size_t(_numChannels) * count >= PARALLEL_MIN_SAMPLES && numThreads > 1)
+    {
+        // this thread takes the first slice, others go to the pool
+        unsigned slice = (_numChannels + numThreads - 1) / numThreads;
+        QSemaphore done;
+        unsigned numJobs = 0;
+        for (unsigned from = slice; from < _numChannels; from += slice)
+        {
+            unsigned to = std::min(from + slice, _numChannels);
+            auto job = [&copy, &done, from, to]()
+            {
+                copy(from, to);
+                done.release();
+            };
+            // pool might be busy with other work, don't wait for it
+            if (!QThreadPool::globalInstance()->tryStart(job)) job();
+            numJobs++;
+        }
+        copy(0, std::min(slice, _numChannels));
+        done.acquire(numJobs);
+    }
+    else
+    {
+        copy(0, _numChannels);
+    }
+
+    headIndex = (head + count) % _size;
+}
+
+void MultiRingBuffer::clear()
+{
+    memset(data, 0, sizeof(double) * size_t(_numChannels) * _size);
+    headIndex = 0;
+
+    resetBlocks();
+}
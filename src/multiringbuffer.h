@@ -0,0 +1,142 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MULTIRINGBUFFER_H
+#define MULTIRINGBUFFER_H
+
+#include <vector>
+
+#include "framebuffer.h"
+#include "samplepack.h"
+
+/**
+ * Ring buffer storing all channels of a stream in a single allocation.
+ *
+ * Channels are stored in consecutive blocks (channel major) and share a
+ * single head index, so a whole `SamplePack` is added with one wrap
+ * calculation and a couple of `memcpy` per channel. At high channel
+ * counts copying is split over the global thread pool.
+ *
+ * Channels are accessed as `FrameBuffer` via `channel()` views.
+ *
+ * Statistics (and limits) are kept for fixed size blocks of storage
+ * and for groups of blocks (super blocks). Only the blocks that are
+ * written are re-calculated, lazily on next query. A range query
+ * merges super block and block summaries and only scans the partial
+ * blocks at the edges of the range, so it is fast even for very large
+ * buffers.
+ * Since a block is always re-calculated from its samples there is no
+ * drift as with running sums.
+ */
+class MultiRingBuffer
+{
+public:
+    /// Read only view of a single channel
+    class Channel : public FrameBuffer
+    {
+    public:
+        Channel(const MultiRingBuffer* buffer, unsigned index);
+
+        unsigned size() const override;
+        double sample(unsigned i) const override;
+        Range limits() const override;
+        Range limits(unsigned start, unsigned end) const override;
+        double mean(unsigned start, unsigned end) const override;
+
+    private:
+        const MultiRingBuffer* _buffer;
+        unsigned _index;
+    };
+
+    /// Statistics of a range of samples
+    struct Stats
+    {
+        unsigned count = 0;
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        double m2 = 0;          ///< sum of squared differences from mean
+
+        double variance() const;
+        double stdDev() const;
+        double rms() const;
+        double peakToPeak() const;
+        /// Merges statistics of another (disjoint) range
+        void merge(const Stats& other);
+        /// Calculates statistics of an array
+        static Stats of(const double* data, unsigned n);
+    };
+
+    MultiRingBuffer(unsigned nc, unsigned n);
+    ~MultiRingBuffer();
+
+    unsigned numChannels() const;
+    unsigned size() const;
+    double sample(unsigned channel, unsigned i) const;
+    Range limits(unsigned channel) const;
+    /// Statistics of all samples of a channel
+    Stats stats(unsigned channel) const;
+    /// Statistics of samples of a channel in [start, end)
+    Stats stats(unsigned channel, unsigned start, unsigned end) const;
+
+    /**
+     * Creates a view of a channel. Caller takes the ownership, view
+     * must not be used after the buffer is deleted or the channel is
+     * removed.
+     */
+    Channel* channel(unsigned index) const;
+
+    /// Adds or removes channels at the end, new channels are filled with 0
+    void setNumChannels(unsigned nc);
+    /// Resizes all channels, keeps newest samples
+    void resize(unsigned n);
+    /// Adds Y data of all channels of the pack
+    void addSamples(const SamplePack& pack);
+    /// Fills all channels with 0
+    void clear();
+
+private:
+    unsigned _numChannels;
+    unsigned _size;            ///< size of each channel
+    double* data;              ///< `_numChannels` blocks of `_size`
+    unsigned headIndex;        ///< actual `0` index of all channels
+
+    unsigned numBlocks;
+    unsigned numSupers;
+    mutable std::vector<Stats> blockStats;  ///< `numBlocks` per channel
+    mutable std::vector<char> blockDirty;   ///< `numBlocks` per channel
+    mutable std::vector<Stats> superStats;  ///< `numSupers` per channel
+    mutable std::vector<char> superDirty;   ///< `numSupers` per channel
+
+    /// Resets block bookkeeping, all blocks are marked dirty
+    void resetBlocks();
+    /// Marks blocks of storage range [start, end) as dirty for a channel
+    void markDirty(unsigned channel, unsigned start, unsigned end);
+    /// Statistics of a block, updated if dirty
+    const Stats& blockStat(unsigned channel, unsigned block) const;
+    /// Statistics of a super block, updated if dirty
+    const Stats& superStat(unsigned channel, unsigned super) const;
+    /// Statistics of storage range [start, end) of a channel (not wrapped)
+    Stats storageStats(unsigned channel, unsigned start, unsigned end) const;
+
+    /// Moves data to a new allocation with given size, unwraps the ring
+    void realloc(unsigned nc, unsigned n);
+};
+
+#endif // MULTIRINGBUFFER_H
@@ -0,0 +1,188 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdint.h>
+#include <limits.h>
+#include <QByteArray>
+
+#include "numberparser.h"
+
+/// Exactly representable powers of 10 as double
+static const double POWERS_OF_10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Largest exponent that can be applied without rounding errors
+static const int MAX_EXACT_EXPONENT = 22;
+/// Mantissa must be exactly representable as a double
+static const uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+/// Maximum number of significant digits that fits into 64 bits
+static const int MAX_MANTISSA_DIGITS = 19;
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/// Fallback for numbers that can't be parsed with the fast path
+static bool parseDecimalSlow(const char* begin, const char* end, double* value)
+{
+    auto bytes = QByteArray::fromRawData(begin, end - begin);
+    bool ok;
+    *value = bytes.toDouble(&ok);
+    if (!ok)
+    {
+        // try integer with base prefix, ex: "0x1F"
+        *value = bytes.toLongLong(&ok, 0);
+    }
+    return ok;
+}
+
+bool parseDecimal(const char* begin, const char* end, double* value)
+{
+    const char* p = begin;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int numDigits = 0;          // significant digits in mantissa
+    int exponent = 0;
+    bool anyDigit = false;
+
+    // integer part
+    for (; p < end && isDigit(*p); p++)
+    {
+        anyDigit = true;
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa) numDigits++;
+    }
+
+    // fractional part
+    if (p < end && *p == '.')
+    {
+        p++;
+        for (; p < end && isDigit(*p); p++)
+        {
+            anyDigit = true;
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) numDigits++;
+            exponent--;
+        }
+    }
+
+    // exponent
+    if (anyDigit && p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool expNegative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            expNegative = (*p == '-');
+            p++;
+        }
+        if (p == end || !isDigit(*p))
+        {
+            return false;
+        }
+        int e = 0;
+        for (; p < end && isDigit(*p); p++)
+        {
+            if (e < 10000) e = e * 10 + (*p - '0');
+        }
+        exponent += expNegative ? -e : e;
+    }
+
+    if (!anyDigit || p != end || numDigits > MAX_MANTISSA_DIGITS ||
+        mantissa > MAX_EXACT_MANTISSA ||
+        exponent < -MAX_EXACT_EXPONENT || exponent > MAX_EXACT_EXPONENT)
+    {
+        return parseDecimalSlow(begin, end, value);
+    }
+
+    // both mantissa and power of 10 are exact, so is the result
+    double v = double(mantissa);
+    if (exponent < 0)
+    {
+        v /= POWERS_OF_10[-exponent];
+    }
+    else
+    {
+        v *= POWERS_OF_10[exponent];
+    }
+    *value = negative ? -v : v;
+    return true;
+}
+
+bool parseHex(const char* begin, const char* end, double* value)
+{
+    const char* p = begin;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    {
+        p += 2;
+    }
+
+    if (p == end) return false;
+
+    uint64_t v = 0;
+    for (; p < end; p++)
+    {
+        char c = *p;
+        unsigned d;
+        if (isDigit(c))
+        {
+            d = c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            d = c - 'a' + 10;
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            d = c - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+
+        v = (v << 4) | d;
+        if (v > uint64_t(INT_MAX) + 1) return false;
+    }
+
+    if (!negative && v > uint64_t(INT_MAX)) return false;
+
+    *value = negative ? -double(v) : double(v);
+    return true;
+}
@@ -0,0 +1,44 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef NUMBERPARSER_H
+#define NUMBERPARSER_H
+
+/**
+ * Parses a decimal number from `[begin, end)` without any allocation.
+ *
+ * Common input (up to 19 significant digits with a small exponent) is
+ * converted exactly with a few integer operations. Anything else
+ * (`inf`, `nan`, long mantissas, `0x` prefixed integers etc.) falls back
+ * to Qt's parser. Whole range must be a number, no whitespace allowed.
+ *
+ * @return `false` if range is not a valid number
+ */
+bool parseDecimal(const char* begin, const char* end, double* value);
+
+/**
+ * Parses a hexadecimal integer (with optional sign and `0x` prefix)
+ * from `[begin, end)`. Value must fit into a 32 bits signed integer.
+ *
+ * @return `false` if range is not a valid number
+ */
+bool parseHex(const char* begin, const char* end, double* value);
+
+#endif // NUMBERPARSER_H
@@ -23,7 +23,9 @@
 #include <qwt_symbol.h>
 #include <qwt_plot_curve.h>
 #include <qwt_scale_map.h>
+#include <QPainter>
 #include <math.h>
+#include <string.h>
 #include <algorithm>
 
 #include "plot.h"
@@ -41,8 +43,19 @@ Plot::Plot(QWidget* parent) :
     numOfSamples = 1;
     plotWidth = 1;
     showSymbols = Plot::ShowSymbolsAuto;
+    renderMode = Plot::RenderDirect;
+    inCanvasPaint = false;
+    dataPosition = 0;
+    layerPosition = 0;
+    pendingShift = 0;
+    renderPosition = 0;
+    numMeasureCursors = 0;
+
+    connect(&renderer, &PlotRenderer::finished, this, &Plot::onRenderFinished);
 
     QObject::connect(&zoomer, &Zoomer::unzoomed, this, &Plot::unzoomed);
+    connect(&zoomer, &Zoomer::measureCursorPlaced, this, &Plot::onMeasureCursorPlaced);
+    connect(&zoomer, &Zoomer::measureCursorsCleared, this, &Plot::clearMeasureCursors);
 
     zoomer.setZoomBase();
     grid.attach(this);
@@ -84,6 +97,19 @@ Plot::Plot(QWidget* parent) :
     noChannelIndicator.setText(noChannelText);
     noChannelIndicator.hide();
     noChannelIndicator.attach(this);
+
+    // init measurement cursors
+    const char* cursorNames[2] = {"A", "B"};
+    for (unsigned i = 0; i < 2; i++)
+    {
+        measureCursors[i].setLineStyle(QwtPlotMarker::VLine);
+        measureCursors[i].setLabel(QwtText(cursorNames[i]));
+        measureCursors[i].setLabelAlignment(Qt::AlignRight | Qt::AlignTop);
+        measureCursors[i].hide();
+        measureCursors[i].attach(this);
+    }
+    measureLabel.hide();
+    measureLabel.attach(this);
 }
 
 Plot::~Plot()
@@ -93,9 +119,83 @@ Plot::~Plot()
 
 void Plot::setDispChannels(QVector<const StreamChannel*> channels)
 {
+    dispChannels = channels;
     zoomer.setDispChannels(channels);
 }
 
+void Plot::replot()
+{
+    if (numMeasureCursors) updateMeasurement();
+    QwtPlot::replot();
+}
+
+void Plot::onMeasureCursorPlaced(double x)
+{
+    // cursors are placed alternately, starting over after the second one
+    if (numMeasureCursors == 2)
+    {
+        numMeasureCursors = 0;
+        measureCursors[1].hide();
+    }
+
+    measureCursors[numMeasureCursors].setXValue(x);
+    measureCursors[numMeasureCursors].show();
+    numMeasureCursors++;
+    replot();
+}
+
+void Plot::clearMeasureCursors()
+{
+    numMeasureCursors = 0;
+    measureCursors[0].hide();
+    measureCursors[1].hide();
+    measureLabel.hide();
+    replot();
+}
+
+void Plot::updateMeasurement()
+{
+    QString text;
+    if (numMeasureCursors == 1)
+    {
+        text = QString("A: %1").arg(measureCursors[0].xValue());
+    }
+    else
+    {
+        double xa = measureCursors[0].xValue();
+        double xb = measureCursors[1].xValue();
+        text = QString("ΔX: %1").arg(xb - xa);
+
+        for (auto ch : dispChannels)
+        {
+            if (!ch->visible()) continue;
+
+            unsigned start, end;
+            ch->xData()->findRange(std::min(xa, xb), std::max(xa, xb), &start, &end);
+            text += QString("<br><font color=\"%1\">%2</font>: ΔY: %3")
+                .arg(ch->color().name()).arg(ch->name().toHtmlEscaped())
+                .arg(ch->findValue(xb) - ch->findValue(xa));
+            if (start < end)
+            {
+                auto lim = ch->yData()->limits(start, end);
+                text += QString(" Min: %1 Max: %2 Mean: %3")
+                    .arg(lim.start).arg(lim.end)
+                    .arg(ch->yData()->mean(start, end));
+            }
+        }
+    }
+
+    QwtText label(text, QwtText::RichText);
+    label.setRenderFlags(Qt::AlignLeft | Qt::AlignTop);
+    label.setColor(zoomer.trackerPen().color());
+    QColor bgColor = canvasBackground().color();
+    bgColor.setAlphaF(0.8);
+    label.setBackgroundBrush(bgColor);
+    label.setBorderRadius(4);
+    measureLabel.setText(label);
+    measureLabel.show();
+}
+
 void Plot::setYAxis(bool autoScaled, double yAxisMin, double yAxisMax)
 {
     this->isAutoScaled = autoScaled;
@@ -148,6 +248,21 @@ void Plot::resetAxes()
     replot();
 }
 
+void Plot::followXLimits(double xMin, double xMax)
+{
+    // changing zoom base resets the zoom stack, don't while zoomed
+    if (zoomer.zoomRectIndex() == 0 && (xMin != _xMin || xMax != _xMax))
+    {
+        _xMin = xMin;
+        _xMax = xMax;
+        zoomer.setXLimits(xMin, xMax); // replots
+    }
+    else
+    {
+        replot();
+    }
+}
+
 void Plot::unzoomed()
 {
     resetAxes();
@@ -206,6 +321,13 @@ void Plot::darkBackground(bool enabled)
         zoomer.setRubberBandPen(QPen(Qt::white));
         zoomer.setTrackerPen(QPen(Qt::white));
         sZoomer.setPickerPen(QPen(Qt::white));
+        for (auto& cursor : measureCursors)
+        {
+            cursor.setLinePen(Qt::white, 0, Qt::DashLine);
+            auto label = cursor.label();
+            label.setColor(Qt::white);
+            cursor.setLabel(label);
+        }
 
         legend.setTextPen(QPen(Qt::white));
     }
@@ -221,6 +343,13 @@ void Plot::darkBackground(bool enabled)
         zoomer.setRubberBandPen(QPen(Qt::black));
         zoomer.setTrackerPen(QPen(Qt::black));
         sZoomer.setPickerPen(QPen(Qt::black));
+        for (auto& cursor : measureCursors)
+        {
+            cursor.setLinePen(Qt::black, 0, Qt::DashLine);
+            auto label = cursor.label();
+            label.setColor(Qt::black);
+            cursor.setLabel(label);
+        }
 
         legend.setTextPen(QPen(Qt::black));
     }
@@ -347,3 +476,296 @@ void Plot::setPlotWidth(double width)
     plotWidth = width;
     zoomer.setHViewSize(width);
 }
+
+void Plot::setRenderMode(RenderMode mode)
+{
+    renderMode = mode;
+    curveLayer = QImage();
+    layerState = LayerState();
+    replot();
+}
+
+void Plot::setDataPosition(quint64 position)
+{
+    dataPosition = position;
+}
+
+void Plot::drawCanvas(QPainter* painter)
+{
+    // `drawItems` is also called by `QwtPlotRenderer` when exporting,
+    // cached layer is only used for on screen painting
+    inCanvasPaint = true;
+    QwtPlot::drawCanvas(painter);
+    inCanvasPaint = false;
+}
+
+void Plot::drawItems(QPainter* painter, const QRectF& canvasRect,
+                     const QwtScaleMap maps[axisCnt]) const
+{
+    if (renderMode == Plot::RenderDirect || !inCanvasPaint || canvasRect.isEmpty())
+    {
+        QwtPlot::drawItems(painter, canvasRect, maps);
+        return;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QwtScaleMap& xMap = maps[QwtPlot::xBottom];
+    const QwtScaleMap& yMap = maps[QwtPlot::yLeft];
+    bool haveLayer = true;
+    if (renderMode == Plot::RenderIncremental)
+    {
+        updateCurveLayer(canvasRect, dpr, xMap, yMap);
+    }
+    else
+    {
+        haveLayer = requestCurveLayer(canvasRect, dpr, xMap, yMap);
+    }
+
+    // draw items in z order, curves are replaced by the cached layer
+    bool layerDrawn = false;
+    for (auto item : itemList())
+    {
+        if (!item->isVisible()) continue;
+
+        if (item->rtti() == QwtPlotItem::Rtti_PlotCurve && haveLayer)
+        {
+            if (!layerDrawn)
+            {
+                // threaded layer can be behind a resize, stretch it meanwhile
+                if (curveLayer.size() == (canvasRect.size() * dpr).toSize())
+                {
+                    painter->drawImage(canvasRect.topLeft(), curveLayer);
+                }
+                else
+                {
+                    painter->drawImage(canvasRect, curveLayer);
+                }
+                layerDrawn = true;
+            }
+            continue;
+        }
+
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing,
+                               item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(painter, maps[item->xAxis()], maps[item->yAxis()], canvasRect);
+        painter->restore();
+    }
+}
+
+bool Plot::LayerState::Curve::operator==(const Curve& other) const
+{
+    return item == other.item && pen == other.pen &&
+        symbolSize == other.symbolSize && dataSize == other.dataSize;
+}
+
+bool Plot::LayerState::operator==(const LayerState& other) const
+{
+    return canvasRect == other.canvasRect && dpr == other.dpr &&
+        xs1 == other.xs1 && xs2 == other.xs2 &&
+        xp1 == other.xp1 && xp2 == other.xp2 &&
+        ys1 == other.ys1 && ys2 == other.ys2 &&
+        yp1 == other.yp1 && yp2 == other.yp2 &&
+        background == other.background && curves == other.curves;
+}
+
+Plot::LayerState Plot::currentLayerState(const QRectF& canvasRect, qreal dpr,
+                                         const QwtScaleMap& xMap,
+                                         const QwtScaleMap& yMap) const
+{
+    LayerState state;
+    state.canvasRect = canvasRect;
+    state.dpr = dpr;
+    state.xs1 = xMap.s1(); state.xs2 = xMap.s2();
+    state.xp1 = xMap.p1(); state.xp2 = xMap.p2();
+    state.ys1 = yMap.s1(); state.ys2 = yMap.s2();
+    state.yp1 = yMap.p1(); state.yp2 = yMap.p2();
+    state.background = canvasBackground().color();
+
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (!item->isVisible()) continue;
+
+        auto curve = static_cast<const QwtPlotCurve*>(item);
+        auto symbol = curve->symbol();
+        state.curves.append({item, curve->pen(),
+                             symbol ? symbol->size().width() : 0,
+                             curve->dataSize()});
+    }
+
+    return state;
+}
+
+void Plot::updateCurveLayer(const QRectF& canvasRect, qreal dpr,
+                            const QwtScaleMap& xMap,
+                            const QwtScaleMap& yMap) const
+{
+    const QSize size = (canvasRect.size() * dpr).toSize();
+    LayerState state = currentLayerState(canvasRect, dpr, xMap, yMap);
+
+    if (curveLayer.size() != size || !(state == layerState))
+    {
+        curveLayer = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        curveLayer.setDevicePixelRatio(dpr);
+        layerState = state;
+        layerPosition = dataPosition;
+        redrawCurveLayer(canvasRect, xMap, yMap);
+        return;
+    }
+
+    const quint64 delta = dataPosition - layerPosition;
+    if (delta == 0 || state.curves.isEmpty()) return;
+    layerPosition = dataPosition;
+
+    // pixel distance between consecutive samples, all curves share X
+    auto curve = static_cast<const QwtPlotCurve*>(state.curves[0].item);
+    const size_t n = curve->dataSize();
+    if (n < 2 || delta >= n - 1)
+    {
+        redrawCurveLayer(canvasRect, xMap, yMap);
+        return;
+    }
+
+    const double px0 = xMap.transform(curve->sample(0).x());
+    const double dx = xMap.transform(curve->sample(1).x()) - px0;
+    const double shift = dx * delta * dpr + pendingShift;
+    const int w = size.width();
+    if (dx <= 0 || shift >= w)
+    {
+        redrawCurveLayer(canvasRect, xMap, yMap);
+        return;
+    }
+
+    // scroll the layer to the left by the whole pixels, keep the fraction
+    const int ishift = floor(shift);
+    pendingShift = shift - ishift;
+    if (ishift > 0)
+    {
+        const int bpl = curveLayer.bytesPerLine();
+        const int bpp = curveLayer.depth() / 8;
+        for (int y = 0; y < curveLayer.height(); y++)
+        {
+            uchar* line = curveLayer.scanLine(y);
+            memmove(line, line + ishift * bpp, (w - ishift) * bpp);
+            memset(line + (w - ishift) * bpp, 0, bpl - (w - ishift) * bpp);
+        }
+    }
+
+    // redraw the newly exposed strip, with some overlap for line joins
+    int overlap = 2;
+    for (auto& c : state.curves)
+    {
+        overlap = std::max(overlap, c.pen.width() + c.symbolSize + 2);
+    }
+    overlap = ceil(overlap * dpr);
+    const int stripLeft = std::max(0, w - ishift - overlap);
+
+    // range of samples that touch the strip (in logical coordinates)
+    const double stripLeftL = canvasRect.left() + (stripLeft - pendingShift) / dpr;
+    long from = floor((stripLeftL - px0) / dx) - 2;
+    long to = ceil((canvasRect.right() - px0) / dx) + 2;
+    from = std::max(0L, from);
+    to = std::min((long) n - 1, to);
+    if (from >= to) return;
+
+    QPainter painter(&curveLayer);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    const QRectF strip(stripLeft / dpr, 0, (w - stripLeft) / dpr, canvasRect.height());
+    painter.fillRect(strip, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setClipRect(strip);
+
+    // cached content lags behind the true position by `pendingShift`
+    painter.translate(-canvasRect.left() + pendingShift / dpr, -canvasRect.top());
+    for (auto& c : state.curves)
+    {
+        auto curve = static_cast<const QwtPlotCurve*>(c.item);
+        painter.setRenderHint(QPainter::Antialiasing,
+                              curve->testRenderHint(QwtPlotItem::RenderAntialiased));
+        curve->drawSeries(&painter, xMap, yMap, canvasRect, from, to);
+    }
+}
+
+void Plot::redrawCurveLayer(const QRectF& canvasRect,
+                            const QwtScaleMap& xMap,
+                            const QwtScaleMap& yMap) const
+{
+    pendingShift = 0;
+    curveLayer.fill(Qt::transparent);
+
+    QPainter painter(&curveLayer);
+    painter.translate(-canvasRect.topLeft());
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (!item->isVisible()) continue;
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing,
+                              item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(&painter, xMap, yMap, canvasRect);
+        painter.restore();
+    }
+}
+
+bool Plot::requestCurveLayer(const QRectF& canvasRect, qreal dpr,
+                             const QwtScaleMap& xMap,
+                             const QwtScaleMap& yMap) const
+{
+    // result of the running job will trigger another check
+    if (renderer.busy()) return !curveLayer.isNull();
+
+    LayerState state = currentLayerState(canvasRect, dpr, xMap, yMap);
+    if (!curveLayer.isNull() && state == layerState && dataPosition == layerPosition)
+    {
+        return true;
+    }
+
+    // copy data in view so that buffers can be updated while rendering
+    PlotRenderJob job;
+    job.size = (canvasRect.size() * dpr).toSize();
+    job.dpr = dpr;
+    job.canvasRect = canvasRect;
+    job.xMap = xMap;
+    job.yMap = yMap;
+    for (auto& c : state.curves)
+    {
+        auto curve = static_cast<const QwtPlotCurve*>(c.item);
+        PlotRenderJob::Curve jc;
+
+        const size_t n = curve->dataSize();
+        jc.samples.resize(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            jc.samples[i] = curve->sample(i);
+        }
+
+        jc.pen = curve->pen();
+        jc.antialiased = curve->testRenderHint(QwtPlotItem::RenderAntialiased);
+        auto symbol = curve->symbol();
+        jc.symbolStyle = symbol ? symbol->style() : QwtSymbol::NoSymbol;
+        if (symbol)
+        {
+            jc.symbolBrush = symbol->brush();
+            jc.symbolPen = symbol->pen();
+            jc.symbolSize = symbol->size();
+        }
+        job.curves.append(jc);
+    }
+
+    renderState = state;
+    renderPosition = dataPosition;
+    renderer.render(job);
+
+    return !curveLayer.isNull();
+}
+
+void Plot::onRenderFinished(QImage image)
+{
+    // mode might have been changed while rendering
+    if (renderMode != Plot::RenderThreaded) return;
+
+    curveLayer = image;
+    layerState = renderState;
+    layerPosition = renderPosition;
+    replot();
+}
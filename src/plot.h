@@ -23,8 +23,12 @@
 #include <QColor>
 #include <QList>
 #include <QAction>
+#include <QImage>
+#include <QPen>
+#include <QVector>
 #include <qwt_plot.h>
 #include <qwt_plot_grid.h>
+#include <qwt_plot_marker.h>
 #include <qwt_plot_shapeitem.h>
 #include <qwt_plot_legenditem.h>
 #include <qwt_plot_textlabel.h>
@@ -32,6 +36,7 @@
 #include "zoomer.h"
 #include "scalezoomer.h"
 #include "plotsnapshotoverlay.h"
+#include "plotrenderer.h"
 
 class Plot : public QwtPlot
 {
@@ -47,12 +52,46 @@ public:
         ShowSymbolsHide
     };
 
+    /// Curve drawing strategies, grid and overlays are always drawn directly
+    enum RenderMode
+    {
+        /// Curves are drawn from scratch at each replot on GUI thread
+        RenderDirect,
+        /**
+         * Curves are kept in a cached layer which is shifted by the
+         * amount of new data at each replot and only the newly exposed
+         * strip is drawn. Layer is fully redrawn when axes, canvas size
+         * or curve appearance changes.
+         *
+         * @note Data X values must be equally spaced.
+         */
+        RenderIncremental,
+        /**
+         * Curves are rasterized on a worker thread from a copy of the
+         * data in view. Latest finished image is displayed until the
+         * next one is ready.
+         */
+        RenderThreaded
+    };
+
     Plot(QWidget* parent = 0);
     ~Plot();
 
     /// Set displayed channels for value tracking (can be null)
     void setDispChannels(QVector<const StreamChannel*> channels);
 
+    /// Sets how curves are drawn, see `RenderMode`
+    void setRenderMode(RenderMode mode);
+    /**
+     * Sets the total number of samples that has been added to the
+     * plotted buffers so far (see `Stream::totalSamples()`). Should be
+     * called before `replot()` in incremental and threaded modes.
+     */
+    void setDataPosition(quint64 position);
+
+    /// Re-implemented to update measurement readouts before drawing
+    void replot() override;
+
 public slots:
     void showGrid(bool show = true);
     void showMinorGrid(bool show = true);
@@ -63,6 +102,12 @@ public slots:
     void darkBackground(bool enabled = true);
     void setYAxis(bool autoScaled, double yMin = 0, double yMax = 1);
     void setXAxis(double xMin, double xMax);
+    /**
+     * Updates X axis limits to follow data that provides its own X
+     * values. Unlike `setXAxis` doesn't reset the zoom; while zoomed
+     * in, limits are kept until unzoomed.
+     */
+    void followXLimits(double xMin, double xMax);
     void setSymbols(ShowSymbols shown);
     void setLegendPosition(Qt::AlignmentFlag alignment);
 
@@ -77,10 +122,17 @@ public slots:
 
     void setPlotWidth(double width);
 
+    /// Removes measurement cursors
+    void clearMeasureCursors();
+
 protected:
     /// update the display of symbols depending on `symbolSize`
     void updateSymbols();
 
+    void drawCanvas(QPainter* painter) override;
+    void drawItems(QPainter* painter, const QRectF& canvasRect,
+                   const QwtScaleMap maps[axisCnt]) const override;
+
 private:
     bool isAutoScaled;
     double yMin, yMax;
@@ -97,12 +149,75 @@ private:
     QwtPlotTextLabel noChannelIndicator;
     ShowSymbols showSymbols;
 
+    /// displayed channels for measurements
+    QVector<const StreamChannel*> dispChannels;
+    QwtPlotMarker measureCursors[2];
+    unsigned numMeasureCursors; ///< number of placed measurement cursors
+    QwtPlotTextLabel measureLabel;
+
+    /// Properties that invalidate the cached curve layer when changed
+    struct LayerState
+    {
+        QRectF canvasRect;
+        qreal dpr = 0;
+        double xs1 = 0, xs2 = 0, xp1 = 0, xp2 = 0;
+        double ys1 = 0, ys2 = 0, yp1 = 0, yp2 = 0;
+        QColor background;
+        struct Curve
+        {
+            const QwtPlotItem* item;
+            QPen pen;
+            int symbolSize;
+            size_t dataSize;
+            bool operator==(const Curve& other) const;
+        };
+        QVector<Curve> curves;
+        bool operator==(const LayerState& other) const;
+    };
+
+    RenderMode renderMode;
+    bool inCanvasPaint;  ///< set while painting to canvas (not exporting)
+    quint64 dataPosition;
+    mutable QImage curveLayer;
+    mutable LayerState layerState;
+    mutable quint64 layerPosition; ///< `dataPosition` of the cached layer
+    mutable double pendingShift; ///< fraction of pixel not yet shifted
+    mutable PlotRenderer renderer;
+    mutable LayerState renderState;   ///< state of the job being rendered
+    mutable quint64 renderPosition;   ///< position of the job being rendered
+
+    /// Captures current layer state for given maps
+    LayerState currentLayerState(const QRectF& canvasRect, qreal dpr,
+                                 const QwtScaleMap& xMap,
+                                 const QwtScaleMap& yMap) const;
+    /// Brings cached curve layer up to date with `dataPosition`
+    void updateCurveLayer(const QRectF& canvasRect, qreal dpr,
+                          const QwtScaleMap& xMap,
+                          const QwtScaleMap& yMap) const;
+    /// Draws all visible curves to the layer from scratch
+    void redrawCurveLayer(const QRectF& canvasRect,
+                          const QwtScaleMap& xMap,
+                          const QwtScaleMap& yMap) const;
+    /**
+     * Starts rendering of the curve layer on a worker thread if it is
+     * out of date and renderer isn't busy.
+     *
+     * @return false if there is no layer to display yet
+     */
+    bool requestCurveLayer(const QRectF& canvasRect, qreal dpr,
+                           const QwtScaleMap& xMap,
+                           const QwtScaleMap& yMap) const;
+
     void resetAxes();
+    /// Calculates measurements between cursors and updates the label
+    void updateMeasurement();
     void resizeEvent(QResizeEvent * event);
     void calcSymbolSize();
 
 private slots:
     void unzoomed();
+    void onMeasureCursorPlaced(double x);
+    void onRenderFinished(QImage image);
     void onXScaleChanged();
 };
 
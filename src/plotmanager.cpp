@@ -18,6 +18,7 @@
 */
 
 #include <algorithm>
+#include <cmath>
 #include <QMetaEnum>
 #include <QSvgGenerator>
 #include <qwt_symbol.h>
@@ -25,6 +26,8 @@
 
 #include "plot.h"
 #include "plotmanager.h"
+#include "metrics.h"
+#include "tracer.h"
 #include "setting_defines.h"
 #include "channelplotmappingdialog.h"
 
@@ -49,6 +52,7 @@ PlotManager::PlotManager(QWidget* plotArea, PlotMenu* menu,
             });
 
     connect(stream, &Stream::numChannelsChanged, this, &PlotManager::onNumChannelsChanged);
+    connect(stream, &Stream::hasXChanged, this, &PlotManager::onHasXChanged);
     connect(stream, &Stream::dataAdded, this, &PlotManager::replot);
 
     // Initialize mapping with current channel count
@@ -100,7 +104,9 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
     _numOfSamples = 1;
     _plotWidth = 1;
     showSymbols = Plot::ShowSymbolsAuto;
+    renderMode = menu->renderMode();
     emptyPlot = NULL;
+    lanePlot = NULL;
     inScaleSync = false;
     lineThickness = 1;
 
@@ -122,8 +128,14 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
 
     connect(&menu->showLegendAction, &QAction::toggled,
             this, &PlotManager::showLegend);
+    connect(menu, &PlotMenu::renderModeChanged, this, &PlotManager::setRenderMode);
     connect(&menu->configureChannelMappingAction, &QAction::triggered,
             this, &PlotManager::showChannelMappingDialog);
+    connect(&menu->showLanesAction, &QAction::toggled,
+            [this](bool checked)
+            {
+                rebuildPlotLayout();
+            });
     connect(menu, &PlotMenu::legendPosChanged, this, &PlotManager::setLegendPosition);
     
     // connect mapping changes
@@ -153,6 +165,7 @@ PlotManager::~PlotManager()
         delete plotWidgets.takeLast();
     }
 
+    if (lanePlot != NULL) delete lanePlot;
     if (scrollArea != NULL) delete scrollArea;
     if (emptyPlot != NULL) delete emptyPlot;
 }
@@ -220,8 +233,12 @@ void PlotManager::onChannelInfoChanged(const QModelIndex &topLeft,
 
     checkNoVisChannels();
 
+    if (lanePlot != NULL)
+    {
+        lanePlot->replot();
+    }
     // replot single widget
-    if (!isMulti)
+    else if (!isMulti)
     {
         plotWidgets[0]->updateSymbols();
         plotWidgets[0]->updateLegend();
@@ -231,6 +248,8 @@ void PlotManager::onChannelInfoChanged(const QModelIndex &topLeft,
 
 void PlotManager::checkNoVisChannels()
 {
+    if (plotWidgets.isEmpty()) return; // lane plot handles it itself
+
     // if all channels are hidden show indicator
     bool allhidden = std::none_of(curves.cbegin(), curves.cend(),
                                   [](QwtPlotCurve* c) {return c->isVisible();});
@@ -318,14 +337,8 @@ Plot* PlotManager::addPlotWidget()
     plot->setNumOfSamples(_numOfSamples);
 
     plot->setPlotWidth(_plotWidth);
-    if (_xAxisAsIndex)
-    {
-        plot->setXAxis(0, _numOfSamples);
-    }
-    else
-    {
-        plot->setXAxis(_xMin, _xMax);
-    }
+    updateXAxis(plot);
+    updateRenderMode(plot);
 
     if (isMulti)
     {
@@ -333,6 +346,14 @@ Plot* PlotManager::addPlotWidget()
                 this, &PlotManager::syncScales);
     }
 
+    // all plots share the same X range
+    connect(plot->axisWidget(QwtPlot::xBottom), &QwtScaleWidget::scaleDivChanged,
+            this, [this, plot]()
+            {
+                auto interval = plot->axisScaleDiv(QwtPlot::xBottom).interval();
+                emit visibleXRangeChanged(interval.minValue(), interval.maxValue());
+            });
+
     return plot;
 }
 
@@ -391,6 +412,13 @@ void PlotManager::_addCurve(QwtPlotCurve* curve)
     auto color = infoModel->color(index);
     curve->setPen(color, lineThickness);
 
+    if (lanePlot != NULL)
+    {
+        updateLanes();
+        lanePlot->replot();
+        return;
+    }
+
     // create the plot for the curve if we are on multi display
     Plot* plot;
     if (isMulti)
@@ -446,6 +474,8 @@ void PlotManager::removeCurves(unsigned number)
             }
         }
     }
+
+    if (lanePlot != NULL) updateLanes();
 }
 
 unsigned PlotManager::numOfCurves()
@@ -465,21 +495,125 @@ Plot* PlotManager::plotWidget(unsigned curveIndex)
     }
 }
 
+void PlotManager::updateXAxis(Plot* plot)
+{
+    if (_stream != nullptr && _stream->hasX())
+    {
+        return;                 // follows data, see `replot()`
+    }
+    else if (_xAxisAsIndex)
+    {
+        plot->setXAxis(0, _numOfSamples);
+    }
+    else
+    {
+        plot->setXAxis(_xMin, _xMax);
+    }
+}
+
 void PlotManager::replot()
 {
-    for (auto plot : plotWidgets)
+    static MetricHistogram& replotTime = Metrics::instance().histogram("plot.replot_time");
+    static MetricHistogram& frameInterval = Metrics::instance().histogram("gui.frame_interval");
+    static QElapsedTimer lastFrame;
+
+    if (lastFrame.isValid()) frameInterval.record(lastFrame.nsecsElapsed());
+    lastFrame.start();
+    MetricTimer timer(replotTime);
+    TRACE_SCOPE("PlotManager::replot");
+
+    if (_stream != nullptr)
     {
-        plot->replot();
+        for (auto plot : plotWidgets)
+        {
+            plot->setDataPosition(_stream->totalSamples());
+        }
     }
+
+    if (_stream != nullptr && _stream->hasX() && _stream->numChannels())
+    {
+        auto xLim = _stream->channel(0)->xData()->limits();
+        for (auto plot : plotWidgets)
+        {
+            plot->followXLimits(xLim.start, xLim.end);
+        }
+        if (lanePlot != NULL) lanePlot->setXAxis(xLim.start, xLim.end);
+    }
+    else
+    {
+        for (auto plot : plotWidgets)
+        {
+            plot->replot();
+        }
+    }
+    if (lanePlot != NULL) lanePlot->replot();
     if (isMulti) syncScales();
 }
 
+void PlotManager::updateLanes()
+{
+    QVector<QList<unsigned>> lanes;
+    QStringList names;
+    for (unsigned p = 0; p < _mapping->getNumPlotsNeeded(); p++)
+    {
+        lanes.append(_mapping->getChannelsForPlot(p));
+        if (_mapping->mode() == ChannelPlotMapping::CustomPlot)
+        {
+            names.append(_mapping->getPlotName(p));
+        }
+    }
+
+    lanePlot->setCurves(curves);
+    lanePlot->setLanes(lanes, names);
+}
+
+void PlotManager::updateLaneXAxis()
+{
+    if (lanePlot == NULL || (_stream != nullptr && _stream->hasX()))
+    {
+        return;                 // follows data, see `replot()`
+    }
+    else if (_xAxisAsIndex)
+    {
+        lanePlot->setXAxis(0, _numOfSamples);
+    }
+    else
+    {
+        lanePlot->setXAxis(_xMin, _xMax);
+    }
+}
+
+void PlotManager::updateRenderMode(Plot* plot)
+{
+    auto mode = renderMode;
+
+    // snapshots don't scroll and X provided by stream isn't equally spaced
+    if (mode == Plot::RenderIncremental &&
+        (_stream == nullptr || _stream->hasX()))
+    {
+        mode = Plot::RenderDirect;
+    }
+
+    if (_stream != nullptr) plot->setDataPosition(_stream->totalSamples());
+    plot->setRenderMode(mode);
+}
+
+void PlotManager::setRenderMode(Plot::RenderMode mode)
+{
+    renderMode = mode;
+    for (auto plot : plotWidgets)
+    {
+        updateRenderMode(plot);
+    }
+}
+
 void PlotManager::showGrid(bool show)
 {
     for (auto plot : plotWidgets)
     {
         plot->showGrid(show);
     }
+    if (lanePlot != NULL) lanePlot->showGrid(show);
 }
 
 void PlotManager::showMinorGrid(bool show)
@@ -513,6 +647,7 @@ void PlotManager::showDemoIndicator(bool show)
     {
         plot->showDemoIndicator(show);
     }
+    if (lanePlot != NULL) lanePlot->showDemoIndicator(show);
 }
 
 void PlotManager::unzoom()
@@ -529,6 +664,7 @@ void PlotManager::darkBackground(bool enabled)
     {
         plot->darkBackground(enabled);
     }
+    if (lanePlot != NULL) lanePlot->darkBackground(enabled);
 }
 
 void PlotManager::setSymbols(Plot::ShowSymbols shown)
@@ -549,6 +685,7 @@ void PlotManager::setYAxis(bool autoScaled, double yAxisMin, double yAxisMax)
     {
         plot->setYAxis(autoScaled, yAxisMin, yAxisMax);
     }
+    if (lanePlot != NULL) lanePlot->setYAxis(autoScaled, yAxisMin, yAxisMax);
 }
 
 void PlotManager::setXAxis(bool asIndex, double xMin, double xMax)
@@ -566,15 +703,29 @@ void PlotManager::setXAxis(bool asIndex, double xMin, double xMax)
     }
     for (auto plot : plotWidgets)
     {
-        if (asIndex)
-        {
-            plot->setXAxis(0, _numOfSamples);
-        }
-        else
-        {
-            plot->setXAxis(xMin, xMax);
-        }
+        updateXAxis(plot);
     }
+    updateLaneXAxis();
+    replot();
+}
+
+void PlotManager::onHasXChanged(bool hasX)
+{
+    // stream is about to delete the old X buffer, switch to the new one
+    int ci = 0;
+    for (auto curve : curves)
+    {
+        FrameBufferSeries* series = static_cast<FrameBufferSeries*>(curve->data());
+        series->setX(_stream->channel(ci)->xData());
+        ci++;
+    }
+
+    for (auto plot : plotWidgets)
+    {
+        if (!hasX) updateXAxis(plot);
+        updateRenderMode(plot);
+    }
+    updateLaneXAxis();
     replot();
 }
 
@@ -592,8 +743,9 @@ void PlotManager::setNumOfSamples(unsigned value)
     for (auto plot : plotWidgets)
     {
         plot->setNumOfSamples(value);
-        if (_xAxisAsIndex) plot->setXAxis(0, value);
+        if (_xAxisAsIndex) updateXAxis(plot);
     }
+    if (_xAxisAsIndex) updateLaneXAxis();
 }
 
 void PlotManager::setPlotWidth(double width)
@@ -632,6 +784,22 @@ void PlotManager::exportSvg(QString fileName) const
         suffix = ".svg";
     }
 
+    if (lanePlot != NULL)
+    {
+        QSize size(lanePlot->viewport()->width(), lanePlot->contentHeight());
+
+        QSvgGenerator gen;
+        gen.setFileName(fileName);
+        gen.setSize(size);
+        gen.setViewBox(QRect(QPoint(0, 0), size));
+
+        QPainter painter;
+        painter.begin(&gen);
+        lanePlot->drawContents(&painter, 0, QRect(QPoint(0, 0), size));
+        painter.end();
+        return;
+    }
+
     for (int i=0; i < plotWidgets.size(); i++)
     {
         if (plotWidgets.size() > 1)
@@ -687,6 +855,11 @@ void PlotManager::rebuildPlotLayout()
     {
         delete plotWidgets.takeLast();
     }
+    if (lanePlot != NULL)
+    {
+        delete lanePlot;
+        lanePlot = NULL;
+    }
 
     if (_mapping->mode() == ChannelPlotMapping::SinglePlot)
     {
@@ -706,6 +879,24 @@ void PlotManager::rebuildPlotLayout()
         }
         isMulti = false;
     }
+    else if (_menu->showLanesAction.isChecked())
+    {
+        // Setup a single lane plot, mapped plots become its lanes
+        setupLayout(false);
+        lanePlot = new LanePlot();
+        layout->addWidget(lanePlot);
+
+        lanePlot->darkBackground(_menu->darkBackgroundAction.isChecked());
+        lanePlot->showGrid(_menu->showGridAction.isChecked());
+        lanePlot->showDemoIndicator(isDemoShown);
+        lanePlot->setYAxis(_autoScaled, _yMin, _yMax);
+        updateLaneXAxis();
+        updateLanes();
+        isMulti = false;
+
+        // lanes always display the whole buffer
+        emit visibleXRangeChanged(-INFINITY, INFINITY);
+    }
     else if (_mapping->mode() == ChannelPlotMapping::MultiPlot)
     {
         // Setup multi plot layout (each channel in its own plot)
@@ -776,7 +967,7 @@ void PlotManager::rebuildPlotLayout()
     QMetaObject::invokeMethod(this, "syncScales", Qt::QueuedConnection);
 
     // will skip if no plot widgets exist (can happen during constructor)
-    if (plotWidgets.length())
+    if (plotWidgets.length() || lanePlot != NULL)
     {
         checkNoVisChannels();
         replot();
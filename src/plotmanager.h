@@ -30,6 +30,7 @@
 
 #include <qwt_plot_curve.h>
 #include "plot.h"
+#include "laneplot.h"
 #include "framebufferseries.h"
 #include "stream.h"
 #include "snapshot.h"
@@ -61,6 +62,10 @@ public:
     /// Get the channel plot mapping object
     ChannelPlotMapping* mapping() const { return _mapping; }
 
+signals:
+    /// Emitted when visible X range of plots changes (by zoom, scroll or data)
+    void visibleXRangeChanged(double xMin, double xMax);
+
 public slots:
     /// Enable/Disable multiple plot display
     void setMulti(bool enabled);
@@ -98,6 +103,7 @@ private:
     QList<QwtPlotCurve*> curves;
     QList<Plot*> plotWidgets;
     Plot* emptyPlot;  ///< for displaying when all channels are hidden
+    LanePlot* lanePlot; ///< replaces plot widgets in lane view, can be `NULL`
     const Stream* _stream;       ///< attached stream, can be `nullptr`
     const ChannelInfoModel* infoModel;
     bool isDemoShown;
@@ -110,6 +116,7 @@ private:
     unsigned _numOfSamples;
     double _plotWidth;
     Plot::ShowSymbols showSymbols;
+    Plot::RenderMode renderMode;
     bool inScaleSync; ///< scaleSync is in progress
     int lineThickness;
 
@@ -127,6 +134,15 @@ private:
     void checkNoVisChannels();
     /// Rebuild plot layout based on current mapping
     void rebuildPlotLayout();
+    /// Sets X axis of a plot widget from settings (unless stream provides X)
+    void updateXAxis(Plot* plot);
+    /// Updates lanes of `lanePlot` from mapping
+    void updateLanes();
+    /// Sets X axis of `lanePlot` from settings (unless stream provides X)
+    void updateLaneXAxis();
+    /// Sets rendering mode of a plot widget, falls back to direct
+    /// rendering when selected mode isn't applicable
+    void updateRenderMode(Plot* plot);
 
 private slots:
     void showGrid(bool show = true);
@@ -136,8 +152,10 @@ private slots:
     void unzoom();
     void darkBackground(bool enabled = true);
     void setSymbols(Plot::ShowSymbols shown);
+    void setRenderMode(Plot::RenderMode mode);
 
     void onNumChannelsChanged(unsigned value);
+    void onHasXChanged(bool hasX);
     void onChannelInfoChanged(const QModelIndex & topLeft,
                               const QModelIndex & bottomRight,
                               const QVector<int> & roles = QVector<int> ());
@@ -30,6 +30,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     unzoomAction("&Unzoom", this),
     darkBackgroundAction("&Dark Background", this),
     showLegendAction("&Legend", this),
+    showLanesAction("Lane &View", this),
     configureChannelMappingAction("Configure Channel &Mapping...", this),
     setSymbolsAction("&Symbols", this),
     setSymbolsAutoAct("Show When &Zoomed", this),
@@ -40,13 +41,26 @@ PlotMenu::PlotMenu(QWidget* parent) :
     setLegendTopLeftAct("Top Left", this),
     setLegendTopRightAct("Top Right", this),
     setLegendBottomRightAct("Bottom Right", this),
-    setLegendBottomLeftAct("Bottom Left", this)
+    setLegendBottomLeftAct("Bottom Left", this),
+    setRenderModeAction("&Rendering", this),
+    renderModeGrp(this),
+    setRenderDirectAct("&Direct", this),
+    setRenderIncrementalAct("&Incremental", this),
+    setRenderThreadedAct("&Threaded", this)
 {
     showGridAction.setToolTip("Show Grid");
     showMinorGridAction.setToolTip("Show Minor Grid");
     unzoomAction.setToolTip("Unzoom the Plot");
     darkBackgroundAction.setToolTip("Enable Dark Plot Background");
     showLegendAction.setToolTip("Display the Legend on Plot");
+    showLanesAction.setToolTip("Display multiple plots as lanes of a single lightweight plot, "
+                               "suitable for many channels");
+    setRenderModeAction.setToolTip("Select how curves are drawn");
+    setRenderDirectAct.setToolTip("Redraw all curves at each update");
+    setRenderIncrementalAct.setToolTip("Only draw new data by scrolling the plotted curves, "
+                                       "reduces CPU usage with large buffers");
+    setRenderThreadedAct.setToolTip("Draw curves on a background thread, "
+                                    "keeps the interface responsive under heavy load");
     setSymbolsAction.setToolTip("Show/Hide symbols");
 
     showGridAction.setShortcut(QKeySequence("G"));
@@ -56,11 +70,13 @@ PlotMenu::PlotMenu(QWidget* parent) :
     showMinorGridAction.setCheckable(true);
     darkBackgroundAction.setCheckable(true);
     showLegendAction.setCheckable(true);
+    showLanesAction.setCheckable(true);
 
     showGridAction.setChecked(true);
     showMinorGridAction.setChecked(false);
     darkBackgroundAction.setChecked(false);
     showLegendAction.setChecked(true);
+    showLanesAction.setChecked(false);
 
     // minor grid is only enabled when _major_ grid is enabled
     showMinorGridAction.setEnabled(false);
@@ -132,6 +148,29 @@ PlotMenu::PlotMenu(QWidget* parent) :
 
     setLegendPosAction.setMenu(&setLegendPosMenu);
 
+    // Setup rendering mode menu
+    QAction* renderActs[] = {&setRenderDirectAct, &setRenderIncrementalAct,
+                             &setRenderThreadedAct};
+    Plot::RenderMode renderModes[] = {Plot::RenderDirect, Plot::RenderIncremental,
+                                      Plot::RenderThreaded};
+    for (int i = 0; i < 3; i++)
+    {
+        auto act = renderActs[i];
+        auto mode = renderModes[i];
+        act->setData(int(mode));
+        act->setCheckable(true);
+        setRenderModeMenu.addAction(act);
+        renderModeGrp.addAction(act);
+        connect(act, &QAction::toggled,
+                [this, mode](bool checked)
+                {
+                    if (checked) emit renderModeChanged(mode);
+                });
+    }
+    setRenderDirectAct.setChecked(true); // default selection
+
+    setRenderModeAction.setMenu(&setRenderModeMenu);
+
     // add all actions to create this menu
     addAction(&showGridAction);
     addAction(&showMinorGridAction);
@@ -141,7 +180,9 @@ PlotMenu::PlotMenu(QWidget* parent) :
     addAction(&setLegendPosAction);
     addSeparator();
     addAction(&configureChannelMappingAction);
+    addAction(&showLanesAction);
     addAction(&setSymbolsAction);
+    addAction(&setRenderModeAction);
 }
 
 PlotMenu::PlotMenu(PlotViewSettings s, QWidget* parent) :
@@ -199,6 +240,11 @@ Qt::AlignmentFlag PlotMenu::legendPosition() const
     return (Qt::AlignmentFlag) legendPosGrp.checkedAction()->data().toInt();
 }
 
+Plot::RenderMode PlotMenu::renderMode() const
+{
+    return (Plot::RenderMode) renderModeGrp.checkedAction()->data().toInt();
+}
+
 void PlotMenu::saveSettings(QSettings* settings)
 {
     settings->beginGroup(SettingGroup_Plot);
@@ -206,6 +252,7 @@ void PlotMenu::saveSettings(QSettings* settings)
     settings->setValue(SG_Plot_Grid, showGridAction.isChecked());
     settings->setValue(SG_Plot_MinorGrid, showMinorGridAction.isChecked());
     settings->setValue(SG_Plot_Legend, showLegendAction.isChecked());
+    settings->setValue(SG_Plot_LaneView, showLanesAction.isChecked());
 
     // save symbol option
     QString showSymbolsStr;
@@ -243,6 +290,22 @@ void PlotMenu::saveSettings(QSettings* settings)
     }
     settings->setValue(SG_Plot_LegendPos, legendPosStr);
 
+    // save rendering mode
+    QString renderModeStr;
+    if (setRenderIncrementalAct.isChecked())
+    {
+        renderModeStr = "incremental";
+    }
+    else if (setRenderThreadedAct.isChecked())
+    {
+        renderModeStr = "threaded";
+    }
+    else
+    {
+        renderModeStr = "direct";
+    }
+    settings->setValue(SG_Plot_RenderMode, renderModeStr);
+
     settings->endGroup();
 }
 
@@ -258,6 +321,8 @@ void PlotMenu::loadSettings(QSettings* settings)
     showMinorGridAction.setEnabled(showGridAction.isChecked());
     showLegendAction.setChecked(
         settings->value(SG_Plot_Legend, showLegendAction.isChecked()).toBool());
+    showLanesAction.setChecked(
+        settings->value(SG_Plot_LaneView, showLanesAction.isChecked()).toBool());
 
     // load symbol option
     QString showSymbolsStr = settings->value(SG_Plot_Symbols, QString()).toString();
@@ -305,5 +370,24 @@ void PlotMenu::loadSettings(QSettings* settings)
     // emitted when 'setChecked' is called on its items.
     emit legendPosChanged(legendPosition());
 
+    // load rendering mode
+    QString renderModeStr = settings->value(SG_Plot_RenderMode, QString()).toString();
+    if (renderModeStr == "direct")
+    {
+        setRenderDirectAct.setChecked(true);
+    }
+    else if (renderModeStr == "incremental")
+    {
+        setRenderIncrementalAct.setChecked(true);
+    }
+    else if (renderModeStr == "threaded")
+    {
+        setRenderThreadedAct.setChecked(true);
+    }
+    else if (!renderModeStr.isEmpty())
+    {
+        qCritical() << "Invalid rendering mode setting:" << renderModeStr;
+    }
+
     settings->endGroup();
 }
@@ -51,6 +51,7 @@ public:
     QAction unzoomAction;
     QAction darkBackgroundAction;
     QAction showLegendAction;
+    QAction showLanesAction;
     QAction configureChannelMappingAction;
 
     /// Returns a bundle of current view settings (menu selections)
@@ -59,6 +60,8 @@ public:
     Plot::ShowSymbols showSymbols() const;
     /// Return selected legend position as Qt alignment enum
     Qt::AlignmentFlag legendPosition() const;
+    /// Selected curve rendering mode
+    Plot::RenderMode renderMode() const;
     /// Stores plot settings into a `QSettings`.
     void saveSettings(QSettings* settings);
     /// Loads plot settings from a `QSettings`.
@@ -81,9 +84,18 @@ private:
     QAction setLegendBottomRightAct;
     QAction setLegendBottomLeftAct;
 
+    // Rendering mode menu
+    QAction setRenderModeAction;
+    QMenu setRenderModeMenu;
+    QActionGroup renderModeGrp;
+    QAction setRenderDirectAct;
+    QAction setRenderIncrementalAct;
+    QAction setRenderThreadedAct;
+
 signals:
     void symbolShowChanged(Plot::ShowSymbols shown);
     void legendPosChanged(Qt::AlignmentFlag alignment);
+    void renderModeChanged(Plot::RenderMode mode);
 };
 
 #endif // PLOTMENU_H
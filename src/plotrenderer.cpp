@@ -0,0 +1,105 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QThreadPool>
+#include <QPainter>
+#include <QMutexLocker>
+#include <qwt_plot_curve.h>
+
+#include "plotrenderer.h"
+#include "metrics.h"
+#include "tracer.h"
+
+PlotRenderer::PlotRenderer(QObject* parent) :
+    QObject(parent)
+{
+    _busy = false;
+    running = false;
+}
+
+PlotRenderer::~PlotRenderer()
+{
+    // result event posted by the job is discarded with this object
+    QMutexLocker locker(&runningLock);
+    while (running) runningDone.wait(&runningLock);
+}
+
+bool PlotRenderer::busy() const
+{
+    return _busy;
+}
+
+void PlotRenderer::render(PlotRenderJob job)
+{
+    Q_ASSERT(!_busy);
+
+    _busy = true;
+    {
+        QMutexLocker locker(&runningLock);
+        running = true;
+    }
+
+    QThreadPool::globalInstance()->start([this, job]()
+    {
+        QImage image = rasterize(job);
+        QMetaObject::invokeMethod(this, [this, image]()
+        {
+            _busy = false;
+            emit finished(image);
+        }, Qt::QueuedConnection);
+
+        QMutexLocker locker(&runningLock);
+        running = false;
+        runningDone.wakeAll();
+    });
+}
+
+QImage PlotRenderer::rasterize(const PlotRenderJob& job)
+{
+    static MetricHistogram& renderTime = Metrics::instance().histogram("plot.render_time");
+    MetricTimer timer(renderTime);
+    TRACE_SCOPE("PlotRenderer::rasterize");
+
+    QImage image(job.size, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(job.dpr);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.translate(-job.canvasRect.topLeft());
+    for (auto& c : job.curves)
+    {
+        // a detached curve, plot items aren't touched outside GUI thread
+        QwtPlotCurve curve;
+        curve.setPen(c.pen);
+        curve.setRenderHint(QwtPlotItem::RenderAntialiased, c.antialiased);
+        if (c.symbolStyle != QwtSymbol::NoSymbol)
+        {
+            curve.setSymbol(new QwtSymbol(c.symbolStyle, c.symbolBrush,
+                                          c.symbolPen, c.symbolSize));
+        }
+        curve.setSamples(c.samples);
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing, c.antialiased);
+        curve.draw(&painter, job.xMap, job.yMap, job.canvasRect);
+        painter.restore();
+    }
+
+    return image;
+}
@@ -0,0 +1,92 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLOTRENDERER_H
+#define PLOTRENDERER_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QPen>
+#include <QBrush>
+#include <QVector>
+#include <QPointF>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+/// Everything needed to rasterize the curves of a plot canvas,
+/// independent of the plot and its data buffers.
+struct PlotRenderJob
+{
+    struct Curve
+    {
+        QVector<QPointF> samples;   ///< copy of samples in view
+        QPen pen;
+        bool antialiased;
+        QwtSymbol::Style symbolStyle; ///< `NoSymbol` if not shown
+        QBrush symbolBrush;
+        QPen symbolPen;
+        QSize symbolSize;
+    };
+
+    QSize size;                     ///< image size in device pixels
+    qreal dpr;
+    QRectF canvasRect;
+    QwtScaleMap xMap;
+    QwtScaleMap yMap;
+    QVector<Curve> curves;
+};
+
+/**
+ * Rasterizes plot curves into a `QImage` on the global thread pool.
+ *
+ * Only one job is run at a time for a renderer, each plot has its own
+ * renderer so multiple plots are rendered in parallel. Result is
+ * delivered with the `finished` signal on the renderer's thread.
+ */
+class PlotRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PlotRenderer(QObject* parent = 0);
+    /// Waits for the running job to finish
+    ~PlotRenderer();
+
+    /// True from `render` until `finished` is emitted
+    bool busy() const;
+    /// Starts rendering given job, must not be `busy()`
+    void render(PlotRenderJob job);
+
+    /// Does the actual rendering, can be called from any thread
+    static QImage rasterize(const PlotRenderJob& job);
+
+signals:
+    /// Transparent image of curves in canvas coordinates
+    void finished(QImage image);
+
+private:
+    bool _busy;                 ///< only accessed from owner thread
+    QMutex runningLock;
+    QWaitCondition runningDone;
+    bool running;               ///< guarded by `runningLock`
+};
+
+#endif // PLOTRENDERER_H
@@ -0,0 +1,267 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QScrollArea>
+#include <QSerialPortInfo>
+#include <QtDebug>
+
+#include "portsession.h"
+#include "setting_defines.h"
+
+PortWorker::PortWorker()
+{
+    port = nullptr;
+    bytesRead = 0;
+}
+
+quint64 PortWorker::takeBytesRead()
+{
+    return bytesRead.fetchAndStoreRelaxed(0);
+}
+
+void PortWorker::open(QString portName, qint32 baudRate)
+{
+    if (port == nullptr)
+    {
+        // parented so that it's deleted with the worker, on worker thread
+        port = new QSerialPort(this);
+        connect(port, &QSerialPort::readyRead, this, &PortWorker::onReadyRead);
+        connect(port, &QSerialPort::errorOccurred, this, &PortWorker::onError);
+    }
+
+    if (port->isOpen()) port->close();
+
+    port->setPortName(portName);
+    port->setBaudRate(baudRate);
+    if (port->open(QIODevice::ReadOnly))
+    {
+        emit opened(true, QString());
+    }
+    else
+    {
+        emit opened(false, port->errorString());
+    }
+}
+
+void PortWorker::close()
+{
+    if (port != nullptr && port->isOpen())
+    {
+        port->close();
+    }
+    emit closed();
+}
+
+void PortWorker::onReadyRead()
+{
+    QByteArray data = port->readAll();
+    qint64 time = StreamMerger::now();
+    bytesRead.fetchAndAddRelaxed(data.size());
+    emit dataReceived(data, time);
+}
+
+void PortWorker::onError(QSerialPort::SerialPortError error)
+{
+    // device is gone (unplugged for ex.)
+    if (error == QSerialPort::ResourceError && port->isOpen())
+    {
+        qWarning() << "Port error:" << port->portName() << port->errorString();
+        close();
+    }
+}
+
+PortSession::PortSession(StreamMerger* merger, QWidget* parent) :
+    QWidget(parent),
+    reader(&device)
+{
+    _merger = merger;
+    _isOpen = false;
+    sps = 0;
+
+    worker = new PortWorker();
+    worker->moveToThread(&thread);
+    connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(worker, &PortWorker::opened, this, &PortSession::onOpened);
+    connect(worker, &PortWorker::closed, this, &PortSession::onClosed);
+    connect(worker, &PortWorker::dataReceived, this, &PortSession::onDataReceived);
+    thread.setObjectName("PortSession");
+    thread.start();
+
+    // reader is always enabled, it only gets data while port is open
+    reader.enable(true);
+    input = _merger->addInput();
+    reader.connectSink(input);
+    reader.connectSink(&sampleCounter);
+    connect(&sampleCounter, &SampleCounter::spsChanged,
+            [this](float value)
+            {
+                sps = value;
+            });
+
+    // setup widgets
+    cbPort.setEditable(true);
+    loadPortList();
+    for (auto baudRate : QSerialPortInfo::standardBaudRates())
+    {
+        cbBaudRate.addItem(QString::number(baudRate));
+    }
+    cbBaudRate.setEditable(true);
+    cbBaudRate.setCurrentIndex(cbBaudRate.findText("115200"));
+
+    pbOpen.setText(tr("Open"));
+    pbOpen.setCheckable(true);
+    lThroughput.setText(tr("0 B/s, 0 sps"));
+
+    auto portRow = new QHBoxLayout();
+    portRow->addWidget(&cbPort, 1);
+    portRow->addWidget(new QLabel(tr("Baud:")));
+    portRow->addWidget(&cbBaudRate);
+    portRow->addWidget(&pbOpen);
+    portRow->addWidget(&lThroughput);
+
+    auto scroll = new QScrollArea();
+    scroll->setWidget(reader.settingsWidget());
+    scroll->setWidgetResizable(true);
+    scroll->setFrameShape(QFrame::NoFrame);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(portRow);
+    layout->addWidget(scroll);
+
+    connect(&pbOpen, &QPushButton::clicked, this, &PortSession::open);
+    connect(&cbPort, &QComboBox::currentTextChanged,
+            this, &PortSession::portNameChanged);
+
+    connect(&throughputTimer, &QTimer::timeout, this, &PortSession::updateThroughput);
+}
+
+PortSession::~PortSession()
+{
+    QMetaObject::invokeMethod(worker, &PortWorker::close, Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+
+    reader.disconnectSinks();
+    _merger->removeInput(input);
+}
+
+QString PortSession::portName() const
+{
+    return cbPort.currentText();
+}
+
+bool PortSession::isOpen() const
+{
+    return _isOpen;
+}
+
+void PortSession::loadPortList()
+{
+    QString current = cbPort.currentText();
+    cbPort.clear();
+    for (auto info : QSerialPortInfo::availablePorts())
+    {
+        cbPort.addItem(info.portName());
+    }
+    cbPort.setCurrentText(current);
+}
+
+void PortSession::open(bool enabled)
+{
+    QString name = portName();
+    qint32 baudRate = cbBaudRate.currentText().toInt();
+
+    if (enabled)
+    {
+        pbOpen.setEnabled(false);
+        QMetaObject::invokeMethod(worker, [this, name, baudRate]
+                                  {
+                                      worker->open(name, baudRate);
+                                  });
+    }
+    else
+    {
+        QMetaObject::invokeMethod(worker, &PortWorker::close);
+    }
+}
+
+void PortSession::onOpened(bool success, QString error)
+{
+    pbOpen.setEnabled(true);
+    if (!success)
+    {
+        qCritical() << "Failed to open port" << portName() << ":" << error;
+        pbOpen.setChecked(false);
+        return;
+    }
+
+    _isOpen = true;
+    device.clear();
+    pbOpen.setChecked(true);
+    pbOpen.setText(tr("Close"));
+    cbPort.setEnabled(false);
+    cbBaudRate.setEnabled(false);
+    throughputTimer.start(1000);
+}
+
+void PortSession::onClosed()
+{
+    _isOpen = false;
+    pbOpen.setChecked(false);
+    pbOpen.setText(tr("Open"));
+    cbPort.setEnabled(true);
+    cbBaudRate.setEnabled(true);
+    throughputTimer.stop();
+    sps = 0;
+    updateThroughput();
+}
+
+void PortSession::onDataReceived(QByteArray data, qint64 time)
+{
+    if (!_isOpen) return;
+
+    // reader consumes data synchronously, so arrival time applies
+    _merger->setArrivalTime(input, time);
+    device.append(data);
+}
+
+void PortSession::updateThroughput()
+{
+    quint64 bytes = worker->takeBytesRead();
+    lThroughput.setText(tr("%1 B/s, %2 sps").arg(bytes).arg(sps, 0, 'f', 0));
+}
+
+void PortSession::saveSettings(QSettings* settings)
+{
+    settings->setValue(SG_MultiPort_Port, portName());
+    settings->setValue(SG_MultiPort_BaudRate, cbBaudRate.currentText());
+    reader.saveSettings(settings);
+}
+
+void PortSession::loadSettings(QSettings* settings)
+{
+    cbPort.setCurrentText(settings->value(SG_MultiPort_Port, portName()).toString());
+    cbBaudRate.setCurrentText(
+        settings->value(SG_MultiPort_BaudRate, cbBaudRate.currentText()).toString());
+    reader.loadSettings(settings);
+}
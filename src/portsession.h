@@ -0,0 +1,131 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PORTSESSION_H
+#define PORTSESSION_H
+
+#include <QWidget>
+#include <QThread>
+#include <QTimer>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QSettings>
+#include <QSerialPort>
+#include <QAtomicInteger>
+
+#include "chunkdevice.h"
+#include "framedreader.h"
+#include "samplecounter.h"
+#include "streammerger.h"
+
+/**
+ * Owns a serial port on a worker thread. Received data is sent out
+ * with its arrival time.
+ */
+class PortWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    PortWorker();
+
+    /// Returns and zeroes the received byte counter, thread safe
+    quint64 takeBytesRead();
+
+public slots:
+    void open(QString portName, qint32 baudRate);
+    void close();
+
+signals:
+    /// Emitted after an `open` request, `error` is empty on success
+    void opened(bool success, QString error);
+    /// Emitted when port is closed, by request or because of an error
+    void closed();
+    /// @param time arrival time, see `StreamMerger::now()`
+    void dataReceived(QByteArray data, qint64 time);
+
+private:
+    QSerialPort* port;  ///< created on worker thread
+    QAtomicInteger<quint64> bytesRead;
+
+private slots:
+    void onReadyRead();
+    void onError(QSerialPort::SerialPortError error);
+};
+
+/**
+ * An additional acquisition session with its own port, worker thread
+ * and reader. Read data is fed to an input of a `StreamMerger`.
+ *
+ * Reading from the port happens on the worker thread, frames are
+ * parsed on GUI thread with the arrival time of the data.
+ */
+class PortSession : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PortSession(StreamMerger* merger, QWidget* parent = 0);
+    ~PortSession();
+
+    QString portName() const;
+    bool isOpen() const;
+
+    /// Stores session settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads session settings from a `QSettings`
+    void loadSettings(QSettings* settings);
+
+signals:
+    void portNameChanged(QString name);
+
+public slots:
+    void open(bool enabled);
+
+private:
+    StreamMerger* _merger;
+    Sink* input;
+    bool _isOpen;
+
+    QThread thread;
+    PortWorker* worker;
+    ChunkDevice device;
+    FramedReader reader;
+    SampleCounter sampleCounter;
+
+    QComboBox cbPort;
+    QComboBox cbBaudRate;
+    QPushButton pbOpen;
+    QLabel lThroughput;
+    QTimer throughputTimer;
+    float sps;
+
+    /// Fills the port list, keeps current selection
+    void loadPortList();
+
+private slots:
+    void onOpened(bool success, QString error);
+    void onClosed();
+    void onDataReceived(QByteArray data, qint64 time);
+    void updateThroughput();
+};
+
+#endif // PORTSESSION_H
@@ -0,0 +1,120 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include "portsessionspanel.h"
+#include "setting_defines.h"
+
+PortSessionsPanel::PortSessionsPanel(StreamMerger* merger, QWidget* parent) :
+    QWidget(parent)
+{
+    _merger = merger;
+
+    pbAdd.setText(tr("Add Port"));
+    pbAdd.setToolTip(tr("Add a port that is read concurrently with the main port.\n"
+                        "Channels of all ports are merged into the plot on a common time base."));
+    pbRemove.setText(tr("Remove Port"));
+    pbRemove.setEnabled(false);
+
+    auto buttons = new QHBoxLayout();
+    buttons->addWidget(&pbAdd);
+    buttons->addWidget(&pbRemove);
+    buttons->addStretch();
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(buttons);
+    layout->addWidget(&tabs);
+
+    connect(&pbAdd, &QPushButton::clicked, this, &PortSessionsPanel::addSession);
+    connect(&pbRemove, &QPushButton::clicked, this, &PortSessionsPanel::removeSession);
+}
+
+PortSessionsPanel::~PortSessionsPanel()
+{
+    for (auto session : sessions)
+    {
+        delete session;
+    }
+}
+
+PortSession* PortSessionsPanel::addSession()
+{
+    auto session = new PortSession(_merger);
+    sessions.append(session);
+
+    int index = tabs.addTab(session, session->portName());
+    tabs.setCurrentIndex(index);
+    connect(session, &PortSession::portNameChanged,
+            [this, session](QString name)
+            {
+                tabs.setTabText(tabs.indexOf(session), name);
+            });
+
+    pbRemove.setEnabled(true);
+    return session;
+}
+
+void PortSessionsPanel::removeSession()
+{
+    int index = tabs.currentIndex();
+    if (index < 0) return;
+
+    auto session = static_cast<PortSession*>(tabs.widget(index));
+    tabs.removeTab(index);
+    sessions.removeOne(session);
+    delete session;
+
+    pbRemove.setEnabled(!sessions.isEmpty());
+}
+
+void PortSessionsPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_MultiPort);
+    settings->setValue(SG_MultiPort_NumSessions, sessions.size());
+    for (int i = 0; i < sessions.size(); i++)
+    {
+        settings->beginGroup(QString("session%1").arg(i));
+        sessions[i]->saveSettings(settings);
+        settings->endGroup();
+    }
+    settings->endGroup();
+}
+
+void PortSessionsPanel::loadSettings(QSettings* settings)
+{
+    while (!sessions.isEmpty())
+    {
+        tabs.setCurrentIndex(0);
+        removeSession();
+    }
+
+    settings->beginGroup(SettingGroup_MultiPort);
+    int num = settings->value(SG_MultiPort_NumSessions, 0).toInt();
+    for (int i = 0; i < num; i++)
+    {
+        auto session = addSession();
+        settings->beginGroup(QString("session%1").arg(i));
+        session->loadSettings(settings);
+        settings->endGroup();
+    }
+    settings->endGroup();
+}
@@ -0,0 +1,65 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PORTSESSIONSPANEL_H
+#define PORTSESSIONSPANEL_H
+
+#include <QWidget>
+#include <QTabWidget>
+#include <QPushButton>
+#include <QSettings>
+#include <QList>
+
+#include "portsession.h"
+#include "streammerger.h"
+
+/**
+ * Manages additional port sessions that run concurrently with the
+ * main port. Data of all sessions is merged into the main stream.
+ */
+class PortSessionsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PortSessionsPanel(StreamMerger* merger, QWidget* parent = 0);
+    ~PortSessionsPanel();
+
+    /// Stores sessions into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads sessions from a `QSettings`, existing sessions are removed
+    void loadSettings(QSettings* settings);
+
+public slots:
+    /// Adds a new session and returns it
+    PortSession* addSession();
+    /// Removes currently selected session
+    void removeSession();
+
+private:
+    StreamMerger* _merger;
+    QList<PortSession*> sessions;
+
+    QTabWidget tabs;
+    QPushButton pbAdd;
+    QPushButton pbRemove;
+};
+
+#endif // PORTSESSIONSPANEL_H
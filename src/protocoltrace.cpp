@@ -0,0 +1,115 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QDateTime>
+#include <algorithm>
+#include <cstring>
+
+#include "protocoltrace.h"
+
+ProtocolTrace& ProtocolTrace::instance()
+{
+    static ProtocolTrace trace;
+    return trace;
+}
+
+ProtocolTrace::ProtocolTrace() :
+    head(0), base(0)
+{
+    for (auto& slot : ring)
+    {
+        slot.seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ProtocolTrace::record(EventType type, quint64 offset, uint32_t value,
+                           const uint8_t* data, unsigned size,
+                           uint32_t expected, uint32_t received)
+{
+    quint64 i = head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring[i % Capacity];
+
+    // 0 marks the slot as being written
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Event& e = slot.event;
+    e.time = QDateTime::currentMSecsSinceEpoch();
+    e.offset = offset;
+    e.value = value;
+    e.expected = expected;
+    e.received = received;
+    e.frameSize = std::min(size, 0xFFFFu);
+    e.type = type;
+    e.dataSize = std::min(size, unsigned(MaxDataSize));
+    if (e.dataSize) memcpy(e.data, data, e.dataSize);
+
+    slot.seq.store(i + 1, std::memory_order_release);
+}
+
+QVector<ProtocolTrace::Event> ProtocolTrace::events() const
+{
+    quint64 end = head.load(std::memory_order_acquire);
+    quint64 start = std::max(base.load(std::memory_order_relaxed),
+                             end > Capacity ? end - Capacity : 0);
+
+    QVector<Event> result;
+    result.reserve(end - start);
+    for (quint64 i = start; i < end; i++)
+    {
+        const Slot& slot = ring[i % Capacity];
+        if (slot.seq.load(std::memory_order_acquire) != i + 1) continue;
+
+        Event e = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // discard if it was overwritten while copying
+        if (slot.seq.load(std::memory_order_relaxed) != i + 1) continue;
+
+        result.append(e);
+    }
+    return result;
+}
+
+quint64 ProtocolTrace::count() const
+{
+    return head.load(std::memory_order_relaxed) - base.load(std::memory_order_relaxed);
+}
+
+void ProtocolTrace::clear()
+{
+    base.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const char* ProtocolTrace::typeName(uint8_t type)
+{
+    switch (type)
+    {
+        case SyncFound:
+            return "Sync Found";
+        case SyncLost:
+            return "Sync Lost";
+        case ChecksumFailure:
+            return "Checksum Failure";
+        case FrameSizeError:
+            return "Frame Size Error";
+        case DecodeError:
+            return "Decode Error";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,105 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROTOCOLTRACE_H
+#define PROTOCOLTRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * Fixed size ring of binary protocol events (sync found/lost, bad
+ * frames etc.) recorded by readers in debug mode.
+ *
+ * Recording is lock-free and doesn't allocate or format anything, so
+ * it can be done from the hot path of a reader on any thread. Oldest
+ * events are overwritten when the ring is full. Events are decoded
+ * only when displayed (see `ProtocolTraceView`).
+ */
+class ProtocolTrace
+{
+public:
+    enum EventType : uint8_t
+    {
+        SyncFound,          ///< `value`: number of bytes skipped while hunting
+        SyncLost,           ///< `value`: sync position, `data`: received byte
+        ChecksumFailure,    ///< `value`: checksum size, `expected`, `received` checksums, `data`: frame
+        FrameSizeError,     ///< `value`: received size
+        DecodeError         ///< `value`: stuffed frame size, `data`: stuffed frame
+    };
+
+    /// Maximum number of frame bytes stored with an event
+    enum {MaxDataSize = 64};
+
+    struct Event
+    {
+        qint64 time;        ///< milliseconds since epoch
+        quint64 offset;     ///< byte offset in the stream (of frame start)
+        uint32_t value;
+        uint32_t expected;
+        uint32_t received;
+        uint16_t frameSize; ///< actual size of the frame, `data` may be truncated
+        uint8_t type;
+        uint8_t dataSize;
+        uint8_t data[MaxDataSize];
+    };
+
+    /// Number of events kept
+    enum {Capacity = 4096};
+
+    static ProtocolTrace& instance();
+
+    /**
+     * Records an event. `data` is truncated to `MaxDataSize`.
+     *
+     * @param size size of data, frame size of the event
+     */
+    void record(EventType type, quint64 offset, uint32_t value,
+                const uint8_t* data = nullptr, unsigned size = 0,
+                uint32_t expected = 0, uint32_t received = 0);
+
+    /// Returns recorded events, oldest first
+    QVector<Event> events() const;
+    /// Total number of events recorded since last clear (including overwritten)
+    quint64 count() const;
+    /// Discards all events
+    void clear();
+
+    /// Returns name of an event type
+    static const char* typeName(uint8_t type);
+
+private:
+    /// Events are published with sequence numbers, a reader discards
+    /// a slot if it's being (over)written while copying
+    struct Slot
+    {
+        std::atomic<quint64> seq;
+        Event event;
+    };
+
+    ProtocolTrace();
+
+    Slot ring[Capacity];
+    std::atomic<quint64> head;  ///< index of next event
+    std::atomic<quint64> base;  ///< events before this are cleared
+};
+
+#endif // PROTOCOLTRACE_H
@@ -0,0 +1,266 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QAbstractTableModel>
+#include <QDateTime>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QScrollBar>
+#include <QTextStream>
+#include <QVBoxLayout>
+
+#include "protocoltraceview.h"
+
+/// Event list update interval in milliseconds
+#define UPDATE_INTERVAL 500
+
+enum Column {ColTime, ColOffset, ColEvent, ColDetails, ColData, NumColumns};
+
+/// Formats bytes as space separated hex
+static QString hexString(const uint8_t* data, unsigned size)
+{
+    return QByteArray((const char*) data, size).toHex(' ').toUpper();
+}
+
+/// Formats a checksum value of given size (in bytes) as hex
+static QString checksumString(uint32_t value, unsigned size)
+{
+    return QString("0x%1").arg(value, size * 2, 16, QChar('0')).toUpper();
+}
+
+static QString eventTime(const ProtocolTrace::Event& e)
+{
+    return QDateTime::fromMSecsSinceEpoch(e.time).toString("yyyy-MM-dd HH:mm:ss.zzz");
+}
+
+/// Events of frames that are discarded
+static bool isBadFrame(const ProtocolTrace::Event& e)
+{
+    return e.type == ProtocolTrace::ChecksumFailure ||
+        e.type == ProtocolTrace::FrameSizeError ||
+        e.type == ProtocolTrace::DecodeError;
+}
+
+/// Table model of a copy of trace events, decodes events on display
+class ProtocolTraceModel : public QAbstractTableModel
+{
+public:
+    explicit ProtocolTraceModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+    void setEvents(QVector<ProtocolTrace::Event> events)
+    {
+        beginResetModel();
+        _events = events;
+        endResetModel();
+    }
+
+    const QVector<ProtocolTrace::Event>& events() const {return _events;}
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : _events.size();
+    }
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : NumColumns;
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override
+    {
+        if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+        switch (section)
+        {
+            case ColTime: return tr("Time");
+            case ColOffset: return tr("Offset");
+            case ColEvent: return tr("Event");
+            case ColDetails: return tr("Details");
+            case ColData: return tr("Data");
+        }
+        return QVariant();
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override
+    {
+        if (!index.isValid() || role != Qt::DisplayRole) return QVariant();
+
+        auto& e = _events[index.row()];
+        switch (index.column())
+        {
+            case ColTime: return eventTime(e);
+            case ColOffset: return QString::number(e.offset);
+            case ColEvent: return QString(ProtocolTrace::typeName(e.type));
+            case ColDetails: return details(e);
+            case ColData:
+            {
+                QString str = hexString(e.data, e.dataSize);
+                if (e.dataSize < e.frameSize) str += " ...";
+                return str;
+            }
+        }
+        return QVariant();
+    }
+
+private:
+    QVector<ProtocolTrace::Event> _events;
+
+    static QString details(const ProtocolTrace::Event& e)
+    {
+        switch (e.type)
+        {
+            case ProtocolTrace::SyncFound:
+                return tr("%1 bytes skipped").arg(e.value);
+            case ProtocolTrace::SyncLost:
+                return tr("Mismatch at sync position %1").arg(e.value);
+            case ProtocolTrace::ChecksumFailure:
+                return tr("Expected: %1 Received: %2, %3 bytes")
+                    .arg(checksumString(e.expected, e.value))
+                    .arg(checksumString(e.received, e.value))
+                    .arg(e.frameSize);
+            case ProtocolTrace::FrameSizeError:
+                return tr("Invalid size %1").arg(e.value);
+            case ProtocolTrace::DecodeError:
+                return tr("Invalid byte stuffing, %1 bytes").arg(e.value);
+        }
+        return QString();
+    }
+};
+
+ProtocolTraceView::ProtocolTraceView(QWidget* parent) :
+    QWidget(parent, Qt::Window)
+{
+    lastCount = 0;
+    setWindowTitle(tr("Protocol Trace"));
+    resize(800, 400);
+
+    model = new ProtocolTraceModel(this);
+    table.setModel(model);
+    table.verticalHeader()->hide();
+    table.horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    table.horizontalHeader()->setStretchLastSection(true);
+    table.setSelectionBehavior(QAbstractItemView::SelectRows);
+    table.setWordWrap(false);
+
+    pbClear.setText(tr("Clear"));
+    spNumFrames.setRange(1, ProtocolTrace::Capacity);
+    spNumFrames.setValue(100);
+    spNumFrames.setPrefix(tr("Last "));
+    spNumFrames.setSuffix(tr(" bad frames"));
+    pbExport.setText(tr("Export..."));
+
+    auto buttons = new QHBoxLayout();
+    buttons->addWidget(&lCount, 1);
+    buttons->addWidget(&pbClear);
+    buttons->addWidget(&spNumFrames);
+    buttons->addWidget(&pbExport);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addWidget(&table, 1);
+    layout->addLayout(buttons);
+
+    connect(&updateTimer, &QTimer::timeout, this, &ProtocolTraceView::updateEvents);
+    connect(&pbClear, &QPushButton::clicked, this, &ProtocolTraceView::onClear);
+    connect(&pbExport, &QPushButton::clicked, this, &ProtocolTraceView::onExport);
+}
+
+void ProtocolTraceView::showEvent(QShowEvent* event)
+{
+    // only update while visible, to not cost anything otherwise
+    lastCount = ~0ull;
+    updateEvents();
+    updateTimer.start(UPDATE_INTERVAL);
+    QWidget::showEvent(event);
+}
+
+void ProtocolTraceView::hideEvent(QHideEvent* event)
+{
+    updateTimer.stop();
+    QWidget::hideEvent(event);
+}
+
+void ProtocolTraceView::updateEvents()
+{
+    auto& trace = ProtocolTrace::instance();
+    quint64 count = trace.count();
+    if (count == lastCount) return;
+    lastCount = count;
+
+    // keep the view at the end if it was already
+    auto scrollBar = table.verticalScrollBar();
+    bool atEnd = scrollBar->value() == scrollBar->maximum();
+
+    model->setEvents(trace.events());
+    lCount.setText(tr("%1 events recorded, %2 displayed")
+                   .arg(count).arg(model->rowCount()));
+
+    if (atEnd) table.scrollToBottom();
+}
+
+void ProtocolTraceView::onClear()
+{
+    ProtocolTrace::instance().clear();
+    updateEvents();
+}
+
+void ProtocolTraceView::onExport()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export Bad Frames"), QString(),
+                                                    tr("CSV Files (*.csv)"));
+    if (fileName.isEmpty()) return;
+    if (QFileInfo(fileName).suffix().isEmpty()) fileName += ".csv";
+
+    // find the last N bad frames
+    auto events = ProtocolTrace::instance().events();
+    int first = events.size();
+    for (int n = 0; first > 0 && n < spNumFrames.value();)
+    {
+        if (isBadFrame(events[--first])) n++;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        QMessageBox::critical(this, tr("Error"),
+                              tr("Failed to export frames: %1").arg(file.errorString()));
+        return;
+    }
+
+    QTextStream out(&file);
+    out << "time,offset,event,expected,received,frame_size,frame\n";
+    for (int i = first; i < events.size(); i++)
+    {
+        auto& e = events[i];
+        if (!isBadFrame(e)) continue;
+
+        // only checksum failures have a checksum to compare
+        bool hasChecksum = e.type == ProtocolTrace::ChecksumFailure;
+        out << eventTime(e) << ','
+            << e.offset << ','
+            << ProtocolTrace::typeName(e.type) << ','
+            << (hasChecksum ? checksumString(e.expected, e.value) : QString()) << ','
+            << (hasChecksum ? checksumString(e.received, e.value) : QString()) << ','
+            << e.frameSize << ','
+            << hexString(e.data, e.dataSize) << '\n';
+    }
+}
@@ -0,0 +1,68 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROTOCOLTRACEVIEW_H
+#define PROTOCOLTRACEVIEW_H
+
+#include <QWidget>
+#include <QTableView>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QLabel>
+#include <QTimer>
+
+#include "protocoltrace.h"
+
+class ProtocolTraceModel;
+
+/**
+ * Displays events of `ProtocolTrace` and exports last bad frames.
+ *
+ * Events are copied from the trace only while the view is visible and
+ * they are formatted only when a row is displayed.
+ */
+class ProtocolTraceView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ProtocolTraceView(QWidget* parent = 0);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    ProtocolTraceModel* model;
+    QTableView table;
+    QLabel lCount;
+    QPushButton pbClear;
+    QSpinBox spNumFrames;
+    QPushButton pbExport;
+    QTimer updateTimer;
+    quint64 lastCount; ///< `ProtocolTrace::count()` at last update
+
+private slots:
+    void updateEvents();
+    void onClear();
+    /// Exports last N rejected frames as CSV
+    void onExport();
+};
+
+#endif // PROTOCOLTRACEVIEW_H
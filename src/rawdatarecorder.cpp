@@ -18,6 +18,8 @@
 */
 
 #include "rawdatarecorder.h"
+#include "metrics.h"
+#include "tracer.h"
 #include <QDebug>
 
 RawDataRecorder::RawDataRecorder(QObject *parent)
@@ -83,6 +85,10 @@ void RawDataRecorder::onDataReceived(const QByteArray& data)
         return;
     }
 
+    static MetricHistogram& recordTime = Metrics::instance().histogram("record.raw_time");
+    MetricTimer timer(recordTime);
+    TRACE_SCOPE("RawDataRecorder::write");
+
     qint64 written = file.write(data);
     if (written == -1)
     {
@@ -349,6 +349,7 @@ bool RecordPanel::startRecording(QString fileName)
     if (ui->cbWriteHeader->isChecked())
     {
         channelNames = _stream->infoModel()->channelNames();
+        if (_stream->hasX()) channelNames.prepend("x");
     }
 
     if (recorder.startRecording(fileName, getSeparator(), channelNames, currentTimestampOption()))
@@ -440,6 +441,7 @@ void RecordPanel::startRecording()
             if (ui->cbWriteHeader->isChecked())
             {
                 channelNames = _stream->infoModel()->channelNames();
+                if (_stream->hasX()) channelNames.prepend("x");
             }
 
             csvStarted = recorder.startRecording(finalCsvFile, getSeparator(), channelNames, currentTimestampOption());
@@ -0,0 +1,226 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QtDebug>
+
+#include "replaydevice.h"
+
+/// Replay timer interval in milliseconds when speed is limited
+#define TICK_INTERVAL 10
+/// Maximum number of bytes released at each tick
+#define MAX_CHUNK_SIZE (1024*1024)
+
+ReplayDevice::ReplayDevice(QObject* parent) :
+    QIODevice(parent)
+{
+    map = nullptr;
+    size = 0;
+    readPos = 0;
+    released = 0;
+    credit = 0;
+    byteRate = 11520;           // 115200 baud, 8N1
+    _speed = 1;
+
+    connect(&timer, &QTimer::timeout, this, &ReplayDevice::onTick);
+}
+
+ReplayDevice::~ReplayDevice()
+{
+    unload();
+}
+
+bool ReplayDevice::load(const QString& fileName)
+{
+    unload();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        setErrorString(file.errorString());
+        return false;
+    }
+
+    size = file.size();
+    if (size > 0)
+    {
+        map = file.map(0, size);
+        if (map == nullptr)
+        {
+            setErrorString(file.errorString());
+            file.close();
+            size = 0;
+            return false;
+        }
+    }
+
+    readPos = 0;
+    released = 0;
+    credit = 0;
+    return open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void ReplayDevice::unload()
+{
+    pause();
+
+    if (isOpen()) close();
+    if (map != nullptr)
+    {
+        file.unmap(const_cast<uchar*>(map));
+        map = nullptr;
+    }
+    if (file.isOpen()) file.close();
+
+    size = 0;
+    readPos = 0;
+    released = 0;
+}
+
+bool ReplayDevice::isLoaded() const
+{
+    return file.isOpen();
+}
+
+QString ReplayDevice::fileName() const
+{
+    return file.fileName();
+}
+
+qint64 ReplayDevice::captureSize() const
+{
+    return size;
+}
+
+qint64 ReplayDevice::replayPosition() const
+{
+    return released;
+}
+
+bool ReplayDevice::isPlaying() const
+{
+    return timer.isActive();
+}
+
+void ReplayDevice::setByteRate(double bytesPerSecond)
+{
+    Q_ASSERT(bytesPerSecond > 0);
+    byteRate = bytesPerSecond;
+}
+
+void ReplayDevice::setSpeed(double speed)
+{
+    Q_ASSERT(speed >= 0);
+    _speed = speed;
+    credit = 0;
+    if (isPlaying()) updateTimer();
+}
+
+bool ReplayDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 ReplayDevice::bytesAvailable() const
+{
+    return (released - readPos) + QIODevice::bytesAvailable();
+}
+
+void ReplayDevice::play()
+{
+    if (!isLoaded() || isPlaying()) return;
+
+    if (released == size) jump(0);
+
+    credit = 0;
+    clock.start();
+    updateTimer();
+    emit playingChanged(true);
+}
+
+void ReplayDevice::pause()
+{
+    if (!isPlaying()) return;
+
+    timer.stop();
+    emit playingChanged(false);
+}
+
+void ReplayDevice::jump(qint64 position)
+{
+    position = qBound(qint64(0), position, size);
+    readPos = position;
+    released = position;
+    credit = 0;
+    emit replayPositionChanged(released);
+}
+
+void ReplayDevice::updateTimer()
+{
+    timer.start(_speed == MaxSpeed ? 0 : TICK_INTERVAL);
+}
+
+void ReplayDevice::onTick()
+{
+    qint64 n;
+    if (_speed == MaxSpeed)
+    {
+        n = MAX_CHUNK_SIZE;
+    }
+    else
+    {
+        credit += byteRate * _speed * clock.nsecsElapsed() / 1e9;
+        clock.restart();
+        // don't let a stalled event loop build up a burst
+        credit = qMin(credit, double(MAX_CHUNK_SIZE));
+        n = qint64(credit);
+        credit -= n;
+    }
+
+    n = qMin(n, size - released);
+    if (n > 0)
+    {
+        released += n;
+        emit readyRead();
+        emit replayPositionChanged(released);
+    }
+
+    if (released == size)
+    {
+        pause();
+        emit replayFinished();
+    }
+}
+
+qint64 ReplayDevice::readData(char* data, qint64 maxSize)
+{
+    qint64 n = qMin(maxSize, released - readPos);
+    if (n <= 0) return 0;
+
+    memcpy(data, map + readPos, n);
+    readPos += n;
+    return n;
+}
+
+qint64 ReplayDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
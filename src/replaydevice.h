@@ -0,0 +1,126 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYDEVICE_H
+#define REPLAYDEVICE_H
+
+#include <QIODevice>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * A read only, sequential device that replays a raw capture file
+ * (as recorded by `RawDataRecorder`).
+ *
+ * Capture file is memory mapped. Bytes are released to the reader
+ * gradually with a timer, either at a rate relative to real time or as
+ * fast as the reader can consume them. `readyRead` is signaled for
+ * each released chunk, just like a serial port would.
+ */
+class ReplayDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    /// Speed value for releasing data as fast as possible
+    enum Speed {MaxSpeed = 0};
+
+    explicit ReplayDevice(QObject* parent = 0);
+    ~ReplayDevice();
+
+    /**
+     * Maps the capture file and opens the device. Previously loaded
+     * file is unloaded. Returns false on error, see `errorString()`.
+     */
+    bool load(const QString& fileName);
+    /// Stops the replay, unmaps the file and closes the device
+    void unload();
+    /// Returns true if a capture file is loaded
+    bool isLoaded() const;
+    /// Name of the loaded capture file
+    QString fileName() const;
+    /// Size of the loaded capture in bytes
+    qint64 captureSize() const;
+    /// Number of bytes released so far
+    qint64 replayPosition() const;
+    /// Returns true while replaying
+    bool isPlaying() const;
+
+    /**
+     * Sets the real time (1×) data rate in bytes per second. This
+     * should match the rate capture was made with, for a serial port
+     * with 8N1 settings it's baud rate / 10.
+     */
+    void setByteRate(double bytesPerSecond);
+    /**
+     * Sets replay speed as a multiple of the byte rate. Use
+     * `MaxSpeed` to release data as fast as reader consumes it.
+     */
+    void setSpeed(double speed);
+    /// Returns replay speed
+    double speed() const {return _speed;}
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+
+public slots:
+    /// Starts or continues the replay, restarts if it has finished
+    void play();
+    /// Pauses the replay
+    void pause();
+    /// Continues from given position, discarding not yet read data
+    void jump(qint64 position);
+
+signals:
+    /// Emitted periodically while replaying, `position` is in bytes
+    void replayPositionChanged(qint64 position);
+    /// Emitted when replay starts or stops
+    void playingChanged(bool playing);
+    /// All of the capture is released
+    void replayFinished();
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QFile file;
+    const uchar* map;
+    qint64 size;
+    /// Position of the next byte to be read
+    qint64 readPos;
+    /// End of the released (readable) data
+    qint64 released;
+    /// Fractional bytes not released yet, carried between ticks
+    double credit;
+    double byteRate;
+    double _speed;
+
+    QTimer timer;
+    QElapsedTimer clock;
+
+    /// Updates timer interval according to speed
+    void updateTimer();
+
+private slots:
+    void onTick();
+};
+
+#endif // REPLAYDEVICE_H
@@ -0,0 +1,188 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QMessageBox>
+
+#include "replaypanel.h"
+#include "setting_defines.h"
+
+/// Slider resolution
+#define SLIDER_MAX 1000
+
+ReplayPanel::ReplayPanel(ReplayDevice* device, QWidget* parent) :
+    QWidget(parent)
+{
+    _device = device;
+
+    leFile.setReadOnly(true);
+    leFile.setPlaceholderText(tr("Select a raw capture file"));
+    pbBrowse.setText(tr("Browse..."));
+    cbEnable.setText(tr("Replay as input"));
+    cbEnable.setToolTip(tr("Read data from the capture file instead of the serial port"));
+
+    cbSpeed.addItem("1×", 1.);
+    cbSpeed.addItem("2×", 2.);
+    cbSpeed.addItem("5×", 5.);
+    cbSpeed.addItem("10×", 10.);
+    cbSpeed.addItem("100×", 100.);
+    cbSpeed.addItem(tr("Max"), double(ReplayDevice::MaxSpeed));
+    cbSpeed.setToolTip(tr("Max: release data as fast as it can be decoded"));
+
+    spBaudRate.setRange(50, 100000000);
+    spBaudRate.setValue(115200);
+    spBaudRate.setToolTip(tr("Baud rate the capture was made with (8N1), defines 1× speed"));
+
+    pbPlay.setText(tr("Play"));
+    pbPlay.setCheckable(true);
+    pbPlay.setEnabled(false);
+    slPosition.setOrientation(Qt::Horizontal);
+    slPosition.setRange(0, SLIDER_MAX);
+    slPosition.setEnabled(false);
+
+    auto fileLayout = new QHBoxLayout();
+    fileLayout->addWidget(&leFile, 1);
+    fileLayout->addWidget(&pbBrowse);
+    fileLayout->addWidget(&cbEnable);
+
+    auto speedLayout = new QHBoxLayout();
+    speedLayout->addWidget(&cbSpeed);
+    speedLayout->addWidget(new QLabel(tr("Baud Rate:")));
+    speedLayout->addWidget(&spBaudRate);
+    speedLayout->addStretch();
+
+    auto playLayout = new QHBoxLayout();
+    playLayout->addWidget(&pbPlay);
+    playLayout->addWidget(&slPosition, 1);
+    playLayout->addWidget(&lPosition);
+
+    auto layout = new QFormLayout(this);
+    layout->addRow(tr("Capture:"), fileLayout);
+    layout->addRow(tr("Speed:"), speedLayout);
+    layout->addRow(tr("Replay:"), playLayout);
+
+    connect(&pbBrowse, &QPushButton::clicked, this, &ReplayPanel::onBrowse);
+    connect(&cbEnable, &QCheckBox::toggled, this, &ReplayPanel::inputEnabledChanged);
+    connect(&cbSpeed, &QComboBox::currentIndexChanged, this, &ReplayPanel::onSpeedChanged);
+    connect(&spBaudRate, &QSpinBox::valueChanged, this, &ReplayPanel::onSpeedChanged);
+    connect(&pbPlay, &QPushButton::toggled, this, &ReplayPanel::onPlayToggled);
+    connect(&slPosition, &QSlider::sliderReleased, this, &ReplayPanel::onSliderReleased);
+
+    connect(_device, &ReplayDevice::replayPositionChanged, this, &ReplayPanel::updatePosition);
+    connect(_device, &ReplayDevice::playingChanged, [this](bool playing)
+            {
+                pbPlay.setChecked(playing);
+                pbPlay.setText(playing ? tr("Pause") : tr("Play"));
+            });
+
+    onSpeedChanged();
+    updatePosition(0);
+}
+
+bool ReplayPanel::isInputEnabled() const
+{
+    return cbEnable.isChecked();
+}
+
+bool ReplayPanel::loadFile(QString fileName)
+{
+    bool ok = _device->load(fileName);
+    if (!ok)
+    {
+        QMessageBox::warning(this, tr("Replay"),
+                             tr("Couldn't load capture file \"%1\":\n%2")
+                             .arg(fileName, _device->errorString()));
+    }
+
+    leFile.setText(ok ? fileName : QString());
+    pbPlay.setEnabled(ok);
+    slPosition.setEnabled(ok);
+    updatePosition(0);
+    return ok;
+}
+
+void ReplayPanel::onBrowse()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Open Raw Capture"), leFile.text(),
+        tr("Binary Files (*.bin);;All Files (*)"));
+
+    if (!fileName.isEmpty()) loadFile(fileName);
+}
+
+void ReplayPanel::onSpeedChanged()
+{
+    _device->setByteRate(spBaudRate.value() / 10.);
+    _device->setSpeed(cbSpeed.currentData().toDouble());
+    spBaudRate.setEnabled(cbSpeed.currentData().toDouble() != ReplayDevice::MaxSpeed);
+}
+
+void ReplayPanel::onPlayToggled(bool checked)
+{
+    if (checked)
+    {
+        _device->play();
+    }
+    else
+    {
+        _device->pause();
+    }
+}
+
+void ReplayPanel::onSliderReleased()
+{
+    _device->jump(_device->captureSize() * slPosition.value() / SLIDER_MAX);
+}
+
+void ReplayPanel::updatePosition(qint64 position)
+{
+    qint64 size = _device->captureSize();
+    if (!slPosition.isSliderDown())
+    {
+        slPosition.setValue(size ? position * SLIDER_MAX / size : 0);
+    }
+    lPosition.setText(QString("%1 / %2 KiB").arg(position / 1024).arg(size / 1024));
+}
+
+void ReplayPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Replay);
+    settings->setValue(SG_Replay_File, leFile.text());
+    settings->setValue(SG_Replay_Speed, cbSpeed.currentText());
+    settings->setValue(SG_Replay_BaudRate, spBaudRate.value());
+    settings->endGroup();
+}
+
+void ReplayPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Replay);
+
+    int speedIndex = cbSpeed.findText(settings->value(SG_Replay_Speed).toString());
+    if (speedIndex >= 0) cbSpeed.setCurrentIndex(speedIndex);
+    spBaudRate.setValue(settings->value(SG_Replay_BaudRate, spBaudRate.value()).toInt());
+
+    // don't complain if capture file is gone since last run
+    QString fileName = settings->value(SG_Replay_File).toString();
+    if (QFileInfo::exists(fileName)) loadFile(fileName);
+
+    settings->endGroup();
+}
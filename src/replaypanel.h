@@ -0,0 +1,82 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPLAYPANEL_H
+#define REPLAYPANEL_H
+
+#include <QWidget>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSettings>
+
+#include "replaydevice.h"
+
+/**
+ * Controls replaying of a raw capture file. When replay is enabled
+ * as input, data format panel reads from the replay device instead
+ * of the serial port.
+ */
+class ReplayPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ReplayPanel(ReplayDevice* device, QWidget* parent = 0);
+
+    /// Returns true if replay is selected as input
+    bool isInputEnabled() const;
+
+    /// Stores replay settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads replay settings from a `QSettings`
+    void loadSettings(QSettings* settings);
+
+signals:
+    /// Replay device is selected/deselected as input
+    void inputEnabledChanged(bool enabled);
+
+private:
+    ReplayDevice* _device;
+
+    QLineEdit leFile;
+    QPushButton pbBrowse;
+    QCheckBox cbEnable;
+    QComboBox cbSpeed;
+    QSpinBox spBaudRate;
+    QPushButton pbPlay;
+    QSlider slPosition;
+    QLabel lPosition;
+
+    /// Loads the capture file, shows a warning on error
+    bool loadFile(QString fileName);
+    void updatePosition(qint64 position);
+
+private slots:
+    void onBrowse();
+    void onSpeedChanged();
+    void onPlayToggled(bool checked);
+    void onSliderReleased();
+};
+
+#endif // REPLAYPANEL_H
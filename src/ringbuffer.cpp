@@ -18,12 +18,14 @@
 */
 
 #include <QtGlobal>
+#include <cstring>
 
 #include "ringbuffer.h"
 
 RingBuffer::RingBuffer(unsigned n)
 {
     _size = n;
+    _capacity = n;
     data = new double[_size]();
     headIndex = 0;
 
@@ -58,36 +60,93 @@ void RingBuffer::resize(unsigned n)
 {
     Q_ASSERT(n != _size);
 
-    int offset = (int) n - (int) _size;
-    if (offset == 0) return;
+    if (n == _size) return;
 
-    double* newData = new double[n];
+    if (n < _size)
+    {
+        shrink(n);
+    }
+    else
+    {
+        grow(n);
+    }
 
-    // move data to new array
-    int fill_start = offset > 0 ? offset : 0;
+    // invalidate bounding rectangle
+    limInvalid = true;
+}
+
+void RingBuffer::shrink(unsigned n)
+{
+    // Newest `n` samples are kept. They end at `headIndex` (exclusive) and
+    // may wrap around the end of the array.
+    unsigned start = (headIndex + _size - n) % _size;
 
-    for (int i = fill_start; i < int(n); i++)
+    if (start + n <= _size) // kept samples are contiguous
     {
-        newData[i] = sample(i - offset);
+        memmove(data, data + start, sizeof(double) * n);
+        headIndex = 0;
+    }
+    else
+    {
+        // older part is at the end of the array, newer part is at
+        // [0, headIndex); slide older part to sit right after it
+        unsigned olderLen = _size - start;
+        memmove(data + headIndex, data + start, sizeof(double) * olderLen);
     }
+    _size = n;
 
-    // fill the beginning of the new data
-    if (fill_start > 0)
+    // release memory if most of the allocation is wasted, copying is cheap
+    // at this point since only the (small) remaining data is moved
+    if (_size < _capacity / 4)
     {
-        for (int i = 0; i < fill_start; i++)
-        {
-            newData[i] = 0;
-        }
+        realloc(_size);
+    }
+}
+
+void RingBuffer::grow(unsigned n)
+{
+    unsigned offset = n - _size; // number of zeros to insert at the beginning
+
+    if (n <= _capacity)
+    {
+        // in place: move the older part to the end of the enlarged ring and
+        // fill the gap with zeros, newer part at [0, headIndex) stays put
+        unsigned olderLen = _size - headIndex;
+        memmove(data + headIndex + offset, data + headIndex, sizeof(double) * olderLen);
+        memset(data + headIndex, 0, sizeof(double) * offset);
+        _size = n;
+    }
+    else
+    {
+        double* newData = new double[n];
+        unsigned olderLen = _size - headIndex;
+
+        memset(newData, 0, sizeof(double) * offset);
+        memcpy(newData + offset, data + headIndex, sizeof(double) * olderLen);
+        memcpy(newData + offset + olderLen, data, sizeof(double) * headIndex);
+
+        delete[] data;
+        data = newData;
+        _capacity = n;
+        _size = n;
+        headIndex = 0;
     }
+}
+
+void RingBuffer::realloc(unsigned n)
+{
+    Q_ASSERT(n >= _size);
 
-    // data is ready, clean up and re-point
-    delete data;
+    double* newData = new double[n];
+    unsigned olderLen = _size - headIndex;
+
+    memcpy(newData, data + headIndex, sizeof(double) * olderLen);
+    memcpy(newData + olderLen, data, sizeof(double) * headIndex);
+
+    delete[] data;
     data = newData;
+    _capacity = n;
     headIndex = 0;
-    _size = n;
-
-    // invalidate bounding rectangle
-    limInvalid = true;
 }
 
 void RingBuffer::addSamples(double* samples, unsigned n)
@@ -142,10 +201,7 @@ void RingBuffer::addSamples(double* samples, unsigned n)
 
 void RingBuffer::clear()
 {
-    for (unsigned i=0; i < _size; i++)
-    {
-        data[i] = 0.;
-    }
+    memset(data, 0, sizeof(double) * _size);
 
     limCache = {0, 0};
     limInvalid = false;
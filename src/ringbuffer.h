@@ -22,7 +22,12 @@
 
 #include "framebuffer.h"
 
-/// A fast buffer implementation for storing data.
+/**
+ * A fast buffer implementation for storing data.
+ *
+ * Resizing doesn't copy samples one by one. When shrinking, storage is
+ * re-used in place and released only if most of it would be wasted.
+ */
 class RingBuffer : public WFrameBuffer
 {
 public:
@@ -37,10 +42,18 @@ public:
     virtual void clear();
 
 private:
-    unsigned _size;            ///< size of `data`
+    unsigned _size;            ///< size of the ring
+    unsigned _capacity;        ///< allocated size of `data`, >= `_size`
     double* data;              ///< storage
     unsigned headIndex;        ///< indicates the actual `0` index of the ring buffer
 
+    /// Keeps the newest `n` samples, in place
+    void shrink(unsigned n);
+    /// Inserts zeros to the beginning to reach size `n`
+    void grow(unsigned n);
+    /// Moves data to a new array of `n` capacity, unwraps the ring
+    void realloc(unsigned n);
+
     mutable bool limInvalid;   ///< Indicates that limits needs to be re-calculated
     mutable Range limCache;    ///< Cache for limits()
     void updateLimits() const; ///< Updates limits cache
@@ -17,12 +17,11 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <QDateTime>
 #include "samplecounter.h"
 
 SampleCounter::SampleCounter()
 {
-    prevTimeMs = QDateTime::currentMSecsSinceEpoch();
+    clock.start();
     count = 0;
 }
 
@@ -32,13 +31,13 @@ void SampleCounter::feedIn(const SamplePack& data)
 {
     count += data.numSamples();
 
-    qint64 current = QDateTime::currentMSecsSinceEpoch();
-    auto diff = current - prevTimeMs;
+    // monotonic clock, much cheaper than reading the wall clock
+    auto diff = clock.elapsed();
     if (diff > 1000) // 1sec
     {
         emit spsChanged(1000 * float(count) / diff);
 
-        prevTimeMs = current;
+        clock.restart();
         count = 0;
     }
 }
@@ -21,6 +21,7 @@
 #define SAMPLECOUNTER_H
 
 #include <QObject>
+#include <QElapsedTimer>
 #include "sink.h"
 
 /// A `Sink` class for counting and reporting number of samples per second.
@@ -40,7 +41,7 @@ signals:
     void spsChanged(float value);
 
 private:
-    qint64 prevTimeMs;
+    QElapsedTimer clock;
     unsigned count;
 };
 
@@ -28,6 +28,7 @@ SamplePack::SamplePack(unsigned ns, unsigned nc, bool x)
 
     _numSamples = ns;
     _numChannels = nc;
+    _ownsData = true;
 
     _yData = new double[_numSamples * _numChannels]();
     if (x)
@@ -49,8 +50,29 @@ SamplePack::SamplePack(const SamplePack& other) :
     memcpy(_yData, other._yData, dataSize * numChannels());
 }
 
+SamplePack::SamplePack(unsigned ns, unsigned nc, double* x, double* y)
+{
+    _numSamples = ns;
+    _numChannels = nc;
+    _xData = x;
+    _yData = y;
+    _ownsData = false;
+}
+
+SamplePack SamplePack::firstChannelAsX(const SamplePack& other)
+{
+    Q_ASSERT(other.numChannels() > 1 && !other.hasX());
+
+    // channels are stored consecutively, first channel is followed by the rest
+    double* x = other._yData;
+    return SamplePack(other.numSamples(), other.numChannels()-1,
+                      x, x + other.numSamples());
+}
+
 SamplePack::~SamplePack()
 {
+    if (!_ownsData) return;
+
     delete[] _yData;
     if (_xData != nullptr)
     {
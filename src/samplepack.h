@@ -32,6 +32,15 @@ public:
     SamplePack(const SamplePack& other);
     ~SamplePack();
 
+    /**
+     * Returns a pack that uses the first channel of `other` as X data
+     * and the rest as Y data. Data isn't copied, returned pack refers to
+     * the storage of `other` thus it must not outlive `other`.
+     *
+     * @note `other` must have at least 2 channels and no X.
+     */
+    static SamplePack firstChannelAsX(const SamplePack& other);
+
     bool hasX() const;
     unsigned numChannels() const;
     unsigned numSamples() const;
@@ -45,6 +54,10 @@ private:
     unsigned _numSamples, _numChannels;
     double* _xData;
     double* _yData;
+    bool _ownsData;  ///< `false` if data belongs to another pack
+
+    /// Creates a pack that refers to given data without owning it
+    SamplePack(unsigned ns, unsigned nc, double* x, double* y);
 };
 
 #endif // SAMPLEPACK_H
@@ -31,6 +31,10 @@ const char SettingGroup_Plot[] = "Plot";
 const char SettingGroup_Commands[] = "Commands";
 const char SettingGroup_Record[] = "Record";
 const char SettingGroup_TextView[] = "TextView";
+const char SettingGroup_Trigger[] = "Trigger";
+const char SettingGroup_MultiPort[] = "MultiPort";
+const char SettingGroup_Replay[] = "Replay";
+const char SettingGroup_Source[] = "Source";
 const char SettingGroup_UpdateCheck[] = "UpdateCheck";
 
 // mainwindow setting keys
@@ -51,6 +55,7 @@ const char SG_Port_FlowControl[] = "flowControl";
 
 // data format panel keys
 const char SG_DataFormat_Format[] = "format";
+const char SG_DataFormat_FirstChannelAsX[] = "firstChannelAsX";
 
 // binary stream reader keys
 const char SG_Binary_NumOfChannels[] = "numOfChannels";
@@ -64,10 +69,14 @@ const char SG_ASCII_CustomDelimiter[] = "customDelimiter";
 const char SG_ASCII_FilterMode[] = "filterMode";
 const char SG_ASCII_FilterPrefix[] = "filterPrefix";
 const char SG_ASCII_Hex[] = "hex";
+const char SG_ASCII_Keyed[] = "keyed";
+const char SG_ASCII_MissingKey[] = "missingKey";
+const char SG_ASCII_Keys[] = "keys";
 
 // framed reader keys
 const char SG_CustomFrame_NumOfChannels[] = "numOfChannels";
 const char SG_CustomFrame_FrameStart[] = "frameStart";
+const char SG_CustomFrame_Framing[] = "framing";
 const char SG_CustomFrame_SizeFieldType[] = "fixedSize";
 const char SG_CustomFrame_FixedFrameSize[] = "frameSize";
 const char SG_CustomFrame_TotalFrameLength[] = "totalFrameLength";
@@ -79,13 +88,29 @@ const char SG_CustomFrame_ChecksumStartByte[] = "checksumStartByte";
 const char SG_CustomFrame_ChecksumEndByte[] = "checksumEndByte";
 const char SG_CustomFrame_ChecksumEndianness[] = "checksumEndianness";
 const char SG_CustomFrame_DebugMode[] = "debugMode";
+const char SG_CustomFrame_LengthField[] = "lengthField";
+const char SG_CustomFrame_LengthFieldOffset[] = "lengthFieldOffset";
+const char SG_CustomFrame_LengthFieldWidth[] = "lengthFieldWidth";
+const char SG_CustomFrame_LengthFieldEndianness[] = "lengthFieldEndianness";
+const char SG_CustomFrame_LengthFieldCovers[] = "lengthFieldCovers";
+const char SG_CustomFrame_MessageId[] = "messageId";
+const char SG_CustomFrame_MessageIdOffset[] = "messageIdOffset";
+const char SG_CustomFrame_MessageIdWidth[] = "messageIdWidth";
+const char SG_CustomFrame_MessageIdEndianness[] = "messageIdEndianness";
+const char SG_CustomFrame_MessageLayouts[] = "messageLayouts";
+const char SG_CustomFrame_Layout[] = "layout";
+const char SG_CustomFrame_LayoutId[] = "id";
 const char SG_CustomFrame_ChannelMapping[] = "channelMapping";
+const char SG_CustomFrame_SamplesPerFrame[] = "samplesPerFrame";
 const char SG_CustomFrame_Channel[] = "ch";
 const char SG_CustomFrame_ChannelByteOffset[] = "offset";
 const char SG_CustomFrame_ChannelByteLength[] = "length";
 const char SG_CustomFrame_ChannelFormat[] = "format";
 const char SG_CustomFrame_ChannelEndianness[] = "endianness";
 const char SG_CustomFrame_ChannelEnabled[] = "enabled";
+const char SG_CustomFrame_ChannelBitOffset[] = "bitOffset";
+const char SG_CustomFrame_ChannelBitWidth[] = "bitWidth";
+const char SG_CustomFrame_ChannelStride[] = "stride";
 
 // channel info keys
 const char SG_Channels_Channel[] = "channel";
@@ -110,6 +135,8 @@ const char SG_Plot_DarkBackground[] = "darkBackground";
 const char SG_Plot_Grid[] = "grid";
 const char SG_Plot_MinorGrid[] = "minorGrid";
 const char SG_Plot_Legend[] = "legend";
+const char SG_Plot_RenderMode[] = "renderMode";
+const char SG_Plot_LaneView[] = "laneView";
 const char SG_Plot_LegendPos[] = "legendPos";
 const char SG_Plot_MultiPlot[] = "multiPlot";
 const char SG_Plot_Symbols[] = "symbols";
@@ -140,6 +167,28 @@ const char SG_Record_Decimals[]         = "decimals";
 const char SG_TextView_NumLines[] = "numLines";
 const char SG_TextView_Decimals[] = "decimals";
 
+// trigger settings keys
+const char SG_Trigger_Mode[]       = "mode";
+const char SG_Trigger_Type[]       = "type";
+const char SG_Trigger_Channel[]    = "channel";
+const char SG_Trigger_Level[]      = "level";
+const char SG_Trigger_WindowHigh[] = "windowHigh";
+const char SG_Trigger_Position[]   = "position";
+
+// multi port settings keys
+const char SG_MultiPort_NumSessions[] = "numSessions";
+const char SG_MultiPort_Port[]        = "port";
+const char SG_MultiPort_BaudRate[]    = "baudRate";
+
+// replay settings keys
+const char SG_Replay_File[]     = "file";
+const char SG_Replay_Speed[]    = "speed";
+const char SG_Replay_BaudRate[] = "baudRate";
+
+// source settings keys
+const char SG_Source_Type[]    = "type";
+const char SG_Source_Address[] = "address";
+
 // update check settings keys
 const char SG_UpdateCheck_Periodic[]  = "periodicCheck";
 const char SG_UpdateCheck_LastCheck[] = "lastCheck";
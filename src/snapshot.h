@@ -42,7 +42,7 @@ public:
     ~Snapshot();
 
     // TODO: yData and xData of snapshot shouldn't be public, preferable should be handled in constructor
-    QVector<IndexBuffer*> xData;
+    QVector<XFrameBuffer*> xData;
     QVector<ReadOnlyBuffer*> yData;
     QAction* showAction();
     QAction* deleteAction();
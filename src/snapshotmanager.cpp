@@ -27,9 +27,11 @@
 #include <QPointF>
 #include <QIcon>
 #include <QtDebug>
+#include <vector>
 
 #include "mainwindow.h"
 #include "snapshotmanager.h"
+#include "xringbuffer.h"
 
 SnapshotManager::SnapshotManager(MainWindow* mainWindow,
                                  Stream* stream) :
@@ -69,9 +71,30 @@ Snapshot* SnapshotManager::makeSnapshot() const
     QString name = QTime::currentTime().toString("'Snapshot ['HH:mm:ss']'");
     auto snapshot = new Snapshot(_mainWindow, name, *(_stream->infoModel()));
 
+    // X values are copied once and shared by all channels
+    XRingBuffer* xCopy = nullptr;
+    if (_stream->hasX() && _stream->numChannels())
+    {
+        auto xSrc = _stream->channel(0)->xData();
+        std::vector<double> xValues(xSrc->size());
+        for (unsigned i = 0; i < xValues.size(); i++)
+        {
+            xValues[i] = xSrc->sample(i);
+        }
+        xCopy = new XRingBuffer(xValues.size());
+        xCopy->addSamples(xValues.data(), xValues.size());
+    }
+
     for (unsigned ci = 0; ci < _stream->numChannels(); ci++)
     {
-        snapshot->xData.append(new IndexBuffer(_stream->numSamples()));
+        if (xCopy != nullptr)
+        {
+            snapshot->xData.append(xCopy);
+        }
+        else
+        {
+            snapshot->xData.append(new IndexBuffer(_stream->numSamples()));
+        }
         snapshot->yData.append(new ReadOnlyBuffer(_stream->channel(ci)->yData()));
     }
 
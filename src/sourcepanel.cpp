@@ -0,0 +1,164 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFormLayout>
+#include <QHBoxLayout>
+
+#include "sourcepanel.h"
+#include "setting_defines.h"
+
+const char* const typeSettingNames[] = {"tcp", "udp", "local", "pipe"};
+
+SourcePanel::SourcePanel(DataSource* source, QWidget* parent) :
+    QWidget(parent)
+{
+    _source = source;
+    lastBytes = 0;
+    lastPackets = 0;
+
+    cbType.addItems(DataSource::typeNames());
+    pbOpen.setText(tr("Open"));
+    pbOpen.setCheckable(true);
+    pbOpen.setToolTip(tr("While open, data is read from this source instead of the serial port"));
+
+    auto addressLayout = new QHBoxLayout();
+    addressLayout->addWidget(&cbType);
+    addressLayout->addWidget(&leAddress, 1);
+    addressLayout->addWidget(&pbOpen);
+
+    auto layout = new QFormLayout(this);
+    layout->addRow(tr("Source:"), addressLayout);
+    layout->addRow(tr("Status:"), &lStatus);
+    layout->addRow(tr("Received:"), &lCounters);
+
+    connect(&cbType, &QComboBox::currentIndexChanged, this, &SourcePanel::updatePlaceholder);
+    connect(&pbOpen, &QPushButton::toggled, this, &SourcePanel::onOpenToggled);
+    connect(_source, &DataSource::opened, this, &SourcePanel::onOpened);
+    connect(_source, &DataSource::closed, this, &SourcePanel::onClosed);
+    connect(&countersTimer, &QTimer::timeout, this, &SourcePanel::updateCounters);
+
+    updatePlaceholder();
+    lStatus.setText(tr("Closed"));
+    updateCounters();
+}
+
+void SourcePanel::updatePlaceholder()
+{
+    switch (cbType.currentIndex())
+    {
+        case DataSource::TcpClient:
+            leAddress.setPlaceholderText("localhost:5000");
+            break;
+        case DataSource::Udp:
+            leAddress.setPlaceholderText("5000");
+            break;
+        case DataSource::LocalSocket:
+            leAddress.setPlaceholderText(tr("socket name or path"));
+            break;
+        case DataSource::Pipe:
+            leAddress.setPlaceholderText(tr("path of a FIFO or file"));
+            break;
+    }
+}
+
+void SourcePanel::onOpenToggled(bool checked)
+{
+    if (checked)
+    {
+        if (_source->isOpen()) return;
+
+        lStatus.setText(tr("Opening..."));
+        cbType.setEnabled(false);
+        leAddress.setEnabled(false);
+        _source->open((DataSource::Type) cbType.currentIndex(), leAddress.text());
+    }
+    else
+    {
+        _source->close();
+    }
+}
+
+void SourcePanel::onOpened(bool success, QString error)
+{
+    if (success)
+    {
+        lStatus.setText(tr("Open"));
+        lastBytes = 0;
+        lastPackets = 0;
+        countersTimer.start(1000);
+    }
+    else
+    {
+        lStatus.setText(tr("Error: %1").arg(error));
+        cbType.setEnabled(true);
+        leAddress.setEnabled(true);
+        pbOpen.setChecked(false);
+    }
+}
+
+void SourcePanel::onClosed()
+{
+    countersTimer.stop();
+    updateCounters();
+    lStatus.setText(tr("Closed"));
+    cbType.setEnabled(true);
+    leAddress.setEnabled(true);
+    pbOpen.setChecked(false);
+}
+
+void SourcePanel::updateCounters()
+{
+    quint64 bytes = _source->bytesReceived();
+    quint64 packets = _source->packetsReceived();
+    double interval = countersTimer.isActive() ? countersTimer.interval() / 1000. : 0;
+
+    QString text = QString(tr("%1 bytes, %2 packets")).arg(bytes).arg(packets);
+    if (interval > 0)
+    {
+        text += QString(tr(" (%1 B/s, %2 packets/s)"))
+            .arg((bytes - lastBytes) / interval, 0, 'f', 0)
+            .arg((packets - lastPackets) / interval, 0, 'f', 0);
+    }
+    lCounters.setText(text);
+
+    lastBytes = bytes;
+    lastPackets = packets;
+}
+
+void SourcePanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Source);
+    settings->setValue(SG_Source_Type, typeSettingNames[cbType.currentIndex()]);
+    settings->setValue(SG_Source_Address, leAddress.text());
+    settings->endGroup();
+}
+
+void SourcePanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Source);
+
+    QString type = settings->value(SG_Source_Type).toString();
+    for (int i = 0; i < cbType.count(); i++)
+    {
+        if (type == typeSettingNames[i]) cbType.setCurrentIndex(i);
+    }
+    leAddress.setText(settings->value(SG_Source_Address, leAddress.text()).toString());
+
+    settings->endGroup();
+}
@@ -0,0 +1,71 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SOURCEPANEL_H
+#define SOURCEPANEL_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTimer>
+#include <QSettings>
+
+#include "datasource.h"
+
+/**
+ * Controls a non-serial `DataSource`. While the source is open, data
+ * format panel reads from it instead of the serial port.
+ */
+class SourcePanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SourcePanel(DataSource* source, QWidget* parent = 0);
+
+    /// Stores source settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads source settings from a `QSettings`
+    void loadSettings(QSettings* settings);
+
+private:
+    DataSource* _source;
+
+    QComboBox cbType;
+    QLineEdit leAddress;
+    QPushButton pbOpen;
+    QLabel lStatus;
+    QLabel lCounters;
+    QTimer countersTimer;
+    quint64 lastBytes;
+    quint64 lastPackets;
+
+    /// Updates address placeholder text for selected type
+    void updatePlaceholder();
+
+private slots:
+    void onOpenToggled(bool checked);
+    void onOpened(bool success, QString error);
+    void onClosed();
+    void updateCounters();
+};
+
+#endif // SOURCEPANEL_H
@@ -0,0 +1,260 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <math.h>
+#include <algorithm>
+
+#include "spectrumanalyzer.h"
+#include "metrics.h"
+#include "tracer.h"
+
+/// Results are reported at this interval at most
+const int DISPLAY_INTERVAL_MS = 40;
+/// Maximum number of spectrogram rows reported at once
+const int MAX_NEW_ROWS = 256;
+/// Maximum number of samples waiting for the worker, older data is dropped
+const size_t MAX_PENDING = 1 << 22;
+/// Power values are clamped to this before converting to dB
+const double MIN_POWER = 1e-20;
+
+SpectrumWorker::SpectrumWorker() :
+    timer(this)
+{
+    plan = new FftPlan(1024);
+    overlap = 50;
+    hop = 512;
+    avgCount = 1;
+    peakHold = false;
+    numAveraged = 0;
+
+    timer.setInterval(DISPLAY_INTERVAL_MS);
+    connect(&timer, &QTimer::timeout, this, &SpectrumWorker::process);
+
+    reset();
+}
+
+SpectrumWorker::~SpectrumWorker()
+{
+    delete plan;
+}
+
+void SpectrumWorker::start()
+{
+    timer.start();
+}
+
+void SpectrumWorker::addSamples(const double* data, unsigned n)
+{
+    QMutexLocker locker(&pendingLock);
+
+    pending.insert(pending.end(), data, data + n);
+    if (pending.size() > MAX_PENDING)
+    {
+        pending.erase(pending.begin(), pending.end() - MAX_PENDING);
+    }
+
+    static MetricGauge& queueDepth = Metrics::instance().gauge("spectrum.queue_depth");
+    queueDepth.set(pending.size());
+}
+
+void SpectrumWorker::setFftSize(unsigned n)
+{
+    if (n == plan->size() || !FftPlan::isValidSize(n)) return;
+
+    delete plan;
+    plan = new FftPlan(n);
+    reset();
+}
+
+void SpectrumWorker::setOverlap(unsigned percent)
+{
+    overlap = std::min(percent, 99u);
+    reset();
+}
+
+void SpectrumWorker::setAveraging(unsigned n)
+{
+    avgCount = std::max(n, 1u);
+    numAveraged = std::min(numAveraged, avgCount);
+}
+
+void SpectrumWorker::setPeakHold(bool enabled)
+{
+    peakHold = enabled;
+    std::fill(peak.begin(), peak.end(), 0.);
+}
+
+void SpectrumWorker::clear()
+{
+    {
+        QMutexLocker locker(&pendingLock);
+        pending.clear();
+    }
+    reset();
+}
+
+void SpectrumWorker::reset()
+{
+    unsigned n = plan->size();
+    hop = std::max(n * (100 - overlap) / 100, 1u);
+
+    input.clear();
+    power.assign(plan->numBins(), 0.);
+    average.assign(plan->numBins(), 0.);
+    peak.assign(plan->numBins(), 0.);
+    numAveraged = 0;
+}
+
+/// Converts power values to dB
+static QVector<double> toDb(const std::vector<double>& power)
+{
+    QVector<double> result(power.size());
+    for (size_t i = 0; i < power.size(); i++)
+    {
+        result[i] = 10 * log10(std::max(power[i], MIN_POWER));
+    }
+    return result;
+}
+
+void SpectrumWorker::process()
+{
+    TRACE_SCOPE("SpectrumWorker::process");
+    {
+        QMutexLocker locker(&pendingLock);
+        input.insert(input.end(), pending.begin(), pending.end());
+        pending.clear();
+    }
+
+    unsigned n = plan->size();
+    SpectrumResult result;
+    size_t start = 0;
+    while (input.size() - start >= n)
+    {
+        plan->power(input.data() + start, power.data());
+        start += hop;
+
+        // plain mean until `avgCount` is reached, exponential afterwards
+        numAveraged = std::min(numAveraged + 1, avgCount);
+        for (size_t k = 0; k < power.size(); k++)
+        {
+            average[k] += (power[k] - average[k]) / numAveraged;
+        }
+        if (peakHold)
+        {
+            for (size_t k = 0; k < power.size(); k++)
+            {
+                peak[k] = std::max(peak[k], power[k]);
+            }
+        }
+
+        result.rows.append(toDb(power));
+        if (result.rows.size() > MAX_NEW_ROWS)
+        {
+            result.rows.removeFirst();
+        }
+    }
+
+    // keep only the samples of the next window
+    input.erase(input.begin(), input.begin() + std::min(start, input.size()));
+
+    if (result.rows.isEmpty()) return;
+
+    result.spectrum = toDb(average);
+    if (peakHold)
+    {
+        result.peak = toDb(peak);
+    }
+    emit resultReady(result);
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(Stream* stream, QObject* parent) :
+    QObject(parent)
+{
+    qRegisterMetaType<SpectrumResult>();
+
+    _stream = stream;
+    _channel = 0;
+
+    worker = new SpectrumWorker();
+    worker->moveToThread(&thread);
+    connect(&thread, &QThread::started, worker, &SpectrumWorker::start);
+    connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(worker, &SpectrumWorker::resultReady,
+            this, &SpectrumAnalyzer::resultReady);
+    thread.setObjectName("Spectrum");
+    thread.start();
+
+    _stream->connectFollower(this);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    _stream->disconnectFollower(this);
+    thread.quit();
+    thread.wait();
+}
+
+unsigned SpectrumAnalyzer::channel() const
+{
+    return _channel;
+}
+
+void SpectrumAnalyzer::setChannel(unsigned channel)
+{
+    if (channel == _channel) return;
+
+    _channel = channel;
+    clear();
+}
+
+void SpectrumAnalyzer::setFftSize(unsigned n)
+{
+    QMetaObject::invokeMethod(worker, [this, n]{worker->setFftSize(n);});
+}
+
+void SpectrumAnalyzer::setOverlap(unsigned percent)
+{
+    QMetaObject::invokeMethod(worker, [this, percent]{worker->setOverlap(percent);});
+}
+
+void SpectrumAnalyzer::setAveraging(unsigned n)
+{
+    QMetaObject::invokeMethod(worker, [this, n]{worker->setAveraging(n);});
+}
+
+void SpectrumAnalyzer::setPeakHold(bool enabled)
+{
+    QMetaObject::invokeMethod(worker, [this, enabled]{worker->setPeakHold(enabled);});
+}
+
+void SpectrumAnalyzer::clear()
+{
+    QMetaObject::invokeMethod(worker, [this]{worker->clear();});
+}
+
+void SpectrumAnalyzer::feedIn(const SamplePack& data)
+{
+    if (_channel < data.numChannels())
+    {
+        worker->addSamples(data.data(_channel), data.numSamples());
+    }
+
+    Sink::feedIn(data);
+}
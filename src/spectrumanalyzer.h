@@ -0,0 +1,145 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPECTRUMANALYZER_H
+#define SPECTRUMANALYZER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QTimer>
+#include <QVector>
+#include <vector>
+
+#include "sink.h"
+#include "stream.h"
+#include "fftplan.h"
+
+/// Spectrum analysis results sent to GUI, values are in dB
+struct SpectrumResult
+{
+    QVector<double> spectrum;       ///< averaged power spectrum
+    QVector<double> peak;           ///< peak hold spectrum, empty if disabled
+    QVector<QVector<double>> rows;  ///< new spectrogram rows, oldest first
+};
+
+Q_DECLARE_METATYPE(SpectrumResult);
+
+/**
+ * Does the FFT work of `SpectrumAnalyzer` on a worker thread.
+ *
+ * Samples are queued with `addSamples` from any thread. Queued samples
+ * are processed at display rate; every `hop` samples a new window is
+ * transformed, so overlapping windows are computed incrementally as
+ * data arrives.
+ */
+class SpectrumWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    SpectrumWorker();
+    ~SpectrumWorker();
+
+    /// Queues samples for processing, thread safe
+    void addSamples(const double* data, unsigned n);
+
+public slots:
+    /// Starts processing timer, should be called in worker thread
+    void start();
+    /// @param n FFT size, must be a power of 2
+    void setFftSize(unsigned n);
+    /// @param percent overlap of consecutive windows [0, 100)
+    void setOverlap(unsigned percent);
+    /// @param n number of spectrums to average, 1 to disable
+    void setAveraging(unsigned n);
+    void setPeakHold(bool enabled);
+    /// Discards queued samples and resets averaging
+    void clear();
+
+signals:
+    void resultReady(SpectrumResult result);
+
+private:
+    QTimer timer;
+
+    QMutex pendingLock;
+    std::vector<double> pending;  ///< guarded by `pendingLock`
+
+    FftPlan* plan;
+    unsigned overlap;
+    unsigned hop;
+    unsigned avgCount;
+    bool peakHold;
+
+    std::vector<double> input;    ///< samples waiting for a window
+    std::vector<double> power;    ///< power of last window
+    std::vector<double> average;
+    std::vector<double> peak;
+    unsigned numAveraged;
+
+    /// Resets processing state, called when parameters change
+    void reset();
+
+private slots:
+    /// Transforms all complete windows and reports results
+    void process();
+};
+
+/**
+ * Computes spectrum of a stream channel.
+ *
+ * Connects itself as a follower to the stream and hands over the data
+ * of selected channel to a `SpectrumWorker` running on a separate
+ * thread. Results are delivered with `resultReady` signal on GUI thread.
+ */
+class SpectrumAnalyzer : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumAnalyzer(Stream* stream, QObject* parent = 0);
+    ~SpectrumAnalyzer();
+
+    unsigned channel() const;
+
+public slots:
+    void setChannel(unsigned channel);
+    void setFftSize(unsigned n);
+    void setOverlap(unsigned percent);
+    void setAveraging(unsigned n);
+    void setPeakHold(bool enabled);
+    void clear();
+
+signals:
+    void resultReady(SpectrumResult result);
+
+protected:
+    // implementations for `Sink`
+    virtual void feedIn(const SamplePack& data);
+
+private:
+    Stream* _stream;
+    unsigned _channel;
+    QThread thread;
+    SpectrumWorker* worker;
+};
+
+#endif // SPECTRUMANALYZER_H
@@ -0,0 +1,219 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSplitter>
+#include <qwt_color_map.h>
+
+#include "spectrumplot.h"
+
+/// Number of rows displayed in spectrogram
+const int SPECTROGRAM_ROWS = 200;
+/// Selectable FFT sizes
+const unsigned FFT_SIZES[] = {256, 512, 1024, 2048, 4096, 8192, 16384, 32768};
+const unsigned DEFAULT_FFT_SIZE = 1024;
+/// Lower limit of spectrogram color scale
+const double SPECTROGRAM_MIN_DB = -120;
+
+SpectrumPlot::SpectrumPlot(Stream* stream, PlotMenu* menu, QWidget* parent) :
+    QWidget(parent),
+    analyzer(stream)
+{
+    // controls
+    cbChannel.setModel(stream->infoModel());
+    cbChannel.setModelColumn(ChannelInfoModel::COLUMN_NAME);
+    cbChannel.setToolTip(tr("Channel to analyze"));
+
+    for (auto n : FFT_SIZES)
+    {
+        cbFftSize.addItem(QString::number(n), n);
+    }
+    cbFftSize.setCurrentIndex(cbFftSize.findData(DEFAULT_FFT_SIZE));
+    cbFftSize.setToolTip(tr("FFT size, frequency resolution is 1/size"));
+
+    cbOverlap.addItem("0%", 0);
+    cbOverlap.addItem("50%", 50);
+    cbOverlap.addItem("75%", 75);
+    cbOverlap.setCurrentIndex(1);
+    cbOverlap.setToolTip(tr("Overlap of consecutive windows"));
+
+    spAveraging.setRange(1, 100);
+    spAveraging.setToolTip(tr("Number of spectrums to average"));
+
+    cbPeakHold.setText(tr("Peak Hold"));
+
+    auto controls = new QHBoxLayout();
+    controls->addWidget(new QLabel(tr("Channel:")));
+    controls->addWidget(&cbChannel);
+    controls->addWidget(new QLabel(tr("Size:")));
+    controls->addWidget(&cbFftSize);
+    controls->addWidget(new QLabel(tr("Overlap:")));
+    controls->addWidget(&cbOverlap);
+    controls->addWidget(new QLabel(tr("Average:")));
+    controls->addWidget(&spAveraging);
+    controls->addWidget(&cbPeakHold);
+    controls->addStretch();
+
+    // plots
+    spectrumCurve.attach(&spectrumPlot);
+    peakCurve.setPen(QPen(Qt::red, 1, Qt::DashLine));
+    peakCurve.attach(&spectrumPlot);
+    spectrumPlot.setAxisTitle(QwtPlot::yLeft, tr("dB"));
+    spectrumPlot.setAxisScale(QwtPlot::xBottom, 0, 0.5);
+
+    auto colorMap = new QwtLinearColorMap(Qt::black, Qt::white);
+    colorMap->addColorStop(0.25, Qt::darkBlue);
+    colorMap->addColorStop(0.5, Qt::red);
+    colorMap->addColorStop(0.75, Qt::yellow);
+    spectrogram.setColorMap(colorMap);
+    spectrogramData = new QwtMatrixRasterData();
+    spectrogram.setData(spectrogramData);
+    spectrogram.attach(&spectrogramPlot);
+    spectrogramPlot.setAxisScale(QwtPlot::xBottom, 0, 0.5);
+    spectrogramPlot.setAxisScale(QwtPlot::yLeft, 0, SPECTROGRAM_ROWS);
+    spectrogramPlot.setAxisTitle(QwtPlot::xBottom, tr("Frequency (cycles/sample)"));
+    spectrogramPlot.enableAxis(QwtPlot::yLeft, false);
+
+    auto splitter = new QSplitter(Qt::Vertical);
+    splitter->addWidget(&spectrumPlot);
+    splitter->addWidget(&spectrogramPlot);
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(splitter);
+
+    // connect controls
+    connect(&cbChannel, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                if (index < 0) return;
+                analyzer.setChannel(index);
+                clear();
+            });
+
+    connect(&cbFftSize, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                analyzer.setFftSize(cbFftSize.itemData(index).toUInt());
+                clear();
+            });
+
+    connect(&cbOverlap, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                analyzer.setOverlap(cbOverlap.itemData(index).toUInt());
+            });
+
+    connect(&spAveraging, &QSpinBox::valueChanged,
+            [this](int value)
+            {
+                analyzer.setAveraging(value);
+            });
+
+    connect(&cbPeakHold, &QCheckBox::toggled,
+            [this](bool checked)
+            {
+                analyzer.setPeakHold(checked);
+                peakCurve.setVisible(checked);
+            });
+
+    analyzer.setFftSize(DEFAULT_FFT_SIZE);
+    analyzer.setOverlap(cbOverlap.currentData().toUInt());
+    peakCurve.setVisible(false);
+
+    connect(&analyzer, &SpectrumAnalyzer::resultReady,
+            this, &SpectrumPlot::onResultReady);
+
+    // connect to menu
+    connect(&menu->darkBackgroundAction, &QAction::toggled,
+            this, &SpectrumPlot::darkBackground);
+    darkBackground(menu->darkBackgroundAction.isChecked());
+}
+
+void SpectrumPlot::clear()
+{
+    rows.clear();
+    spectrumCurve.setSamples(QVector<QPointF>());
+    peakCurve.setSamples(QVector<QPointF>());
+    spectrumPlot.replot();
+}
+
+/// Returns curve points for a spectrum of `n/2+1` bins
+static QVector<QPointF> spectrumPoints(const QVector<double>& values)
+{
+    QVector<QPointF> points(values.size());
+    double step = 0.5 / (values.size() - 1);
+    for (int i = 0; i < values.size(); i++)
+    {
+        points[i] = QPointF(i * step, values[i]);
+    }
+    return points;
+}
+
+void SpectrumPlot::onResultReady(SpectrumResult result)
+{
+    int numBins = result.spectrum.size();
+
+    // FFT size changed, old rows don't fit
+    if (!rows.isEmpty() && rows.last().size() != numBins)
+    {
+        rows.clear();
+    }
+
+    spectrumCurve.setSamples(spectrumPoints(result.spectrum));
+    peakCurve.setSamples(spectrumPoints(result.peak));
+    spectrumPlot.replot();
+
+    rows.append(result.rows);
+    if (rows.size() > SPECTROGRAM_ROWS)
+    {
+        rows.remove(0, rows.size() - SPECTROGRAM_ROWS);
+    }
+
+    // newest row is at the top
+    QVector<double> matrix;
+    matrix.reserve(SPECTROGRAM_ROWS * numBins);
+    matrix.fill(SPECTROGRAM_MIN_DB, (SPECTROGRAM_ROWS - rows.size()) * numBins);
+    double maxDb = SPECTROGRAM_MIN_DB + 1;
+    for (const auto& row : rows)
+    {
+        matrix.append(row);
+        maxDb = std::max(maxDb, *std::max_element(row.begin(), row.end()));
+    }
+
+    spectrogramData->setValueMatrix(matrix, numBins);
+    spectrogramData->setInterval(Qt::XAxis, QwtInterval(0, 0.5));
+    spectrogramData->setInterval(Qt::YAxis, QwtInterval(0, SPECTROGRAM_ROWS));
+    spectrogramData->setInterval(Qt::ZAxis, QwtInterval(SPECTROGRAM_MIN_DB, maxDb));
+    spectrogram.invalidateCache();
+    spectrogramPlot.replot();
+}
+
+void SpectrumPlot::darkBackground(bool enabled)
+{
+    QBrush brush(enabled ? Qt::black : Qt::white);
+    spectrumPlot.setCanvasBackground(brush);
+    spectrumCurve.setPen(QPen(enabled ? Qt::yellow : Qt::blue));
+    spectrumPlot.replot();
+}
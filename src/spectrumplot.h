@@ -0,0 +1,82 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPECTRUMPLOT_H
+#define SPECTRUMPLOT_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QVector>
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_spectrogram.h>
+#include <qwt_matrix_raster_data.h>
+
+#include "stream.h"
+#include "plotmenu.h"
+#include "spectrumanalyzer.h"
+
+/**
+ * Displays power spectrum of a stream channel and a scrolling
+ * spectrogram below it.
+ *
+ * Frequency axis is in cycles per sample, 0.5 being the Nyquist
+ * frequency.
+ */
+class SpectrumPlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumPlot(Stream* stream, PlotMenu* menu, QWidget* parent = 0);
+
+public slots:
+    /// Enable/disable dark background
+    void darkBackground(bool enabled);
+
+private:
+    SpectrumAnalyzer analyzer;
+
+    QComboBox cbChannel;
+    QComboBox cbFftSize;
+    QComboBox cbOverlap;
+    QSpinBox spAveraging;
+    QCheckBox cbPeakHold;
+
+    QwtPlot spectrumPlot;
+    QwtPlot spectrogramPlot;
+    QwtPlotCurve spectrumCurve;
+    QwtPlotCurve peakCurve;
+    QwtPlotSpectrogram spectrogram;
+    QwtMatrixRasterData* spectrogramData; ///< owned by `spectrogram`
+
+    /// Spectrogram rows, oldest first
+    QVector<QVector<double>> rows;
+
+    /// Clears displayed data
+    void clear();
+
+private slots:
+    void onResultReady(SpectrumResult result);
+};
+
+#endif // SPECTRUMPLOT_H
@@ -0,0 +1,142 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <cmath>
+
+#include "statspanel.h"
+
+/// Table update interval in milliseconds (display rate)
+#define UPDATE_INTERVAL 50
+
+enum Column {ColChannel, ColMin, ColMax, ColMean, ColRms, ColStdDev, ColPeakToPeak, NumColumns};
+enum Range {RangeVisible, RangeWhole};
+
+StatsPanel::StatsPanel(const Stream* stream, QWidget* parent) :
+    QWidget(parent)
+{
+    _stream = stream;
+    visibleMin = -INFINITY;
+    visibleMax = INFINITY;
+    dirty = true;
+
+    cbRange.addItem(tr("Visible Window"), RangeVisible);
+    cbRange.addItem(tr("Whole Buffer"), RangeWhole);
+
+    table.setColumnCount(NumColumns);
+    table.setHorizontalHeaderLabels(
+        {tr("Channel"), tr("Min"), tr("Max"), tr("Mean"), tr("RMS"), tr("Std Dev"), tr("Peak-Peak")});
+    table.verticalHeader()->hide();
+    table.horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table.horizontalHeader()->setStretchLastSection(true);
+    table.setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table.setSelectionMode(QAbstractItemView::NoSelection);
+
+    auto options = new QVBoxLayout();
+    options->addWidget(new QLabel(tr("Range:"), this));
+    options->addWidget(&cbRange);
+    options->addStretch();
+
+    auto layout = new QHBoxLayout(this);
+    layout->addWidget(&table, 1);
+    layout->addLayout(options);
+
+    connect(&updateTimer, &QTimer::timeout, this, &StatsPanel::updateTable);
+    connect(&cbRange, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &StatsPanel::markDirty);
+    connect(stream, &Stream::dataAdded, this, &StatsPanel::markDirty);
+    connect(stream, &Stream::numChannelsChanged, this, &StatsPanel::markDirty);
+    connect(stream, &Stream::numSamplesChanged, this, &StatsPanel::markDirty);
+    connect(stream, &Stream::channelNameChanged, this, &StatsPanel::markDirty);
+}
+
+void StatsPanel::setVisibleRange(double xMin, double xMax)
+{
+    visibleMin = xMin;
+    visibleMax = xMax;
+    markDirty();
+}
+
+void StatsPanel::showEvent(QShowEvent* event)
+{
+    // only update while visible, to not cost anything otherwise
+    dirty = true;
+    updateTable();
+    updateTimer.start(UPDATE_INTERVAL);
+    QWidget::showEvent(event);
+}
+
+void StatsPanel::hideEvent(QHideEvent* event)
+{
+    updateTimer.stop();
+    QWidget::hideEvent(event);
+}
+
+void StatsPanel::markDirty()
+{
+    dirty = true;
+}
+
+void StatsPanel::updateTable()
+{
+    if (!dirty) return;
+    dirty = false;
+
+    unsigned nc = _stream->numChannels();
+    table.setRowCount(nc);
+    if (nc == 0) return;
+
+    auto buffer = _stream->yBuffer();
+    unsigned start = 0, end = buffer->size();
+    if (cbRange.currentData().toInt() == RangeVisible)
+    {
+        _stream->channel(0)->xData()->findRange(visibleMin, visibleMax, &start, &end);
+    }
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        auto s = buffer->stats(ci, start, end);
+        QString cells[NumColumns];
+        cells[ColChannel] = _stream->channel(ci)->name();
+        if (s.count)
+        {
+            cells[ColMin] = QString::number(s.min);
+            cells[ColMax] = QString::number(s.max);
+            cells[ColMean] = QString::number(s.mean);
+            cells[ColRms] = QString::number(s.rms());
+            cells[ColStdDev] = QString::number(s.stdDev());
+            cells[ColPeakToPeak] = QString::number(s.peakToPeak());
+        }
+
+        for (int col = 0; col < NumColumns; col++)
+        {
+            auto item = table.item(ci, col);
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                if (col != ColChannel) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                table.setItem(ci, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
+}
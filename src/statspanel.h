@@ -0,0 +1,66 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATSPANEL_H
+#define STATSPANEL_H
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QComboBox>
+#include <QTimer>
+
+#include "stream.h"
+
+/**
+ * Displays min, max, mean, RMS, standard deviation and peak-to-peak
+ * values of each channel, either for the whole buffer or only for
+ * the visible part of the plot.
+ *
+ * Statistics are taken from block summaries of `MultiRingBuffer`,
+ * so refreshing doesn't rescan the buffer.
+ */
+class StatsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatsPanel(const Stream* stream, QWidget* parent = 0);
+
+public slots:
+    /// Sets the X range for "visible window" statistics
+    void setVisibleRange(double xMin, double xMax);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    const Stream* _stream;
+    QComboBox cbRange;
+    QTableWidget table;
+    QTimer updateTimer;
+    double visibleMin, visibleMax;
+    bool dirty; ///< data or range changed since last update
+
+private slots:
+    void markDirty();
+    void updateTable();
+};
+
+#endif // STATSPANEL_H
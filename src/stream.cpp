@@ -18,14 +18,19 @@
 */
 
 #include "stream.h"
-#include "ringbuffer.h"
+#include "metrics.h"
+#include "tracer.h"
 #include "indexbuffer.h"
 #include "linindexbuffer.h"
+#include "xringbuffer.h"
 
 Stream::Stream(unsigned nc, bool x, unsigned ns) :
-    _infoModel(nc)
+    yData(nc, ns),
+    _infoModel(nc),
+    _trigger(nc, x, ns)
 {
     _numSamples = ns;
+    _totalSamples = 0;
     _paused = false;
 
     xAsIndex = true;
@@ -34,20 +39,12 @@ Stream::Stream(unsigned nc, bool x, unsigned ns) :
 
     // create xdata buffer
     _hasx = x;
-    if (x)
-    {
-        // TODO: implement XRingBuffer (binary search)
-        Q_ASSERT(false);
-    }
-    else
-    {
-        xData = makeXBuffer();
-    }
+    xData = makeXBuffer();
 
     // create channels
     for (unsigned i = 0; i < nc; i++)
     {
-        auto c = new StreamChannel(i, xData, new RingBuffer(ns), &_infoModel);
+        auto c = new StreamChannel(i, xData, yData.channel(i), &_infoModel);
         channels.append(c);
     }
 }
@@ -76,6 +73,11 @@ unsigned Stream::numSamples() const
     return _numSamples;
 }
 
+quint64 Stream::totalSamples() const
+{
+    return _totalSamples;
+}
+
 const StreamChannel* Stream::channel(unsigned index) const
 {
     Q_ASSERT(index < numChannels());
@@ -87,6 +89,11 @@ StreamChannel* Stream::channel(unsigned index)
     return const_cast<StreamChannel*>(static_cast<const Stream&>(*this).channel(index));
 }
 
+const MultiRingBuffer* Stream::yBuffer() const
+{
+    return &yData;
+}
+
 QVector<const StreamChannel*> Stream::allChannels() const
 {
     QVector<const StreamChannel*> result(numChannels());
@@ -107,6 +114,11 @@ ChannelInfoModel* Stream::infoModel()
     return const_cast<ChannelInfoModel*>(static_cast<const Stream&>(*this).infoModel());
 }
 
+Trigger* Stream::trigger()
+{
+    return &_trigger;
+}
+
 void Stream::setNumChannels(unsigned nc, bool x)
 {
     unsigned oldNum = numChannels();
@@ -115,9 +127,10 @@ void Stream::setNumChannels(unsigned nc, bool x)
     // adjust the number of channels
     if (nc > oldNum)
     {
+        yData.setNumChannels(nc);
         for (unsigned i = oldNum; i < nc; i++)
         {
-            auto c = new StreamChannel(i, xData, new RingBuffer(_numSamples), &_infoModel);
+            auto c = new StreamChannel(i, xData, yData.channel(i), &_infoModel);
             channels.append(c);
         }
     }
@@ -127,41 +140,49 @@ void Stream::setNumChannels(unsigned nc, bool x)
         {
             delete channels.takeLast();
         }
+        yData.setNumChannels(nc);
     }
 
     // change the xdata
-    if (x != _hasx)
+    bool xChanged = (x != _hasx);
+    XFrameBuffer* oldXData = nullptr;
+    if (xChanged)
     {
-        if (x)
-        {
-            // TODO: implement XRingBuffer (binary search)
-            Q_ASSERT(false);
-        }
-        else
-        {
-            xData = makeXBuffer();
-        }
+        _hasx = x;
+        oldXData = xData;
+        xData = makeXBuffer();
 
         for (auto c : channels)
         {
             c->setX(xData);
         }
-        _hasx = x;
     }
 
     if (nc != oldNum)
     {
         _infoModel.setNumOfChannels(nc);
-        // TODO: how about X change?
         emit numChannelsChanged(nc);
     }
 
+    _trigger.setNumChannels(nc, x);
+
+    if (xChanged)
+    {
+        emit hasXChanged(x);
+        // users of the old buffer should have switched by now
+        delete oldXData;
+    }
+
     Sink::setNumChannels(nc, x);
 }
 
 XFrameBuffer* Stream::makeXBuffer() const
 {
-    if (xAsIndex)
+    if (_hasx)
+    {
+        return new XRingBuffer(_numSamples);
+    }
+    else if (xAsIndex)
     {
         return new IndexBuffer(_numSamples);
     }
@@ -221,30 +242,45 @@ void Stream::feedIn(const SamplePack& pack)
 
     if (_paused) return;
 
-    unsigned ns = pack.numSamples();
-    if (_hasx)
-    {
-        // TODO: implement XRingBuffer (binary search)
-        Q_ASSERT(false);
-        // static_cast<RingBuffer*>(xData)->addSamples(pack.xData(), ns);
-    }
+    TRACE_SCOPE("Stream::feedIn");
+    static MetricCounter& samplesIn = Metrics::instance().counter("stream.samples_in");
+    samplesIn.add(pack.numSamples());
 
     // modified pack that gain and offset is applied to
     const SamplePack* mPack = nullptr;
     if (infoModel()->gainOrOffsetEn())
         mPack = applyGainOffset(pack);
 
-    for (unsigned ci = 0; ci < numChannels(); ci++)
+    const SamplePack& data = (mPack == nullptr) ? pack : *mPack;
+
+    // in trigger mode only the captured window is displayed
+    bool updated = true;
+    if (_trigger.enabled())
+    {
+        updated = _trigger.feedIn(data) > 0;
+        if (updated) addToBuffers(_trigger.window());
+    }
+    else
     {
-        auto buf = static_cast<RingBuffer*>(channels[ci]->yData());
-        double* data = (mPack == nullptr) ? pack.data(ci) : mPack->data(ci);
-        buf->addSamples(data, ns);
+        addToBuffers(data);
     }
 
-    Sink::feedIn((mPack == nullptr) ? pack : *mPack);
+    Sink::feedIn(data);
 
     if (mPack != nullptr) delete mPack;
-    emit dataAdded();
+    if (updated) emit dataAdded();
+}
+
+void Stream::addToBuffers(const SamplePack& pack)
+{
+    unsigned ns = pack.numSamples();
+    if (_hasx)
+    {
+        static_cast<XRingBuffer*>(xData)->addSamples(pack.xData(), ns);
+    }
+
+    yData.addSamples(pack);
+    _totalSamples += ns;
 }
 
 void Stream::pause(bool paused)
@@ -254,22 +290,22 @@ void Stream::pause(bool paused)
 
 void Stream::clear()
 {
-    for (auto c : channels)
+    if (_hasx)
     {
-        static_cast<RingBuffer*>(c->yData())->clear();
+        static_cast<XRingBuffer*>(xData)->clear();
     }
+    yData.clear();
+    _totalSamples += _numSamples;
 }
 
 void Stream::setNumSamples(unsigned value)
 {
     if (value == _numSamples) return;
     _numSamples = value;
+    _trigger.setWindowSize(value);
 
     xData->resize(value);
-    for (auto c : channels)
-    {
-        static_cast<RingBuffer*>(c->yData())->resize(value);
-    }
+    yData.resize(value);
 }
 
 void Stream::setXAxis(bool asIndex, double min, double max)
@@ -30,6 +30,8 @@
 #include "channelinfomodel.h"
 #include "streamchannel.h"
 #include "framebuffer.h"
+#include "multiringbuffer.h"
+#include "trigger.h"
 
 /**
  * Main waveform storage class. It consists of channels. Channels are
@@ -55,11 +57,22 @@ public:
     unsigned numChannels() const;
 
     unsigned numSamples() const;
+    /**
+     * Total number of samples added to the display buffers so far.
+     *
+     * Used by plots to determine how far the data scrolled since last
+     * draw. Clearing the buffers advances it by a full buffer size.
+     */
+    quint64 totalSamples() const;
     const StreamChannel* channel(unsigned index) const;
     StreamChannel* channel(unsigned index);
     QVector<const StreamChannel*> allChannels() const;
+    /// Display buffer of all channels, for statistics over channel data
+    const MultiRingBuffer* yBuffer() const;
     const ChannelInfoModel* infoModel() const;
     ChannelInfoModel* infoModel();
+    /// Trigger engine, display buffers are updated only on capture when enabled
+    Trigger* trigger();
 
     /// Saves channel information
     void saveSettings(QSettings* settings) const;
@@ -77,6 +90,9 @@ signals:
     void channelAdded(const StreamChannel* chan);
     void channelNameChanged(unsigned channel, QString name); // TODO: does it stay?
     void dataAdded(); ///< emitted when data added to channel man.
+    /// Emitted when X data source changes, previous X buffer is deleted
+    /// right after this signal
+    void hasXChanged(bool hasX);
 
 public slots:
     /// Change number of samples (buffer size)
@@ -94,13 +110,16 @@ public slots:
 
 private:
     unsigned _numSamples;
+    quint64 _totalSamples;
     bool _paused;
 
     bool _hasx;
     XFrameBuffer* xData;
+    MultiRingBuffer yData;       ///< data of all channels
     QList<StreamChannel*> channels;
 
     ChannelInfoModel _infoModel;
+    Trigger _trigger;
 
     bool xAsIndex;
     double xMin, xMax;
@@ -118,7 +137,10 @@ private:
      */
     const SamplePack* applyGainOffset(const SamplePack& pack) const;
 
-    /// Returns a new virtual X buffer for settings
+    /// Adds pack data to display buffers
+    void addToBuffers(const SamplePack& pack);
+
+    /// Returns a new X buffer, a virtual one for settings unless `hasX`
     XFrameBuffer* makeXBuffer() const;
 };
 
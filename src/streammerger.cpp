@@ -0,0 +1,206 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "streammerger.h"
+
+class StreamMerger::Input : public Sink
+{
+public:
+    explicit Input(StreamMerger* merger)
+    {
+        _merger = merger;
+        _numChannels = 0;
+        _hasX = false;
+        arrivalTime = -1;
+        lastTime = -1;
+    }
+
+    unsigned _numChannels;
+    bool _hasX;
+    /// Last value of each channel, held while other inputs are fed
+    std::vector<double> lastValues;
+    /// Arrival time of next data, -1 if not set
+    qint64 arrivalTime;
+    /// Arrival time of previous data, -1 if there isn't any
+    qint64 lastTime;
+
+protected:
+    void feedIn(const SamplePack& data) override
+    {
+        _merger->onInputData(this, data);
+        Sink::feedIn(data);
+    }
+
+    void setNumChannels(unsigned nc, bool x) override
+    {
+        _numChannels = nc;
+        _hasX = x;
+        lastValues.assign(nc, 0.);
+        _merger->onInputChannelsChanged();
+        Sink::setNumChannels(nc, x);
+    }
+
+private:
+    StreamMerger* _merger;
+};
+
+StreamMerger::StreamMerger()
+{
+    startTime = now();
+    lastX = 0;
+}
+
+StreamMerger::~StreamMerger()
+{
+    // sinks must be notified before inputs are gone
+    disconnectSinks();
+    for (auto input : inputs)
+    {
+        auto source = input->connectedSource();
+        if (source != nullptr) source->disconnect(input);
+        delete input;
+    }
+}
+
+qint64 StreamMerger::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+Sink* StreamMerger::addInput()
+{
+    auto input = new Input(this);
+    inputs.append(input);
+    updateNumChannels();
+    return input;
+}
+
+void StreamMerger::removeInput(Sink* sink)
+{
+    auto input = findInput(sink);
+    Q_ASSERT(input != nullptr);
+
+    auto source = input->connectedSource();
+    if (source != nullptr) source->disconnect(input);
+
+    inputs.removeOne(input);
+    delete input;
+    updateNumChannels();
+}
+
+unsigned StreamMerger::numInputs() const
+{
+    return inputs.size();
+}
+
+StreamMerger::Input* StreamMerger::findInput(Sink* sink) const
+{
+    for (auto input : inputs)
+    {
+        if (input == sink) return input;
+    }
+    return nullptr;
+}
+
+void StreamMerger::setArrivalTime(Sink* sink, qint64 ns)
+{
+    auto input = findInput(sink);
+    Q_ASSERT(input != nullptr);
+    input->arrivalTime = ns;
+}
+
+bool StreamMerger::hasX() const
+{
+    if (inputs.size() == 1) return inputs[0]->_hasX;
+    return inputs.size() > 1;
+}
+
+unsigned StreamMerger::numChannels() const
+{
+    unsigned nc = 0;
+    for (auto input : inputs)
+    {
+        nc += input->_numChannels;
+    }
+    return nc;
+}
+
+void StreamMerger::onInputChannelsChanged()
+{
+    updateNumChannels();
+}
+
+void StreamMerger::onInputData(Input* input, const SamplePack& data)
+{
+    qint64 time = input->arrivalTime >= 0 ? input->arrivalTime : now();
+    input->arrivalTime = -1;
+
+    if (inputs.size() == 1)
+    {
+        input->lastTime = time;
+        feedOut(data);
+        return;
+    }
+
+    unsigned ns = data.numSamples();
+    if (ns == 0) return;
+
+    // spread samples between previous and current arrival
+    double end = (time - startTime) * 1e-9;
+    double start = input->lastTime >= 0 ? (input->lastTime - startTime) * 1e-9 : end;
+    start = std::max(start, lastX);
+    end = std::max(end, start);
+    input->lastTime = time;
+
+    SamplePack merged(ns, numChannels(), true);
+    double* x = merged.xData();
+    for (unsigned i = 0; i < ns; i++)
+    {
+        x[i] = start + (end - start) * (i + 1) / ns;
+    }
+    lastX = x[ns-1];
+
+    unsigned offset = 0;
+    for (auto in : inputs)
+    {
+        for (unsigned ci = 0; ci < in->_numChannels; ci++)
+        {
+            double* out = merged.data(offset + ci);
+            if (in == input)
+            {
+                memcpy(out, data.data(ci), ns * sizeof(double));
+                in->lastValues[ci] = out[ns-1];
+            }
+            else
+            {
+                std::fill(out, out + ns, in->lastValues[ci]);
+            }
+        }
+        offset += in->_numChannels;
+    }
+
+    feedOut(merged);
+}
@@ -0,0 +1,78 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef STREAMMERGER_H
+#define STREAMMERGER_H
+
+#include <QList>
+#include <QtGlobal>
+
+#include "source.h"
+#include "sink.h"
+
+/**
+ * Merges data of multiple sources into a single source.
+ *
+ * With a single input data is passed through as is. With multiple
+ * inputs, channels of all inputs are concatenated in input order and
+ * X is the arrival time of data in seconds. Each incoming pack is
+ * spread in time between the previous and current arrival of its
+ * input; channels of other inputs hold their last values. This way
+ * channels of different devices line up on a common time base.
+ */
+class StreamMerger : public Source
+{
+public:
+    StreamMerger();
+    ~StreamMerger();
+
+    /// Adds a new input, returned sink is owned by the merger
+    Sink* addInput();
+    /// Removes and deletes an input
+    void removeInput(Sink* input);
+    unsigned numInputs() const;
+
+    /**
+     * Sets arrival time of the next data to `input`. Current time is
+     * used when not set.
+     *
+     * @param ns time in nanoseconds as returned by `now()`
+     */
+    void setArrivalTime(Sink* input, qint64 ns);
+
+    /// Current time of the monotonic clock used for arrival times
+    static qint64 now();
+
+    bool hasX() const override;
+    unsigned numChannels() const override;
+
+private:
+    class Input;
+    QList<Input*> inputs;
+
+    qint64 startTime;  ///< time base, X is calculated relative to this
+    double lastX;      ///< last fed X value, used to keep X monotonic
+
+    Input* findInput(Sink* sink) const;
+    void onInputChannelsChanged();
+    void onInputData(Input* input, const SamplePack& data);
+};
+
+#endif // STREAMMERGER_H
@@ -0,0 +1,234 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QTextStream>
+#include <QThread>
+#include <QtDebug>
+
+#include "tracer.h"
+
+/// Maximum number of events recorded per thread, rest is dropped
+#define MAX_EVENTS_PER_THREAD (1 << 20)
+/// Events are allocated in chunks of this size as they are recorded
+#define EVENTS_PER_CHUNK      (1 << 12)
+#define NUM_CHUNKS            (MAX_EVENTS_PER_THREAD / EVENTS_PER_CHUNK)
+
+namespace
+{
+
+struct TraceEvent
+{
+    const char* name;
+    qint64 start;
+    qint64 duration;
+};
+
+/**
+ * Events of a single thread. Only the owner thread writes, events
+ * before `count` are complete and can be read from any thread.
+ *
+ * When its thread ends, buffer is kept with its events and is given to
+ * the next new thread, so that recycled pool threads don't allocate.
+ */
+struct ThreadBuffer
+{
+    unsigned tid;
+    QString threadName;
+    bool inUse;              ///< owned by a running thread, guarded by `buffersLock`
+    std::atomic<unsigned> generation;
+    /// allocated as needed and kept for reuse
+    std::unique_ptr<TraceEvent[]> chunks[NUM_CHUNKS];
+    std::atomic<size_t> count;
+    std::atomic<quint64> dropped;
+
+    TraceEvent& event(size_t i)
+    {
+        return chunks[i / EVENTS_PER_CHUNK][i % EVENTS_PER_CHUNK];
+    }
+};
+
+QMutex buffersLock;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+std::atomic<unsigned> generation(0);
+qint64 startTime = 0;
+
+/// Releases the buffer of a thread when the thread ends
+struct BufferOwner
+{
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferOwner()
+    {
+        if (buffer == nullptr) return;
+
+        QMutexLocker locker(&buffersLock);
+        buffer->inUse = false;
+    }
+};
+
+thread_local BufferOwner threadBuffer;
+
+ThreadBuffer* currentBuffer()
+{
+    if (threadBuffer.buffer == nullptr)
+    {
+        QThread* thread = QThread::currentThread();
+        QString threadName = thread->objectName();
+        if (threadName.isEmpty())
+        {
+            auto app = QCoreApplication::instance();
+            threadName = (app != nullptr && app->thread() == thread) ?
+                "Main" : QString("Thread %1").arg(quintptr(thread), 0, 16);
+        }
+
+        // buffers are kept until exit, threads may end before saving
+        QMutexLocker locker(&buffersLock);
+        ThreadBuffer* buffer = nullptr;
+        for (auto& b : buffers)
+        {
+            if (!b->inUse)
+            {
+                buffer = b.get();
+                break;
+            }
+        }
+
+        if (buffer == nullptr)
+        {
+            buffer = new ThreadBuffer();
+            buffer->generation = generation.load();
+            buffer->count = 0;
+            buffer->dropped = 0;
+            buffer->tid = buffers.size() + 1;
+            buffers.emplace_back(buffer);
+        }
+        buffer->inUse = true;
+        buffer->threadName = threadName;
+        threadBuffer.buffer = buffer;
+    }
+    return threadBuffer.buffer;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::_enabled(false);
+
+qint64 Tracer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::start()
+{
+    // buffers are cleared by their threads when they see new generation
+    generation++;
+    startTime = now();
+    _enabled = true;
+}
+
+void Tracer::stop()
+{
+    _enabled = false;
+}
+
+void Tracer::record(const char* name, qint64 start, qint64 duration)
+{
+    ThreadBuffer* buffer = currentBuffer();
+
+    unsigned gen = generation.load(std::memory_order_relaxed);
+    if (buffer->generation != gen)
+    {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation = gen;
+    }
+
+    size_t i = buffer->count.load(std::memory_order_relaxed);
+    if (i == MAX_EVENTS_PER_THREAD)
+    {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // readers don't access the chunk before `count` is updated
+    auto& chunk = buffer->chunks[i / EVENTS_PER_CHUNK];
+    if (!chunk) chunk.reset(new TraceEvent[EVENTS_PER_CHUNK]);
+
+    buffer->event(i) = {name, start, duration};
+    buffer->count.store(i + 1, std::memory_order_release);
+}
+
+/// Escapes a string for JSON
+static QString jsonString(QString str)
+{
+    str.replace("\\", "\\\\");
+    str.replace("\"", "\\\"");
+    return "\"" + str + "\"";
+}
+
+bool Tracer::save(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":" << jsonString(QCoreApplication::applicationName()) << "}}";
+
+    QMutexLocker locker(&buffersLock);
+    unsigned gen = generation.load();
+    for (auto& buffer : buffers)
+    {
+        out << QString(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%1,"
+                       "\"args\":{\"name\":%2}}")
+            .arg(buffer->tid).arg(jsonString(buffer->threadName));
+
+        // buffer isn't used since last start
+        if (buffer->generation != gen) continue;
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto& e = buffer->event(i);
+            // timestamps are in microseconds
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << buffer->tid << ",\"ts\":" << QString::number((e.start - startTime) / 1e3, 'f', 3)
+                << ",\"dur\":" << QString::number(e.duration / 1e3, 'f', 3) << "}";
+        }
+
+        quint64 dropped = buffer->dropped.load();
+        if (dropped)
+        {
+            qWarning() << "Trace buffer of thread" << buffer->threadName
+                       << "was full," << dropped << "events are dropped";
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    return file.error() == QFile::NoError;
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * Records timed scopes of hot paths and saves them in Chrome trace
+ * event format (JSON), which can be opened with `chrome://tracing` or
+ * Perfetto UI.
+ *
+ * Each thread writes into its own buffer without locking. Buffers grow
+ * in chunks up to a fixed size and are reused by new threads after
+ * their thread ends.
+ * When tracing is disabled, a trace scope costs a single relaxed
+ * atomic load.
+ */
+class Tracer
+{
+public:
+    /// Returns true while tracing
+    static bool enabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Discards previous events and starts tracing
+    static void start();
+    /// Stops tracing, recorded events are kept until next `start()`
+    static void stop();
+    /**
+     * Saves recorded events to a JSON file. Should be called after
+     * `stop()`. Returns false on file error.
+     */
+    static bool save(const QString& fileName);
+
+    /// Monotonic time in nanoseconds
+    static qint64 now();
+    /**
+     * Records a complete event for calling thread.
+     *
+     * @param name must be a string literal (pointer is stored)
+     */
+    static void record(const char* name, qint64 start, qint64 duration);
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+/// Records the lifetime of a scope, use with `TRACE_SCOPE` macro
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) :
+        _name(name), start(Tracer::enabled() ? Tracer::now() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (start >= 0) Tracer::record(_name, start, Tracer::now() - start);
+    }
+
+private:
+    const char* _name;
+    qint64 start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+/// Traces the enclosing scope with given name (a string literal)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif // TRACER_H
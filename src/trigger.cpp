@@ -0,0 +1,442 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include <QtGlobal>
+
+#include "trigger.h"
+
+/// Number of samples checked together while scanning
+const unsigned SCAN_BLOCK_SIZE = 32;
+
+/**
+ * Scans for the first sample that satisfies `cond(previous, current)`.
+ *
+ * Inner loop has no early exit, so it can be vectorized. When a block
+ * contains a hit it is scanned again to find the exact index.
+ */
+template <typename Cond>
+static unsigned scanBlocks(const double* data, double prev,
+                           unsigned from, unsigned to, Cond cond)
+{
+    if (from >= to) return to;
+
+    // first sample is compared with the previous pack
+    double first = from ? data[from-1] : prev;
+    if (cond(first, data[from])) return from;
+
+    unsigned i = from + 1;
+    for (; i + SCAN_BLOCK_SIZE <= to; i += SCAN_BLOCK_SIZE)
+    {
+        bool hit = false;
+        for (unsigned k = 0; k < SCAN_BLOCK_SIZE; k++)
+        {
+            hit |= cond(data[i+k-1], data[i+k]);
+        }
+        if (hit) break;
+    }
+
+    for (; i < to; i++)
+    {
+        if (cond(data[i-1], data[i])) return i;
+    }
+    return to;
+}
+
+Trigger::Trigger(unsigned nc, bool x, unsigned ws, QObject* parent) :
+    QObject(parent)
+{
+    _mode = Mode::off;
+    _type = Type::risingEdge;
+    _state = State::idle;
+    _channel = 0;
+    _level = 0;
+    _windowHigh = 1;
+    _position = 50;
+
+    _numChannels = nc;
+    _hasX = x;
+    _windowSize = ws;
+    _window = nullptr;
+
+    reset();
+}
+
+Trigger::~Trigger()
+{
+    delete _window;
+}
+
+Trigger::Mode Trigger::mode() const
+{
+    return _mode;
+}
+
+Trigger::Type Trigger::type() const
+{
+    return _type;
+}
+
+Trigger::State Trigger::state() const
+{
+    return _state;
+}
+
+unsigned Trigger::channel() const
+{
+    return _channel;
+}
+
+double Trigger::level() const
+{
+    return _level;
+}
+
+double Trigger::windowHigh() const
+{
+    return _windowHigh;
+}
+
+unsigned Trigger::position() const
+{
+    return _position;
+}
+
+bool Trigger::enabled() const
+{
+    return _mode != Mode::off;
+}
+
+unsigned Trigger::windowSize() const
+{
+    return _windowSize;
+}
+
+unsigned Trigger::preTrigger() const
+{
+    // trigger sample itself is always in the window
+    quint64 pre = quint64(_windowSize) * _position / 100;
+    return qMin(unsigned(pre), _windowSize - 1);
+}
+
+const SamplePack& Trigger::window() const
+{
+    return *_window;
+}
+
+void Trigger::setNumChannels(unsigned nc, bool x)
+{
+    if (nc == _numChannels && x == _hasX) return;
+
+    _numChannels = nc;
+    _hasX = x;
+    reset();
+}
+
+void Trigger::setWindowSize(unsigned ws)
+{
+    Q_ASSERT(ws > 0);
+
+    if (ws == _windowSize) return;
+
+    _windowSize = ws;
+    reset();
+}
+
+void Trigger::setMode(Trigger::Mode mode)
+{
+    if (mode == _mode) return;
+
+    // storage is needed only while trigger is on
+    bool wasOff = _mode == Mode::off;
+    _mode = mode;
+    if (wasOff || _mode == Mode::off) reset();
+
+    if (_mode == Mode::off)
+    {
+        setState(State::idle);
+    }
+    else
+    {
+        arm();
+    }
+}
+
+void Trigger::setType(Trigger::Type type)
+{
+    _type = type;
+}
+
+void Trigger::setChannel(unsigned channel)
+{
+    if (channel == _channel) return;
+
+    _channel = channel;
+    hasLastValue = false;
+}
+
+void Trigger::setLevel(double level)
+{
+    _level = level;
+}
+
+void Trigger::setWindowHigh(double value)
+{
+    _windowHigh = value;
+}
+
+void Trigger::setPosition(unsigned percent)
+{
+    _position = qMin(percent, 100u);
+}
+
+void Trigger::arm()
+{
+    if (_mode == Mode::off) return;
+
+    holdOff = preTrigger();
+    postLeft = 0;
+    waited = 0;
+    setState(State::armed);
+}
+
+void Trigger::setState(State state)
+{
+    if (state == _state) return;
+
+    _state = state;
+    emit stateChanged(state);
+}
+
+void Trigger::reset()
+{
+    // a stream carries a trigger even when it's off, don't waste memory
+    delete _window;
+    if (_mode == Mode::off)
+    {
+        std::vector<double>().swap(history);
+        _window = nullptr;
+    }
+    else
+    {
+        unsigned numBuffers = _numChannels + (_hasX ? 1 : 0);
+        history.assign(size_t(numBuffers) * _windowSize, 0.);
+        _window = new SamplePack(_windowSize, _numChannels, _hasX);
+    }
+    head = 0;
+
+    hasLastValue = false;
+    lastValue = 0;
+    holdOff = preTrigger();
+    postLeft = 0;
+    waited = 0;
+
+    // an ongoing capture can't be completed
+    if (_state == State::triggered)
+    {
+        setState(State::armed);
+    }
+}
+
+void Trigger::pushHistory(const SamplePack& pack, unsigned start, unsigned end)
+{
+    unsigned n = end - start;
+    if (n == 0) return;
+
+    // only the newest `_windowSize` samples matter
+    if (n > _windowSize)
+    {
+        start += n - _windowSize;
+        n = _windowSize;
+    }
+
+    unsigned firstPart = qMin(n, _windowSize - head);
+    unsigned numBuffers = _numChannels + (_hasX ? 1 : 0);
+    for (unsigned bi = 0; bi < numBuffers; bi++)
+    {
+        const double* src = (bi < _numChannels ? pack.data(bi) : pack.xData()) + start;
+        double* ring = history.data() + size_t(bi) * _windowSize;
+
+        memcpy(ring + head, src, firstPart * sizeof(double));
+        memcpy(ring, src + firstPart, (n - firstPart) * sizeof(double));
+    }
+
+    head = (head + n) % _windowSize;
+}
+
+void Trigger::capture()
+{
+    unsigned firstPart = _windowSize - head;
+    unsigned numBuffers = _numChannels + (_hasX ? 1 : 0);
+    for (unsigned bi = 0; bi < numBuffers; bi++)
+    {
+        const double* ring = history.data() + size_t(bi) * _windowSize;
+        double* dst = bi < _numChannels ? _window->data(bi) : _window->xData();
+
+        memcpy(dst, ring + head, firstPart * sizeof(double));
+        memcpy(dst + firstPart, ring, head * sizeof(double));
+    }
+}
+
+void Trigger::onCaptured()
+{
+    if (_mode == Mode::single)
+    {
+        setState(State::stopped);
+    }
+    else
+    {
+        holdOff = preTrigger();
+        waited = 0;
+        setState(State::armed);
+    }
+}
+
+unsigned Trigger::scan(const double* data, double prev,
+                       unsigned from, unsigned to) const
+{
+    const double l = _level;
+    const double h = _windowHigh;
+
+    switch (_type)
+    {
+        case Type::risingEdge:
+            return scanBlocks(data, prev, from, to,
+                              [l](double a, double b) {return (a < l) & (b >= l);});
+        case Type::fallingEdge:
+            return scanBlocks(data, prev, from, to,
+                              [l](double a, double b) {return (a > l) & (b <= l);});
+        case Type::anyEdge:
+            return scanBlocks(data, prev, from, to,
+                              [l](double a, double b)
+                              {
+                                  return ((a < l) & (b >= l)) | ((a > l) & (b <= l));
+                              });
+        case Type::aboveLevel:
+            return scanBlocks(data, prev, from, to,
+                              [l](double, double b) {return b >= l;});
+        case Type::belowLevel:
+            return scanBlocks(data, prev, from, to,
+                              [l](double, double b) {return b <= l;});
+        case Type::enterWindow:
+            return scanBlocks(data, prev, from, to,
+                              [l, h](double a, double b)
+                              {
+                                  bool inA = (a >= l) & (a <= h);
+                                  bool inB = (b >= l) & (b <= h);
+                                  return !inA & inB;
+                              });
+        case Type::leaveWindow:
+            return scanBlocks(data, prev, from, to,
+                              [l, h](double a, double b)
+                              {
+                                  bool inA = (a >= l) & (a <= h);
+                                  bool inB = (b >= l) & (b <= h);
+                                  return inA & !inB;
+                              });
+    }
+
+    return to;
+}
+
+unsigned Trigger::feedIn(const SamplePack& pack)
+{
+    Q_ASSERT(pack.numChannels() == _numChannels && pack.hasX() == _hasX);
+
+    unsigned ns = pack.numSamples();
+    if (ns == 0 || _mode == Mode::off) return 0;
+
+    // trigger channel may not exist (yet), then we just wait
+    const double* data = _channel < _numChannels ? pack.data(_channel) : nullptr;
+    double prev = hasLastValue || data == nullptr ? lastValue : data[0];
+
+    unsigned captured = 0;
+    unsigned pushed = 0;        // samples of pack already in history
+    unsigned i = 0;
+    while (i < ns && (_state == State::armed || _state == State::triggered))
+    {
+        if (_state == State::armed)
+        {
+            // make sure pre-trigger part of the window is fresh
+            unsigned skip = qMin(holdOff, ns - i);
+            holdOff -= skip;
+            waited += skip;
+            i += skip;
+            if (i == ns) break;
+
+            unsigned end = ns;
+            if (_mode == Mode::automatic)
+            {
+                end = qMin(ns, i + (_windowSize - waited));
+            }
+
+            unsigned t = data == nullptr ? end : scan(data, prev, i, end);
+            if (t < end)
+            {
+                i = t;
+                postLeft = _windowSize - preTrigger();
+                setState(State::triggered);
+            }
+            else
+            {
+                waited += end - i;
+                i = end;
+
+                // automatic mode shows latest data if trigger doesn't come
+                if (_mode == Mode::automatic && waited >= _windowSize)
+                {
+                    pushHistory(pack, pushed, i);
+                    pushed = i;
+                    capture();
+                    captured++;
+                    waited = 0;
+                }
+            }
+        }
+        else
+        {
+            unsigned take = qMin(postLeft, ns - i);
+            postLeft -= take;
+            i += take;
+
+            if (postLeft == 0)
+            {
+                pushHistory(pack, pushed, i);
+                pushed = i;
+                capture();
+                captured++;
+                onCaptured();
+            }
+        }
+    }
+
+    if (_state != State::stopped)
+    {
+        pushHistory(pack, pushed, ns);
+    }
+
+    if (data != nullptr)
+    {
+        lastValue = data[ns-1];
+        hasLastValue = true;
+    }
+
+    return captured;
+}
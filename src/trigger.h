@@ -0,0 +1,181 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef TRIGGER_H
+#define TRIGGER_H
+
+#include <QObject>
+#include <vector>
+
+#include "samplepack.h"
+
+/**
+ * Oscilloscope style trigger engine.
+ *
+ * Keeps a history of the last `windowSize` samples of every channel
+ * and scans incoming data of the selected channel for the trigger
+ * condition. When the condition is met, samples following the trigger
+ * point are collected until the window is complete (post-trigger
+ * depth) and then the whole window is captured. Captured window can be
+ * accessed with `window()` until the next capture. History and window
+ * are only allocated while the trigger isn't `off`.
+ *
+ * Scanning is done in fixed size blocks without early exit so that the
+ * compiler can vectorize the comparisons. Only the block containing a
+ * hit is scanned sample by sample.
+ */
+class Trigger : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Mode
+    {
+        off,       ///< free running, trigger isn't used
+        automatic, ///< like normal but captures without a trigger on timeout
+        normal,    ///< re-arms after every capture
+        single     ///< stops after first capture until armed again
+    };
+
+    enum class Type
+    {
+        risingEdge,   ///< crosses `level` upwards
+        fallingEdge,  ///< crosses `level` downwards
+        anyEdge,      ///< crosses `level` in either direction
+        aboveLevel,   ///< is at or above `level`
+        belowLevel,   ///< is at or below `level`
+        enterWindow,  ///< enters [`level`, `windowHigh`] range
+        leaveWindow   ///< leaves [`level`, `windowHigh`] range
+    };
+
+    enum class State
+    {
+        idle,      ///< trigger is off
+        armed,     ///< waiting for trigger condition
+        triggered, ///< collecting post-trigger samples
+        stopped    ///< single capture is completed
+    };
+
+    /**
+     * @param nc number of channels
+     * @param x has X data
+     * @param ws window size in samples
+     */
+    explicit Trigger(unsigned nc = 1, bool x = false, unsigned ws = 2,
+                     QObject* parent = 0);
+    ~Trigger();
+
+    Mode mode() const;
+    Type type() const;
+    State state() const;
+    unsigned channel() const;
+    double level() const;
+    double windowHigh() const;
+    /// Pre-trigger depth as percentage of the window size
+    unsigned position() const;
+    /// Returns true unless mode is `off`
+    bool enabled() const;
+
+    unsigned windowSize() const;
+    /// Number of samples in the window before the trigger point
+    unsigned preTrigger() const;
+
+    /// Changes the number of channels, resets the history
+    void setNumChannels(unsigned nc, bool x);
+    /// Changes the window size, resets the history
+    void setWindowSize(unsigned ws);
+
+    /**
+     * Scans given data for the trigger condition and adds it to the
+     * history. Does nothing if trigger is `off`.
+     *
+     * @return number of windows captured from this pack
+     */
+    unsigned feedIn(const SamplePack& pack);
+
+    /// Last captured window. Valid only after a capture.
+    const SamplePack& window() const;
+
+signals:
+    void stateChanged(Trigger::State state);
+
+public slots:
+    void setMode(Trigger::Mode mode);
+    void setType(Trigger::Type type);
+    void setChannel(unsigned channel);
+    void setLevel(double level);
+    /// Upper limit for window types, `level` is the lower limit
+    void setWindowHigh(double value);
+    /// Sets pre-trigger depth as percentage of window size, [0, 100]
+    void setPosition(unsigned percent);
+    /// Re-arms the trigger, also discards any ongoing capture
+    void arm();
+
+private:
+    Mode _mode;
+    Type _type;
+    State _state;
+    unsigned _channel;
+    double _level;
+    double _windowHigh;
+    unsigned _position;
+
+    unsigned _numChannels;
+    bool _hasX;
+    unsigned _windowSize;
+
+    /// Channel major history storage, X (if exists) is the last channel
+    std::vector<double> history;
+    /// Index of the oldest sample in history
+    unsigned head;
+
+    SamplePack* _window;
+
+    /// Last sample of the trigger channel, used for edge detection
+    double lastValue;
+    bool hasLastValue;
+    /// Samples to skip after arming so that pre-trigger part is filled
+    unsigned holdOff;
+    /// Remaining post trigger samples
+    unsigned postLeft;
+    /// Number of samples passed without a trigger (for automatic mode)
+    unsigned waited;
+
+    void setState(State state);
+    /// Clears history and starts over, (de)allocates storage per mode
+    void reset();
+    /// Adds samples in [start, end) range of pack into history
+    void pushHistory(const SamplePack& pack, unsigned start, unsigned end);
+    /// Copies history into `_window`
+    void capture();
+    /// Updates state after a capture
+    void onCaptured();
+
+    /**
+     * Looks for trigger condition in `data` [from, to) range.
+     *
+     * @param prev sample before `data[0]`
+     * @return index of the trigger sample or `to` if not found
+     */
+    unsigned scan(const double* data, double prev,
+                  unsigned from, unsigned to) const;
+};
+
+#endif // TRIGGER_H
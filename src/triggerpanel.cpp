@@ -0,0 +1,185 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <limits>
+
+#include "triggerpanel.h"
+#include "ui_triggerpanel.h"
+#include "setting_defines.h"
+
+/// Setting names of `Trigger::Mode` values, in order
+const char* const TriggerModeNames[] = {"off", "auto", "normal", "single"};
+/// Setting names of `Trigger::Type` values, in order
+const char* const TriggerTypeNames[] = {"rising", "falling", "anyEdge", "above",
+                                        "below", "enterWindow", "leaveWindow"};
+
+TriggerPanel::TriggerPanel(Stream* stream, QWidget* parent) :
+    QWidget(parent),
+    ui(new Ui::TriggerPanel)
+{
+    ui->setupUi(this);
+    trigger = stream->trigger();
+
+    ui->spLevel->setRange((-1) * std::numeric_limits<double>::max(),
+                          std::numeric_limits<double>::max());
+    ui->spWindowHigh->setRange((-1) * std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::max());
+
+    // list channel names
+    ui->cbChannel->setModel(stream->infoModel());
+    ui->cbChannel->setModelColumn(ChannelInfoModel::COLUMN_NAME);
+
+    // apply initial values
+    trigger->setType(static_cast<Trigger::Type>(ui->cbType->currentIndex()));
+    trigger->setLevel(ui->spLevel->value());
+    trigger->setWindowHigh(ui->spWindowHigh->value());
+    trigger->setPosition(ui->spPosition->value());
+    trigger->setMode(static_cast<Trigger::Mode>(ui->cbMode->currentIndex()));
+
+    connect(ui->cbMode, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                trigger->setMode(static_cast<Trigger::Mode>(index));
+                updateWidgets();
+            });
+
+    connect(ui->cbType, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                trigger->setType(static_cast<Trigger::Type>(index));
+                updateWidgets();
+            });
+
+    connect(ui->cbChannel, &QComboBox::currentIndexChanged,
+            [this](int index)
+            {
+                // index is -1 when channel list is being reset
+                if (index >= 0) trigger->setChannel(index);
+            });
+
+    connect(ui->spLevel, &QDoubleSpinBox::valueChanged,
+            trigger, &Trigger::setLevel);
+    connect(ui->spWindowHigh, &QDoubleSpinBox::valueChanged,
+            trigger, &Trigger::setWindowHigh);
+
+    connect(ui->spPosition, &QSpinBox::valueChanged,
+            [this](int value)
+            {
+                trigger->setPosition(value);
+            });
+
+    connect(ui->pbArm, &QPushButton::clicked, trigger, &Trigger::arm);
+    connect(trigger, &Trigger::stateChanged, this, &TriggerPanel::onStateChanged);
+
+    updateWidgets();
+    onStateChanged(trigger->state());
+}
+
+TriggerPanel::~TriggerPanel()
+{
+    delete ui;
+}
+
+void TriggerPanel::updateWidgets()
+{
+    bool enabled = trigger->enabled();
+    bool window = trigger->type() == Trigger::Type::enterWindow ||
+        trigger->type() == Trigger::Type::leaveWindow;
+
+    ui->cbType->setEnabled(enabled);
+    ui->cbChannel->setEnabled(enabled);
+    ui->spLevel->setEnabled(enabled);
+    ui->spWindowHigh->setEnabled(enabled && window);
+    ui->spPosition->setEnabled(enabled);
+    ui->pbArm->setEnabled(enabled);
+
+    ui->lLevel->setText(window ? tr("Low:") : tr("Level:"));
+}
+
+void TriggerPanel::onStateChanged(Trigger::State state)
+{
+    switch (state)
+    {
+        case Trigger::State::idle:
+            ui->lState->setText(tr("Free running"));
+            break;
+        case Trigger::State::armed:
+            ui->lState->setText(tr("Armed"));
+            break;
+        case Trigger::State::triggered:
+            ui->lState->setText(tr("Triggered"));
+            break;
+        case Trigger::State::stopped:
+            ui->lState->setText(tr("Stopped"));
+            break;
+    }
+}
+
+void TriggerPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Trigger);
+    settings->setValue(SG_Trigger_Mode, TriggerModeNames[ui->cbMode->currentIndex()]);
+    settings->setValue(SG_Trigger_Type, TriggerTypeNames[ui->cbType->currentIndex()]);
+    settings->setValue(SG_Trigger_Channel, ui->cbChannel->currentIndex());
+    settings->setValue(SG_Trigger_Level, ui->spLevel->value());
+    settings->setValue(SG_Trigger_WindowHigh, ui->spWindowHigh->value());
+    settings->setValue(SG_Trigger_Position, ui->spPosition->value());
+    settings->endGroup();
+}
+
+void TriggerPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Trigger);
+
+    auto typeS = settings->value(SG_Trigger_Type, "").toString();
+    for (int i = 0; i < ui->cbType->count(); i++)
+    {
+        if (typeS == TriggerTypeNames[i])
+        {
+            ui->cbType->setCurrentIndex(i);
+            break;
+        }
+    }
+
+    int channel = settings->value(SG_Trigger_Channel, ui->cbChannel->currentIndex()).toInt();
+    if (channel >= 0 && channel < ui->cbChannel->count())
+    {
+        ui->cbChannel->setCurrentIndex(channel);
+    }
+
+    ui->spLevel->setValue(settings->value(SG_Trigger_Level, ui->spLevel->value()).toDouble());
+    ui->spWindowHigh->setValue(
+        settings->value(SG_Trigger_WindowHigh, ui->spWindowHigh->value()).toDouble());
+    ui->spPosition->setValue(
+        settings->value(SG_Trigger_Position, ui->spPosition->value()).toInt());
+
+    // mode is set last so that trigger is armed with loaded parameters
+    auto modeS = settings->value(SG_Trigger_Mode, "").toString();
+    for (int i = 0; i < ui->cbMode->count(); i++)
+    {
+        if (modeS == TriggerModeNames[i])
+        {
+            ui->cbMode->setCurrentIndex(i);
+            break;
+        }
+    }
+
+    settings->endGroup();
+}
@@ -0,0 +1,59 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef TRIGGERPANEL_H
+#define TRIGGERPANEL_H
+
+#include <QWidget>
+#include <QSettings>
+
+#include "stream.h"
+#include "trigger.h"
+
+namespace Ui {
+class TriggerPanel;
+}
+
+/// Configures the trigger engine of a `Stream`
+class TriggerPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TriggerPanel(Stream* stream, QWidget* parent = 0);
+    ~TriggerPanel();
+
+    /// Stores trigger settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads trigger settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+private:
+    Ui::TriggerPanel *ui;
+    Trigger* trigger;
+
+    /// Enables/disables widgets according to mode and type
+    void updateWidgets();
+
+private slots:
+    void onStateChanged(Trigger::State state);
+};
+
+#endif // TRIGGERPANEL_H
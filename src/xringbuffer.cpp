@@ -0,0 +1,142 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QtGlobal>
+#include <vector>
+
+#include "xringbuffer.h"
+
+/// Maximum number of interpolation steps before falling back to binary search
+static const int MAX_INTERPOLATION_STEPS = 4;
+
+XRingBuffer::XRingBuffer(unsigned n) :
+    _data(n), empty(true)
+{
+    // intentionally empty
+}
+
+unsigned XRingBuffer::size() const
+{
+    return _data.size();
+}
+
+double XRingBuffer::sample(unsigned i) const
+{
+    return _data.sample(i);
+}
+
+Range XRingBuffer::limits() const
+{
+    // data is monotonic, no need to scan
+    return Range{sample(0), sample(size()-1)};
+}
+
+void XRingBuffer::resize(unsigned n)
+{
+    _data.resize(n);
+}
+
+void XRingBuffer::clear()
+{
+    _data.clear();
+    empty = true;
+}
+
+void XRingBuffer::fill(double value)
+{
+    std::vector<double> values(size(), value);
+    _data.addSamples(values.data(), values.size());
+}
+
+void XRingBuffer::addSamples(double* samples, unsigned n)
+{
+    if (n == 0) return;
+
+    // find the last point monotonicity is broken
+    unsigned restart = 0;
+    bool broken = empty || samples[0] < sample(size()-1);
+    for (unsigned i = 1; i < n; i++)
+    {
+        if (samples[i] < samples[i-1])
+        {
+            restart = i;
+            broken = true;
+        }
+    }
+
+    if (broken)
+    {
+        fill(samples[restart]);
+    }
+    empty = false;
+
+    _data.addSamples(samples + restart, n - restart);
+}
+
+int XRingBuffer::findIndex(double value) const
+{
+    unsigned n = size();
+    double first = sample(0);
+    double last = sample(n-1);
+
+    if (value < first || value > last)
+    {
+        return OUT_OF_RANGE;
+    }
+    if (value == last)
+    {
+        return n-1;
+    }
+
+    // invariant: sample(lo) <= value < sample(hi)
+    unsigned lo = 0;
+    unsigned hi = n-1;
+
+    for (int step = 0; step < MAX_INTERPOLATION_STEPS && hi - lo > 1; step++)
+    {
+        double xlo = sample(lo);
+        double xhi = sample(hi);
+        unsigned guess = lo + unsigned((value - xlo) / (xhi - xlo) * (hi - lo));
+        guess = qBound(lo + 1, guess, hi - 1);
+
+        // also check the neighbour, for uniform data guess is off by 1 at most
+        if (sample(guess) <= value)
+        {
+            lo = guess;
+            if (sample(guess + 1) > value) hi = guess + 1;
+            else lo = guess + 1;
+        }
+        else
+        {
+            hi = guess;
+            if (sample(guess - 1) <= value) lo = guess - 1;
+            else hi = guess - 1;
+        }
+    }
+
+    while (hi - lo > 1)
+    {
+        unsigned mid = lo + (hi - lo) / 2;
+        if (sample(mid) <= value) lo = mid;
+        else hi = mid;
+    }
+
+    return lo;
+}
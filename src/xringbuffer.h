@@ -0,0 +1,65 @@
+/*
+  Copyright © 2025 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef XRINGBUFFER_H
+#define XRINGBUFFER_H
+
+#include "framebuffer.h"
+#include "ringbuffer.h"
+
+/**
+ * A ring buffer for storing X data that is provided by the source.
+ *
+ * Values are expected to be increasing or equal (to previous). If a
+ * smaller value is added (device restarted its timer for ex.) older
+ * values are collapsed to the new value so that buffer stays monotonic.
+ * Buffer is also filled with the first value that is added after
+ * construction or `clear()`, so that initial zeros don't count in
+ * `limits()`.
+ *
+ * `findIndex` uses an interpolation search which narrows down in a
+ * few steps for uniformly spaced data and falls back to binary search
+ * otherwise.
+ */
+class XRingBuffer : public XFrameBuffer
+{
+public:
+    XRingBuffer(unsigned n);
+
+    unsigned size() const override;
+    double sample(unsigned i) const override;
+    Range limits() const override;
+    void resize(unsigned n) override;
+    int findIndex(double value) const override;
+
+    /// Add samples to the buffer
+    void addSamples(double* samples, unsigned n);
+    /// Reset all data to 0, next added sample will fill the buffer
+    void clear();
+
+private:
+    RingBuffer _data;
+    bool empty;                 ///< no samples added since construction or clear
+
+    /// Fills all of the buffer with `value`
+    void fill(double value);
+};
+
+#endif // XRINGBUFFER_H
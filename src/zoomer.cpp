@@ -335,7 +335,17 @@ QRect Zoomer::valueTrackerRect(const QFont& font) const
 
 void Zoomer::widgetMousePressEvent(QMouseEvent* mouseEvent)
 {
-    if (mouseEvent->modifiers() & Qt::ControlModifier)
+    if (mouseEvent->modifiers() == Qt::ShiftModifier &&
+        mouseEvent->button() == Qt::LeftButton)
+    {
+        emit measureCursorPlaced(invTransform(mouseEvent->pos()).x());
+    }
+    else if (mouseEvent->modifiers() == Qt::ShiftModifier &&
+             mouseEvent->button() == Qt::RightButton)
+    {
+        emit measureCursorsCleared();
+    }
+    else if (mouseEvent->modifiers() & Qt::ControlModifier)
     {
         is_panning = true;
         parentWidget()->setCursor(Qt::ClosedHandCursor);
@@ -40,6 +40,10 @@ public:
 
 signals:
     void unzoomed();
+    /// Emitted when user Shift + left clicks to place a measurement cursor
+    void measureCursorPlaced(double x);
+    /// Emitted when user Shift + right clicks to remove measurement cursors
+    void measureCursorsCleared();
 
 protected:
     /// Re-implemented to display selection size in the tracker text.
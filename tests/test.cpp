@@ -20,12 +20,29 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch.hpp"
 
+#include <string.h>
+#include <math.h>
+#include <memory>
+#include <thread>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryFile>
+
 #include "samplepack.h"
 #include "source.h"
 #include "indexbuffer.h"
 #include "linindexbuffer.h"
 #include "ringbuffer.h"
+#include "multiringbuffer.h"
+#include "xringbuffer.h"
 #include "readonlybuffer.h"
+#include "numberparser.h"
+#include "channelkeymap.h"
+#include "fftplan.h"
+#include "streammerger.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "protocoltrace.h"
 
 #include "test_helpers.h"
 
@@ -79,6 +96,36 @@ TEST_CASE("samplepack copy", "[memory]")
     }
 }
 
+TEST_CASE("samplepack first channel as X", "[memory]")
+{
+    SamplePack pack(10, 3, false);
+
+    for (int i = 0; i < 10; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = i*2;
+        pack.data(2)[i] = i*3;
+    }
+
+    SamplePack view = SamplePack::firstChannelAsX(pack);
+
+    REQUIRE(view.hasX());
+    REQUIRE(view.numChannels() == 2);
+    REQUIRE(view.numSamples() == 10);
+    REQUIRE(view.xData() == pack.data(0));
+    for (int i = 0; i < 10; i++)
+    {
+        REQUIRE(view.xData()[i] == i);
+        REQUIRE(view.data(0)[i] == i*2);
+        REQUIRE(view.data(1)[i] == i*3);
+    }
+
+    // copy of a view should own its data
+    SamplePack other = view;
+    REQUIRE(other.xData() != pack.data(0));
+    REQUIRE(other.data(1)[9] == 27);
+}
+
 TEST_CASE("sink", "[memory, stream]")
 {
     TestSink sink;
@@ -314,6 +361,56 @@ TEST_CASE("making RingBuffer smaller should keep end values", "[memory, buffer]"
     }
 }
 
+TEST_CASE("resizing a wrapped RingBuffer should keep end values", "[memory, buffer]")
+{
+    RingBuffer buf(10);
+    double values[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    // head is moved to the middle of the storage
+    buf.addSamples(values, 10);
+    buf.addSamples(values, 3);
+
+    buf.resize(8);
+    REQUIRE(buf.size() == 8);
+    for (unsigned i = 0; i < 5; i++)
+    {
+        REQUIRE(buf.sample(i) == values[i+5]);
+    }
+    for (unsigned i = 5; i < 8; i++)
+    {
+        REQUIRE(buf.sample(i) == values[i-5]);
+    }
+
+    // grow back into the same storage
+    buf.resize(10);
+    REQUIRE(buf.size() == 10);
+    REQUIRE(buf.sample(0) == 0);
+    REQUIRE(buf.sample(1) == 0);
+    for (unsigned i = 2; i < 7; i++)
+    {
+        REQUIRE(buf.sample(i) == values[i+3]);
+    }
+    for (unsigned i = 7; i < 10; i++)
+    {
+        REQUIRE(buf.sample(i) == values[i-7]);
+    }
+
+    // grow beyond the storage, then shrink a lot
+    buf.resize(20);
+    REQUIRE(buf.size() == 20);
+    REQUIRE(buf.sample(0) == 0);
+    REQUIRE(buf.sample(19) == 3);
+
+    buf.resize(2);
+    REQUIRE(buf.size() == 2);
+    REQUIRE(buf.sample(0) == 2);
+    REQUIRE(buf.sample(1) == 3);
+
+    auto lim = buf.limits();
+    REQUIRE(lim.start == 2.);
+    REQUIRE(lim.end == 3.);
+}
+
 TEST_CASE("RingBuffer limits", "[memory, buffer]")
 {
     RingBuffer buf(10);
@@ -358,6 +455,330 @@ TEST_CASE("RingBuffer clear", "[memory, buffer]")
     REQUIRE(lim.end == 0.);
 }
 
+TEST_CASE("MultiRingBuffer data access", "[memory, buffer]")
+{
+    MultiRingBuffer buf(3, 4);
+    SamplePack pack(6, 3);
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        for (unsigned i = 0; i < 6; i++)
+        {
+            pack.data(ci)[i] = ci * 10 + i;
+        }
+    }
+
+    REQUIRE(buf.numChannels() == 3);
+    REQUIRE(buf.size() == 4);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(buf.sample(1, i) == 0.);
+    }
+
+    // doesn't fit, newest samples are kept
+    buf.addSamples(pack);
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        for (unsigned i = 0; i < 4; i++)
+        {
+            REQUIRE(buf.sample(ci, i) == ci * 10 + i + 2);
+        }
+    }
+
+    // wraps around
+    SamplePack small(3, 3);
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        for (unsigned i = 0; i < 3; i++)
+        {
+            small.data(ci)[i] = 100 + ci * 10 + i;
+        }
+    }
+    buf.addSamples(small);
+    buf.addSamples(small);
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        REQUIRE(buf.sample(ci, 0) == 100 + ci * 10 + 2);
+        REQUIRE(buf.sample(ci, 1) == 100 + ci * 10 + 0);
+        REQUIRE(buf.sample(ci, 3) == 100 + ci * 10 + 2);
+    }
+
+    // channel view
+    std::unique_ptr<FrameBuffer> view(buf.channel(2));
+    REQUIRE(view->size() == 4);
+    REQUIRE(view->sample(1) == 120.);
+    REQUIRE(view->limits().start == 120.);
+    REQUIRE(view->limits().end == 122.);
+}
+
+TEST_CASE("MultiRingBuffer resizing should keep end values", "[memory, buffer]")
+{
+    MultiRingBuffer buf(2, 5);
+    SamplePack pack(7, 2);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        for (unsigned i = 0; i < 7; i++)
+        {
+            pack.data(ci)[i] = ci * 10 + i + 1;
+        }
+    }
+    buf.addSamples(pack);       // wrapped: 3 4 5 6 7
+
+    buf.resize(8);
+    REQUIRE(buf.size() == 8);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        for (unsigned i = 0; i < 3; i++)
+        {
+            REQUIRE(buf.sample(ci, i) == 0.);
+        }
+        for (unsigned i = 3; i < 8; i++)
+        {
+            REQUIRE(buf.sample(ci, i) == ci * 10 + i);
+        }
+    }
+
+    buf.resize(2);
+    REQUIRE(buf.size() == 2);
+    REQUIRE(buf.sample(0, 0) == 6.);
+    REQUIRE(buf.sample(0, 1) == 7.);
+    REQUIRE(buf.sample(1, 1) == 17.);
+}
+
+TEST_CASE("MultiRingBuffer channel count and clear", "[memory, buffer]")
+{
+    MultiRingBuffer buf(2, 4);
+    SamplePack pack(3, 2);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        for (unsigned i = 0; i < 3; i++)
+        {
+            pack.data(ci)[i] = ci * 10 + i + 1;
+        }
+    }
+    buf.addSamples(pack);
+
+    buf.setNumChannels(3);
+    REQUIRE(buf.numChannels() == 3);
+    REQUIRE(buf.sample(1, 3) == 13.);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(buf.sample(2, i) == 0.);
+    }
+
+    buf.setNumChannels(1);
+    REQUIRE(buf.numChannels() == 1);
+    REQUIRE(buf.sample(0, 3) == 3.);
+
+    buf.clear();
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(buf.sample(0, i) == 0.);
+    }
+    REQUIRE(buf.limits(0).end == 0.);
+}
+
+TEST_CASE("MultiRingBuffer statistics", "[memory, buffer]")
+{
+    // big enough to span multiple statistics blocks and wrap around
+    const unsigned N = 1000;
+    MultiRingBuffer buf(1, N);
+
+    SamplePack pack(1500, 1);
+    for (unsigned i = 0; i < 1500; i++)
+    {
+        pack.data(0)[i] = i;
+    }
+    buf.addSamples(pack);
+
+    // buffer contains 500..1499
+    auto s = buf.stats(0);
+    REQUIRE(s.count == N);
+    REQUIRE(s.min == 500.);
+    REQUIRE(s.max == 1499.);
+    REQUIRE(s.mean == Approx(999.5));
+    REQUIRE(s.variance() == Approx((N * N - 1) / 12.));
+    REQUIRE(s.peakToPeak() == 999.);
+    REQUIRE(s.rms() == Approx(sqrt(999.5 * 999.5 + (N * N - 1) / 12.)));
+
+    auto lim = buf.limits(0);
+    REQUIRE(lim.start == 500.);
+    REQUIRE(lim.end == 1499.);
+
+    // range partially covering blocks
+    s = buf.stats(0, 10, 20);
+    REQUIRE(s.count == 10);
+    REQUIRE(s.min == 510.);
+    REQUIRE(s.max == 519.);
+    REQUIRE(s.mean == Approx(514.5));
+
+    s = buf.stats(0, 5, 5);
+    REQUIRE(s.count == 0);
+
+    // overwriting data updates statistics
+    SamplePack pack2(N, 1);
+    for (unsigned i = 0; i < N; i++)
+    {
+        pack2.data(0)[i] = i % 2 ? 1 : -1;
+    }
+    buf.addSamples(pack2);
+
+    s = buf.stats(0);
+    REQUIRE(s.min == -1.);
+    REQUIRE(s.max == 1.);
+    REQUIRE(s.mean == Approx(0.).margin(1e-12));
+    REQUIRE(s.stdDev() == Approx(1.));
+    REQUIRE(s.rms() == Approx(1.));
+
+    // partial pack moves the head, buffer contains pack2[300..999], 2000..2299
+    SamplePack pack3(300, 1);
+    for (unsigned i = 0; i < 300; i++)
+    {
+        pack3.data(0)[i] = 2000 + i;
+    }
+    buf.addSamples(pack3);
+
+    s = buf.stats(0);
+    REQUIRE(s.count == N);
+    REQUIRE(s.min == -1.);
+    REQUIRE(s.max == 2299.);
+
+    // range crossing the end of storage
+    s = buf.stats(0, 600, 800);
+    REQUIRE(s.count == 200);
+    REQUIRE(s.min == -1.);
+    REQUIRE(s.max == 2099.);
+    REQUIRE(s.mean == Approx(2049.5 / 2));
+
+    // range after the end of storage
+    s = buf.stats(0, 700, N);
+    REQUIRE(s.count == 300);
+    REQUIRE(s.min == 2000.);
+    REQUIRE(s.max == 2299.);
+    REQUIRE(s.mean == Approx(2149.5));
+}
+
+TEST_CASE("XRingBuffer limits and findIndex", "[memory, buffer]")
+{
+    XRingBuffer buf(10);
+    double values[10] = {0, 1, 2, 4, 8, 9, 10, 10, 15, 20};
+
+    buf.addSamples(values, 10);
+
+    auto lim = buf.limits();
+    REQUIRE(lim.start == 0.);
+    REQUIRE(lim.end == 20.);
+
+    REQUIRE(buf.findIndex(-1) == XFrameBuffer::OUT_OF_RANGE);
+    REQUIRE(buf.findIndex(21) == XFrameBuffer::OUT_OF_RANGE);
+    REQUIRE(buf.findIndex(0) == 0);
+    REQUIRE(buf.findIndex(3) == 2);
+    REQUIRE(buf.findIndex(8) == 4);
+    REQUIRE(buf.findIndex(12) == 7);
+    REQUIRE(buf.findIndex(20) == 9);
+
+    // wrap around
+    double values2[3] = {21, 22, 30};
+    buf.addSamples(values2, 3);
+    REQUIRE(buf.limits().start == 4.);
+    REQUIRE(buf.limits().end == 30.);
+    REQUIRE(buf.findIndex(4) == 0);
+    REQUIRE(buf.findIndex(21.5) == 7);
+    REQUIRE(buf.findIndex(29) == 8);
+}
+
+TEST_CASE("XFrameBuffer findRange and range queries", "[memory, buffer]")
+{
+    XRingBuffer buf(10);
+    double values[10] = {0, 1, 2, 4, 8, 9, 10, 10, 15, 20};
+    buf.addSamples(values, 10);
+    const XFrameBuffer& xbuf = buf;
+
+    unsigned start, end;
+    xbuf.findRange(3, 12, &start, &end);
+    REQUIRE(start == 3);
+    REQUIRE(end == 8);
+
+    xbuf.findRange(-5, 2, &start, &end);
+    REQUIRE(start == 0);
+    REQUIRE(end == 3);
+
+    xbuf.findRange(8, 100, &start, &end);
+    REQUIRE(start == 4);
+    REQUIRE(end == 10);
+
+    xbuf.findRange(25, 30, &start, &end);
+    REQUIRE(start == end);
+
+    // default (scanning) implementations
+    auto lim = xbuf.limits(3, 8);
+    REQUIRE(lim.start == 4.);
+    REQUIRE(lim.end == 10.);
+    REQUIRE(xbuf.mean(3, 8) == Approx(41. / 5.));
+}
+
+TEST_CASE("MultiRingBuffer channel range queries", "[memory, buffer]")
+{
+    MultiRingBuffer buf(2, 100000);
+    SamplePack pack(150000, 2);
+    for (unsigned i = 0; i < 150000; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = -double(i);
+    }
+    buf.addSamples(pack);
+
+    std::unique_ptr<FrameBuffer> ch0(buf.channel(0));
+    std::unique_ptr<FrameBuffer> ch1(buf.channel(1));
+
+    // buffer contains 50000..149999
+    auto lim = ch0->limits(1000, 90000);
+    REQUIRE(lim.start == 51000.);
+    REQUIRE(lim.end == 139999.);
+    REQUIRE(ch0->mean(1000, 90000) == Approx((51000. + 139999.) / 2));
+
+    lim = ch1->limits(99990, 100000);
+    REQUIRE(lim.start == -149999.);
+    REQUIRE(lim.end == -149990.);
+    REQUIRE(ch1->mean(0, 100000) == Approx(-99999.5));
+}
+
+TEST_CASE("XRingBuffer should stay monotonic when X restarts", "[memory, buffer]")
+{
+    XRingBuffer buf(5);
+    double values[5] = {10, 11, 12, 13, 14};
+    buf.addSamples(values, 5);
+
+    double values2[3] = {15, 2, 3};
+    buf.addSamples(values2, 3);
+
+    double expected[5] = {2, 2, 2, 2, 3};
+    for (unsigned i = 0; i < 5; i++)
+    {
+        REQUIRE(buf.sample(i) == expected[i]);
+    }
+    REQUIRE(buf.findIndex(2) == 3);
+    REQUIRE(buf.findIndex(2.5) == 3);
+}
+
+TEST_CASE("XRingBuffer shouldn't include initial zeros in limits", "[memory, buffer]")
+{
+    XRingBuffer buf(5);
+    double values[2] = {1e6, 1e6 + 1};
+    buf.addSamples(values, 2);
+
+    REQUIRE(buf.limits().start == 1e6);
+    REQUIRE(buf.limits().end == 1e6 + 1);
+    REQUIRE(buf.findIndex(0) == XFrameBuffer::OUT_OF_RANGE);
+    REQUIRE(buf.findIndex(1e6 + 1) == 4);
+
+    // same after clear
+    buf.clear();
+    double values2[1] = {5e6};
+    buf.addSamples(values2, 1);
+    REQUIRE(buf.limits().start == 5e6);
+    REQUIRE(buf.limits().end == 5e6);
+}
+
 TEST_CASE("ReadOnlyBuffer", "[memory, buffer]")
 {
     IndexBuffer source(10);
@@ -389,3 +810,387 @@ TEST_CASE("ReadOnlyBuffer sliced constructor", "[memory, buffer]")
         REQUIRE(buf.sample(i) == (i + 5));
     }
 }
+
+static bool parseDecimalStr(const char* str, double* value)
+{
+    return parseDecimal(str, str + strlen(str), value);
+}
+
+TEST_CASE("parsing decimal numbers", "[parser]")
+{
+    double value;
+
+    REQUIRE(parseDecimalStr("0", &value));
+    REQUIRE(value == 0.);
+    REQUIRE(parseDecimalStr("-12.5", &value));
+    REQUIRE(value == -12.5);
+    REQUIRE(parseDecimalStr("+0.1", &value));
+    REQUIRE(value == 0.1);
+    REQUIRE(parseDecimalStr("1e3", &value));
+    REQUIRE(value == 1000.);
+    REQUIRE(parseDecimalStr("2.5E-3", &value));
+    REQUIRE(value == 0.0025);
+    REQUIRE(parseDecimalStr(".5", &value));
+    REQUIRE(value == 0.5);
+    // slow path
+    REQUIRE(parseDecimalStr("1.7976931348623157e308", &value));
+    REQUIRE(value == 1.7976931348623157e308);
+    REQUIRE(parseDecimalStr("0x1F", &value));
+    REQUIRE(value == 31.);
+
+    REQUIRE_FALSE(parseDecimalStr("", &value));
+    REQUIRE_FALSE(parseDecimalStr("-", &value));
+    REQUIRE_FALSE(parseDecimalStr("1e", &value));
+    REQUIRE_FALSE(parseDecimalStr("1.2.3", &value));
+    REQUIRE_FALSE(parseDecimalStr("abc", &value));
+}
+
+TEST_CASE("parsing hex numbers", "[parser]")
+{
+    double value;
+    const char str1[] = "1aF";
+    const char str2[] = "-0x10";
+    const char str3[] = "0x80000000";
+    const char str4[] = "1g";
+
+    REQUIRE(parseHex(str1, str1 + 3, &value));
+    REQUIRE(value == 0x1AF);
+    REQUIRE(parseHex(str2, str2 + 5, &value));
+    REQUIRE(value == -16.);
+    REQUIRE_FALSE(parseHex(str3, str3 + 10, &value));
+    REQUIRE_FALSE(parseHex(str4, str4 + 2, &value));
+}
+
+TEST_CASE("ChannelKeyMap", "[parser]")
+{
+    ChannelKeyMap map;
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find("a", 1) == ChannelKeyMap::NOT_FOUND);
+
+    // add enough keys to grow the table a few times
+    for (unsigned i = 0; i < 100; i++)
+    {
+        QByteArray key = "key" + QByteArray::number(i);
+        REQUIRE(map.add(key.constData(), key.size()) == i);
+    }
+
+    REQUIRE(map.size() == 100);
+    for (unsigned i = 0; i < 100; i++)
+    {
+        QByteArray key = "key" + QByteArray::number(i);
+        REQUIRE(map.find(key.constData(), key.size()) == (int) i);
+    }
+    REQUIRE(map.find("key", 3) == ChannelKeyMap::NOT_FOUND);
+    REQUIRE(map.find("key100", 6) == ChannelKeyMap::NOT_FOUND);
+
+    map.clear();
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find("key0", 4) == ChannelKeyMap::NOT_FOUND);
+}
+
+TEST_CASE("ChannelKeyMap should skip duplicate keys", "[parser]")
+{
+    ChannelKeyMap map;
+    map.setKeys({"a", "b", "a", "c", "b"});
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.keys() == QList<QByteArray>({"a", "b", "c"}));
+    REQUIRE(map.find("a", 1) == 0);
+    REQUIRE(map.find("b", 1) == 1);
+    REQUIRE(map.find("c", 1) == 2);
+    REQUIRE(map.find("d", 1) == ChannelKeyMap::NOT_FOUND);
+}
+
+TEST_CASE("FftPlan power spectrum", "[fft]")
+{
+    REQUIRE(FftPlan::isValidSize(4));
+    REQUIRE(FftPlan::isValidSize(1024));
+    REQUIRE(!FftPlan::isValidSize(2));
+    REQUIRE(!FftPlan::isValidSize(1000));
+
+    const unsigned N = 256;
+    FftPlan plan(N);
+    REQUIRE(plan.size() == N);
+    REQUIRE(plan.numBins() == N/2+1);
+
+    // sine of amplitude 2 at bin 16 with a DC offset of 1
+    double in[N];
+    for (unsigned i = 0; i < N; i++)
+    {
+        in[i] = 2 * sin(2 * M_PI * 16 * i / N) + 1;
+    }
+
+    double out[N/2+1];
+    plan.power(in, out);
+
+    REQUIRE(out[0] == Approx(1));
+    REQUIRE(out[16] == Approx(4));
+    // Hann window leaks into direct neighbours only
+    REQUIRE(out[15] == Approx(1));
+    REQUIRE(out[17] == Approx(1));
+    for (unsigned k = 2; k < N/2+1; k++)
+    {
+        if (k < 15 || k > 17)
+        {
+            REQUIRE(out[k] == Approx(0).margin(1e-12));
+        }
+    }
+}
+
+/// Keeps a copy of the last fed pack
+class LastPackSink : public TestSink
+{
+public:
+    SamplePack* last = nullptr;
+
+    ~LastPackSink()
+        {
+            delete last;
+        };
+
+    void feedIn(const SamplePack& data) override
+        {
+            delete last;
+            last = new SamplePack(data);
+            TestSink::feedIn(data);
+        };
+};
+
+TEST_CASE("StreamMerger", "[merger]")
+{
+    LastPackSink sink;
+    StreamMerger merger;
+    merger.connectSink(&sink);
+
+    TestSource source1(2, false);
+    auto input1 = merger.addInput();
+    source1.connectSink(input1);
+
+    // single input is passed through
+    REQUIRE(sink.numChannels() == 2);
+    REQUIRE(!sink.hasX());
+
+    SamplePack pack1(4, 2, false);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        pack1.data(0)[i] = i;
+        pack1.data(1)[i] = 10 + i;
+    }
+    source1._feed(pack1);
+    REQUIRE(sink.totalFed == 4);
+
+    // second input, channels are concatenated and X is added
+    TestSource source2(1, false);
+    auto input2 = merger.addInput();
+    source2.connectSink(input2);
+    REQUIRE(merger.numInputs() == 2);
+    REQUIRE(sink.numChannels() == 3);
+    REQUIRE(sink.hasX());
+
+    SamplePack pack2(2, 1, false);
+    pack2.data(0)[0] = 100;
+    pack2.data(0)[1] = 101;
+
+    qint64 t0 = StreamMerger::now();
+    merger.setArrivalTime(input1, t0);
+    source1._feed(pack1);
+    merger.setArrivalTime(input2, t0 + 1000000);
+    source2._feed(pack2);
+
+    // other input holds its last values
+    auto last = sink.last;
+    REQUIRE(last->numSamples() == 2);
+    REQUIRE(last->data(0)[0] == 3);
+    REQUIRE(last->data(1)[1] == 13);
+    REQUIRE(last->data(2)[0] == 100);
+    REQUIRE(last->data(2)[1] == 101);
+    double x1 = last->xData()[1];
+
+    merger.setArrivalTime(input1, t0 + 2000000);
+    source1._feed(pack1);
+    REQUIRE(sink.totalFed == 4 + 4 + 2 + 4);
+
+    // samples are spread between arrivals, 1ms apart
+    last = sink.last;
+    REQUIRE(last->data(2)[3] == 101);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(last->xData()[i] == Approx(x1 + 0.00025 * (i + 1)));
+    }
+
+    // removing an input goes back to pass through
+    merger.removeInput(input2);
+    REQUIRE(sink.numChannels() == 2);
+    REQUIRE(!sink.hasX());
+}
+
+TEST_CASE("MetricHistogram", "[metrics]")
+{
+    MetricHistogram hist;
+    REQUIRE(hist.count() == 0);
+    REQUIRE(hist.percentile(50) == 0);
+
+    for (int i = 0; i < 99; i++) hist.record(1000);
+    hist.record(1000000);
+
+    REQUIRE(hist.count() == 100);
+    REQUIRE(hist.max() == 1000000);
+    REQUIRE(hist.mean() == Approx((99 * 1000 + 1000000) / 100.));
+    // percentiles are bucket upper bounds, accurate to a factor of 2
+    REQUIRE(hist.percentile(50) >= 1000);
+    REQUIRE(hist.percentile(50) < 2000);
+    REQUIRE(hist.percentile(99) < 2000);
+    REQUIRE(hist.percentile(100) == 1000000);
+
+    hist.reset();
+    REQUIRE(hist.count() == 0);
+    REQUIRE(hist.max() == 0);
+}
+
+TEST_CASE("Metrics registry", "[metrics]")
+{
+    auto& metrics = Metrics::instance();
+    auto& counter = metrics.counter("test.counter");
+    REQUIRE(&metrics.counter("test.counter") == &counter);
+
+    counter.reset();
+    counter.add();
+    counter.add(4);
+    REQUIRE(counter.value() == 5);
+
+    auto& gauge = metrics.gauge("test.gauge");
+    gauge.set(10);
+    gauge.set(3);
+    REQUIRE(gauge.value() == 3);
+    REQUIRE(gauge.max() == 10);
+
+    bool found = false;
+    for (auto& v : metrics.values())
+    {
+        if (v.name == "test.counter")
+        {
+            found = true;
+            REQUIRE(v.type == Metrics::Counter);
+            REQUIRE(v.value == 5);
+        }
+    }
+    REQUIRE(found);
+    REQUIRE(metrics.toCsv().contains("test.gauge,gauge,3,"));
+    REQUIRE(metrics.toJson()["metrics"].toObject().contains("test.counter"));
+}
+
+TEST_CASE("Tracer", "[trace]")
+{
+    QTemporaryFile file;
+    REQUIRE(file.open());
+
+    // disabled scopes aren't recorded
+    {
+        TRACE_SCOPE("test.disabled");
+    }
+
+    Tracer::start();
+    REQUIRE(Tracer::enabled());
+    {
+        TRACE_SCOPE("test.scope");
+    }
+    Tracer::stop();
+    REQUIRE_FALSE(Tracer::enabled());
+
+    REQUIRE(Tracer::save(file.fileName()));
+    auto doc = QJsonDocument::fromJson(file.readAll());
+    REQUIRE(doc.isObject());
+
+    int found = 0;
+    for (auto event : doc.object()["traceEvents"].toArray())
+    {
+        auto name = event.toObject()["name"].toString();
+        REQUIRE(name != "test.disabled");
+        if (name == "test.scope")
+        {
+            found++;
+            REQUIRE(event.toObject()["ph"].toString() == "X");
+            REQUIRE(event.toObject()["dur"].toDouble() >= 0);
+        }
+    }
+    REQUIRE(found == 1);
+}
+
+TEST_CASE("Tracer should reuse buffers of ended threads", "[trace]")
+{
+    QTemporaryFile file;
+    REQUIRE(file.open());
+
+    // returns number of thread tracks and "test.thread" events in saved trace
+    auto countSaved = [&file](int& threads, int& events)
+    {
+        REQUIRE(Tracer::save(file.fileName()));
+        file.seek(0);
+        auto doc = QJsonDocument::fromJson(file.readAll());
+        threads = events = 0;
+        for (auto event : doc.object()["traceEvents"].toArray())
+        {
+            auto name = event.toObject()["name"].toString();
+            if (name == "thread_name") threads++;
+            if (name == "test.thread") events++;
+        }
+    };
+
+    auto traceInThread = []()
+    {
+        std::thread thread([]() {TRACE_SCOPE("test.thread");});
+        thread.join();
+    };
+
+    Tracer::start();
+    traceInThread();
+    int threads1, events1;
+    countSaved(threads1, events1);
+    REQUIRE(events1 == 1);
+
+    traceInThread();
+    Tracer::stop();
+    int threads2, events2;
+    countSaved(threads2, events2);
+    REQUIRE(threads2 == threads1);
+    REQUIRE(events2 == 2);
+}
+
+TEST_CASE("ProtocolTrace", "[trace]")
+{
+    auto& trace = ProtocolTrace::instance();
+    trace.clear();
+    REQUIRE(trace.count() == 0);
+    REQUIRE(trace.events().isEmpty());
+
+    uint8_t frame[100];
+    for (unsigned i = 0; i < 100; i++) frame[i] = i;
+
+    trace.record(ProtocolTrace::SyncLost, 10, 1, frame, 1);
+    trace.record(ProtocolTrace::ChecksumFailure, 20, 2, frame, 100, 0x1234, 0x4321);
+
+    auto events = trace.events();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].type == ProtocolTrace::SyncLost);
+    REQUIRE(events[0].offset == 10);
+    REQUIRE(events[0].dataSize == 1);
+    REQUIRE(events[1].type == ProtocolTrace::ChecksumFailure);
+    REQUIRE(events[1].expected == 0x1234);
+    REQUIRE(events[1].received == 0x4321);
+    REQUIRE(events[1].frameSize == 100);
+    REQUIRE(events[1].dataSize == ProtocolTrace::MaxDataSize);
+    REQUIRE(events[1].data[63] == 63);
+
+    // oldest events are overwritten
+    for (unsigned i = 0; i < ProtocolTrace::Capacity; i++)
+    {
+        trace.record(ProtocolTrace::SyncFound, 100 + i, 0);
+    }
+    events = trace.events();
+    REQUIRE(events.size() == ProtocolTrace::Capacity);
+    REQUIRE(events.first().offset == 100);
+    REQUIRE(events.last().offset == 100 + ProtocolTrace::Capacity - 1);
+    REQUIRE(trace.count() == ProtocolTrace::Capacity + 2);
+
+    trace.clear();
+    REQUIRE(trace.events().isEmpty());
+}
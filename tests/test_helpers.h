@@ -1,15 +1,25 @@
 #ifndef TEST_HELPERS_H
 #define TEST_HELPERS_H
 
+#include <vector>
+#include <QBuffer>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QVariantMap>
 #include "source.h"
 #include "sink.h"
 
+static const int READYREAD_TIMEOUT = 10; // milliseconds
+
 class TestSink : public Sink
 {
 public:
     int totalFed;
     int _numChannels;
     bool _hasX;
+    std::vector<double> lastSample; ///< channel values of the last fed sample
+    std::vector<std::vector<double>> rows; ///< channel values of every fed sample
 
     TestSink()
         {
@@ -24,6 +34,14 @@ public:
 
             totalFed += data.numSamples();
 
+            for (unsigned i = 0; i < data.numSamples(); i++)
+            {
+                rows.emplace_back(data.numChannels());
+                for (unsigned ci = 0; ci < data.numChannels(); ci++)
+                    rows.back()[ci] = data.data(ci)[i];
+            }
+            if (!rows.empty()) lastSample = rows.back();
+
             Sink::feedIn(data);
         };
 
@@ -83,4 +101,51 @@ public:
 };
 
 
-#endif // TEST_HELPERS_H
+/**
+ * Reads data with a `Reader` that is configured from a settings file.
+ *
+ * @param group settings group of the reader
+ * @param keys values to write in `group`, nested groups are separated with '/'
+ * @param reads data that is made available to the reader in separate reads
+ */
+template <class Reader>
+void readWithSettings(const char* group, const QVariantMap& keys,
+                      const QList<QByteArray>& reads, TestSink& sink)
+{
+    QTemporaryFile settingsFile;
+    REQUIRE(settingsFile.open());
+    QSettings settings(settingsFile.fileName(), QSettings::IniFormat);
+    settings.beginGroup(group);
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+    {
+        settings.setValue(it.key(), it.value());
+    }
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    Reader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+    reader.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    for (auto& data : reads)
+    {
+        // append after the unread data
+        qint64 pos = bufferDev.pos();
+        bufferDev.seek(bufferDev.size());
+        bufferDev.write(data);
+        bufferDev.seek(pos);
+        REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    }
+}
+
+/// Reads `data` in a single read, see above
+template <class Reader>
+void readWithSettings(const char* group, const QVariantMap& keys,
+                      const QByteArray& data, TestSink& sink)
+{
+    readWithSettings<Reader>(group, keys, QList<QByteArray>({data}), sink);
+}
+
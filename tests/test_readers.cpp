@@ -21,16 +21,24 @@
 #define CATCH_CONFIG_RUNNER
 #include "catch.hpp"
 
+#include <cmath>
 #include <QSignalSpy>
+#include <QTest>
 #include <QBuffer>
+#include <QSettings>
+#include <QTemporaryFile>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include "binarystreamreader.h"
 #include "asciireader.h"
 #include "framedreader.h"
 #include "demoreader.h"
+#include "replaydevice.h"
+#include "datasource.h"
+#include "setting_defines.h"
 
 #include "test_helpers.h"
 
-static const int READYREAD_TIMEOUT = 10; // milliseconds
 
 TEST_CASE("reading data with BinaryStreamReader", "[reader]")
 {
@@ -100,6 +108,142 @@ TEST_CASE("reading data with AsciiReader", "[reader, ascii]")
     REQUIRE(sink.totalFed == 3);
 }
 
+TEST_CASE("AsciiReader should strip labels and skip invalid lines", "[reader, ascii]")
+{
+    QBuffer bufferDev;
+    AsciiReader reader(&bufferDev);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    // inject data to the buffer
+    bufferDev.open(QIODevice::ReadWrite);
+    bufferDev.write("discarded\r\n"
+                    "a:1,b:2.5\r\n"
+                    "a:x,b:3\r\n"
+                    "  a:-1e2 , b:4\r\n"
+                    "a:5,b:"); // incomplete line
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink._numChannels == 2);
+    REQUIRE(sink.totalFed == 2);
+}
+
+TEST_CASE("AsciiReader should route values by label in keyed mode", "[reader, ascii]")
+{
+    QTemporaryFile settingsFile;
+    REQUIRE(settingsFile.open());
+    QSettings settings(settingsFile.fileName(), QSettings::IniFormat);
+    settings.beginGroup(SettingGroup_ASCII);
+    settings.setValue(SG_ASCII_Keyed, true);
+    bool hold = false;
+    SECTION("missing as nan")
+    {
+        settings.setValue(SG_ASCII_MissingKey, "nan");
+    }
+    SECTION("missing as hold")
+    {
+        settings.setValue(SG_ASCII_MissingKey, "hold");
+        hold = true;
+    }
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    AsciiReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    // inject data to the buffer, keys appear in different order and subsets
+    bufferDev.open(QIODevice::ReadWrite);
+    bufferDev.write("discarded\n"
+                    "a:1,b:2\n"
+                    "b:3\n"
+                    "c:4,a:5\n"
+                    "6,a:7\n"); // missing label
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink._numChannels == 3);
+    REQUIRE(sink.totalFed == 3);
+
+    // last accepted line is "c:4,a:5", channels are in order of discovery
+    REQUIRE(sink.lastSample[0] == 5);
+    REQUIRE(sink.lastSample[2] == 4);
+    if (hold)
+    {
+        REQUIRE(sink.lastSample[1] == 3); // from "b:3"
+    }
+    else
+    {
+        REQUIRE(std::isnan(sink.lastSample[1]));
+    }
+
+    // discovered keys are stored
+    reader.saveSettings(&settings);
+    settings.beginGroup(SettingGroup_ASCII);
+    REQUIRE(settings.value(SG_ASCII_Keys).toStringList() == QStringList({"a", "b", "c"}));
+    settings.endGroup();
+}
+
+TEST_CASE("AsciiReader shouldn't keep keys of rejected lines", "[reader, ascii]")
+{
+    QVariantMap keys;
+    keys[SG_ASCII_Keyed] = true;
+    keys[SG_ASCII_MissingKey] = "hold";
+
+    TestSink sink;
+    readWithSettings<AsciiReader>(SettingGroup_ASCII, keys,
+                                  "discarded\n"
+                                  "a:1\n"
+                                  "junk:2,6\n" // value without label
+                                  "b:3\n", sink);
+    REQUIRE(sink._numChannels == 2);
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(sink.lastSample == std::vector<double>({1, 3}));
+}
+
+TEST_CASE("AsciiReader should skip duplicate keys in settings", "[reader, ascii]")
+{
+    QTemporaryFile settingsFile;
+    REQUIRE(settingsFile.open());
+    QSettings settings(settingsFile.fileName(), QSettings::IniFormat);
+    settings.beginGroup(SettingGroup_ASCII);
+    settings.setValue(SG_ASCII_Keyed, true);
+    settings.setValue(SG_ASCII_Keys, QStringList({"a", "b", "a", "b"}));
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    AsciiReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    bufferDev.write("discarded\n"
+                    "b:2,a:1\n");
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink._numChannels == 2);
+    REQUIRE(sink.totalFed == 1);
+    REQUIRE(sink.lastSample == std::vector<double>({1, 2}));
+
+    reader.saveSettings(&settings);
+    settings.beginGroup(SettingGroup_ASCII);
+    REQUIRE(settings.value(SG_ASCII_Keys).toStringList() == QStringList({"a", "b"}));
+    settings.endGroup();
+}
+
 TEST_CASE("AsciiReader shouldn't read when disabled", "[reader, ascii]")
 {
     QBuffer bufferDev;
@@ -135,14 +279,225 @@ TEST_CASE("reading data with FramedReader", "[reader]")
     REQUIRE(sink._numChannels == 1);
     REQUIRE(sink._hasX == false);
 
+    // two frames of default length (16 bytes) with garbage in between
+    QByteArray frame = QByteArray::fromHex("AABB0102030405060708090A0B0C0D0E");
     bufferDev.open(QIODevice::ReadWrite);
-    const uint8_t data[] = {0xAA, 0xBB, 4, 0x01, 0x02, 0x03, 0x04};
-    bufferDev.write((const char*) data, 7);
+    bufferDev.write(frame + QByteArray::fromHex("00AA01") + frame);
     bufferDev.seek(0);
 
     QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
     REQUIRE(spy.wait(READYREAD_TIMEOUT));
-    REQUIRE(sink.totalFed == 4);
+    REQUIRE(sink.totalFed == 2);
+}
+
+/// Settings key of a channel mapping field, `prefix` is the group of a message layout
+static QString channelKey(unsigned ci, const char* key, QString prefix = QString())
+{
+    return QString("%1%2/%3_%4/%5").arg(prefix).arg(SG_CustomFrame_ChannelMapping)
+        .arg(SG_CustomFrame_Channel).arg(ci).arg(key);
+}
+
+TEST_CASE("FramedReader should read variable length frames", "[reader]")
+{
+    QVariantMap keys;
+    keys[SG_CustomFrame_TotalFrameLength] = 32;
+    keys[SG_CustomFrame_LengthField] = true;
+    keys[SG_CustomFrame_LengthFieldOffset] = 2;
+    keys[SG_CustomFrame_LengthFieldWidth] = 1;
+    keys[SG_CustomFrame_LengthFieldCovers] = "payload";
+    // first 2 bytes of payload
+    keys[SG_CustomFrame_NumOfChannels] = 2;
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        keys[channelKey(ci, SG_CustomFrame_ChannelByteOffset)] = 3 + ci;
+    }
+
+    // 3 valid frames, a garbage byte and a frame with too large length
+    TestSink sink;
+    readWithSettings<FramedReader>(SettingGroup_CustomFrame, keys,
+                                   QByteArray::fromHex("AABB021122"
+                                                       "AABB0401020304"
+                                                       "00"
+                                                       "AABB40"
+                                                       "AABB0105"), sink);
+    REQUIRE(sink.totalFed == 3);
+    // second channel is beyond the end of the last (short) frame
+    REQUIRE(sink.rows == std::vector<std::vector<double>>({{0x11, 0x22},
+                                                            {1, 2},
+                                                            {5, 0}}));
+}
+
+TEST_CASE("FramedReader should dispatch frames by message ID", "[reader]")
+{
+    QVariantMap keys;
+    keys[SG_CustomFrame_TotalFrameLength] = 6;
+    keys[SG_CustomFrame_MessageId] = true;
+    keys[SG_CustomFrame_MessageIdOffset] = 2;
+    keys[SG_CustomFrame_MessageIdWidth] = 1;
+    // message 0x01 has 2 channels, message 0x02 has 1 channel
+    for (unsigned i = 0; i < 2; i++)
+    {
+        QString layout = QString("%1/%2_%3/").arg(SG_CustomFrame_MessageLayouts)
+            .arg(SG_CustomFrame_Layout).arg(i);
+        keys[layout + SG_CustomFrame_LayoutId] = i + 1;
+        keys[layout + SG_CustomFrame_NumOfChannels] = 2 - i;
+        for (unsigned ci = 0; ci < 2 - i; ci++)
+        {
+            keys[channelKey(ci, SG_CustomFrame_ChannelByteOffset, layout)] = 3 + ci;
+        }
+    }
+
+    // message 0x01, then an unknown one and message 0x02 in the next read
+    TestSink sink;
+    readWithSettings<FramedReader>(SettingGroup_CustomFrame, keys,
+                                   QList<QByteArray>{QByteArray::fromHex("AABB01102000"),
+                                                     QByteArray::fromHex("AABB07000000"
+                                                                         "AABB02300000")},
+                                   sink);
+    REQUIRE(sink._numChannels == 3);
+    REQUIRE(sink.totalFed == 2);
+    // each message updates its own channels, others hold their values
+    REQUIRE(sink.rows == std::vector<std::vector<double>>({{0x10, 0x20, 0},
+                                                            {0x10, 0x20, 0x30}}));
+}
+
+TEST_CASE("FramedReader should extract bit fields", "[reader]")
+{
+    QVariantMap keys;
+    keys[SG_CustomFrame_NumOfChannels] = 4;
+    keys[SG_CustomFrame_TotalFrameLength] = 7;
+    // 3x10-in-32 word, last one signed, and a single bit flag
+    const char* formats[] = {"uint32", "uint32", "int32", "uint8"};
+    const unsigned offsets[] = {2, 2, 2, 6};
+    const unsigned bitOffsets[] = {0, 10, 20, 3};
+    const unsigned bitWidths[] = {10, 10, 10, 1};
+    for (unsigned ci = 0; ci < 4; ci++)
+    {
+        keys[channelKey(ci, SG_CustomFrame_ChannelByteOffset)] = offsets[ci];
+        keys[channelKey(ci, SG_CustomFrame_ChannelFormat)] = formats[ci];
+        keys[channelKey(ci, SG_CustomFrame_ChannelBitOffset)] = bitOffsets[ci];
+        keys[channelKey(ci, SG_CustomFrame_ChannelBitWidth)] = bitWidths[ci];
+    }
+
+    // word: 1 | 512 << 10 | 1023 << 20, flag byte: bit 3 set
+    TestSink sink;
+    readWithSettings<FramedReader>(SettingGroup_CustomFrame, keys,
+                                   QByteArray::fromHex("AABB0100F83F08"), sink);
+    REQUIRE(sink.totalFed == 1);
+    REQUIRE(sink.lastSample == std::vector<double>({1, 512, -1, 1}));
+}
+
+TEST_CASE("FramedReader should read burst frames", "[reader]")
+{
+    QVariantMap keys;
+    keys[SG_CustomFrame_NumOfChannels] = 2;
+    keys[SG_CustomFrame_TotalFrameLength] = 8;
+    // 3 interleaved samples of 2 channels
+    keys[QString("%1/%2").arg(SG_CustomFrame_ChannelMapping)
+         .arg(SG_CustomFrame_SamplesPerFrame)] = 3;
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        keys[channelKey(ci, SG_CustomFrame_ChannelByteOffset)] = 2 + ci;
+        keys[channelKey(ci, SG_CustomFrame_ChannelStride)] = 2;
+    }
+
+    TestSink sink;
+    readWithSettings<FramedReader>(SettingGroup_CustomFrame, keys,
+                                   QByteArray::fromHex("AABB010A020B030C"
+                                                       "AABB040D050E060F"), sink);
+    REQUIRE(sink.totalFed == 6);
+    REQUIRE(sink.lastSample == std::vector<double>({6, 15}));
+
+    // samples of a channel shouldn't overlap each other
+    ChannelMappingConfig config;
+    config.setNumChannels(1);
+    config.setRepeat(2);
+    config.channel(0).numberFormat = NumberFormat_uint16;
+    config.channel(0).byteLength = 2;
+    config.channel(0).stride = 1;
+    QString error;
+    REQUIRE_FALSE(config.isValid(8, error));
+    config.channel(0).stride = 0; // packed
+    REQUIRE(config.isValid(4, error));
+    REQUIRE_FALSE(config.isValid(3, error));
+}
+
+TEST_CASE("FramedReader should read byte stuffed frames", "[reader]")
+{
+    // frames of 2 uint8 channels
+    QVariantMap keys;
+    keys[SG_CustomFrame_NumOfChannels] = 2;
+    keys[SG_CustomFrame_TotalFrameLength] = 2;
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        keys[channelKey(ci, SG_CustomFrame_ChannelByteOffset)] = ci;
+    }
+    TestSink sink;
+
+    SECTION("COBS")
+    {
+        keys[SG_CustomFrame_Framing] = "cobs";
+        // partial frame, {0, 5}, invalid code, {7, 0}
+        readWithSettings<FramedReader>(
+            SettingGroup_CustomFrame, keys,
+            QByteArray::fromHex("1122" "00" "010205" "00" "0511" "00" "020701" "00"), sink);
+        REQUIRE(sink.totalFed == 2);
+        REQUIRE(sink.lastSample == std::vector<double>({7, 0}));
+    }
+
+    SECTION("SLIP")
+    {
+        keys[SG_CustomFrame_Framing] = "slip";
+        // {1, 2}, invalid escape, {0xC0, 0xDB}
+        readWithSettings<FramedReader>(
+            SettingGroup_CustomFrame, keys,
+            QByteArray::fromHex("C0" "0102" "C0" "DB01" "C0" "DBDCDBDD" "C0"), sink);
+        REQUIRE(sink.totalFed == 2);
+        REQUIRE(sink.lastSample == std::vector<double>({0xC0, 0xDB}));
+    }
+
+    SECTION("HDLC")
+    {
+        keys[SG_CustomFrame_Framing] = "hdlc";
+        // {0x7E, 0x7D}
+        readWithSettings<FramedReader>(
+            SettingGroup_CustomFrame, keys,
+            QByteArray::fromHex("7E" "7D5E7D5D" "7E"), sink);
+        REQUIRE(sink.totalFed == 1);
+        REQUIRE(sink.lastSample == std::vector<double>({0x7E, 0x7D}));
+    }
+}
+
+TEST_CASE("ChannelMappingConfig should allow bit fields sharing bytes", "[reader]")
+{
+    ChannelMappingConfig config;
+    config.setNumChannels(2);
+    QString error;
+
+    // 2x12-in-24 big endian
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        ChannelMapping& ch = config.channel(ci);
+        ch.byteOffset = 2;
+        ch.numberFormat = NumberFormat_uint24;
+        ch.endianness = BigEndian;
+        ch.bitOffset = ci * 12;
+        ch.bitWidth = 12;
+        ch.byteLength = ch.dataLength();
+    }
+    REQUIRE(config.channel(0).byteLength == 3);
+    REQUIRE(config.isValid(5, error));
+    REQUIRE_FALSE(config.isValid(4, error));
+
+    // overlapping bits
+    config.channel(1).bitOffset = 11;
+    config.channel(1).byteLength = config.channel(1).dataLength();
+    REQUIRE_FALSE(config.isValid(8, error));
+
+    // bit fields need an integer format
+    config.channel(1).bitOffset = 12;
+    config.channel(1).numberFormat = NumberFormat_float;
+    REQUIRE_FALSE(config.isValid(8, error));
 }
 
 TEST_CASE("FramedReader shouldn't read when disabled", "[reader]")
@@ -198,6 +553,114 @@ TEST_CASE("DemoReader shouldn't generate data when paused", "[reader, demo]")
     REQUIRE(sink.totalFed == 0);
 }
 
+TEST_CASE("replaying a capture with BinaryStreamReader", "[reader, replay]")
+{
+    QTemporaryFile capture;
+    REQUIRE(capture.open());
+    QByteArray data;
+    for (int i = 0; i < 1000; i++) data.append(char(i));
+    capture.write(data);
+    capture.flush();
+
+    ReplayDevice replay;
+    REQUIRE(replay.load(capture.fileName()));
+    REQUIRE(replay.captureSize() == 1000);
+    REQUIRE(replay.bytesAvailable() == 0);
+
+    QBuffer bufferDev;
+    BinaryStreamReader bs(&bufferDev);
+    bs.enable(true);
+    // switch to replay after enabling, reader should follow
+    bs.setDevice(&replay);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    replay.setSpeed(ReplayDevice::MaxSpeed);
+    replay.jump(500);
+    QSignalSpy spy(&replay, SIGNAL(replayFinished()));
+    replay.play();
+    REQUIRE(spy.wait(1000));
+    REQUIRE(replay.replayPosition() == 1000);
+    REQUIRE(sink.totalFed == 500);
+    REQUIRE_FALSE(replay.isPlaying());
+
+    // playing a finished replay restarts it
+    replay.play();
+    REQUIRE(spy.wait(1000));
+    REQUIRE(sink.totalFed == 1500);
+}
+
+TEST_CASE("ReplayDevice should limit the data rate", "[replay]")
+{
+    QTemporaryFile capture;
+    REQUIRE(capture.open());
+    capture.write(QByteArray(100000, 'a'));
+    capture.flush();
+
+    ReplayDevice replay;
+    REQUIRE(replay.load(capture.fileName()));
+    replay.setByteRate(1000);
+    replay.setSpeed(2);
+
+    QSignalSpy spy(&replay, SIGNAL(readyRead()));
+    replay.play();
+    REQUIRE(spy.wait(1000));
+    QTest::qWait(100);
+    replay.pause();
+
+    // ~200 bytes are released in 100ms, allow for timer inaccuracy
+    REQUIRE(replay.replayPosition() > 0);
+    REQUIRE(replay.replayPosition() < 2000);
+    REQUIRE(replay.readAll().size() == replay.replayPosition());
+}
+
+TEST_CASE("reading TCP data through DataSource", "[reader, source]")
+{
+    QTcpServer server;
+    REQUIRE(server.listen(QHostAddress::LocalHost));
+
+    DataSource source;
+    BinaryStreamReader bs(source.device());
+    bs.enable(true);
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    QSignalSpy openedSpy(&source, SIGNAL(opened(bool, QString)));
+    source.open(DataSource::TcpClient, QString("127.0.0.1:%1").arg(server.serverPort()));
+    REQUIRE(server.waitForNewConnection(1000));
+    REQUIRE((openedSpy.count() || openedSpy.wait(1000)));
+    REQUIRE(openedSpy.at(0).at(0).toBool());
+    REQUIRE(source.isOpen());
+
+    QTcpSocket* client = server.nextPendingConnection();
+    client->write(QByteArray(100, 'a'));
+    client->flush();
+
+    QSignalSpy spy(source.device(), SIGNAL(readyRead()));
+    REQUIRE(spy.wait(1000));
+    while (sink.totalFed < 100 && spy.wait(100));
+    REQUIRE(sink.totalFed == 100);
+    REQUIRE(source.bytesReceived() == 100);
+    REQUIRE(source.packetsReceived() > 0);
+
+    // remote closing the connection closes the source
+    QSignalSpy closedSpy(&source, SIGNAL(closed()));
+    client->disconnectFromHost();
+    REQUIRE(closedSpy.wait(1000));
+    REQUIRE_FALSE(source.isOpen());
+}
+
+TEST_CASE("DataSource should fail with invalid address", "[source]")
+{
+    DataSource source;
+    QSignalSpy openedSpy(&source, SIGNAL(opened(bool, QString)));
+    source.open(DataSource::TcpClient, "localhost");
+    REQUIRE(openedSpy.count() == 1);
+    REQUIRE_FALSE(openedSpy.at(0).at(0).toBool());
+    REQUIRE_FALSE(source.isOpen());
+}
+
 // Note: this is added because `QApplication` must be created for widgets
 #include <QApplication>
 int main(int argc, char* argv[])
@@ -64,8 +64,6 @@ TEST_CASE("changing stream number of channels via sink", "[memory, stream, sink]
         REQUIRE(c->index() == i);
     }
 
-// TODO: enable test when `Stream` supports X channel
-#if 0
     // increase nc value, add X
     so._setNumChannels(5, true);
 
@@ -78,7 +76,6 @@ TEST_CASE("changing stream number of channels via sink", "[memory, stream, sink]
         REQUIRE(c != NULL);
         REQUIRE(c->index() == i);
     }
-#endif
 
     // reduce nc value, remove X
     so._setNumChannels(1, false);
@@ -130,8 +127,6 @@ TEST_CASE("adding data to a stream with no X", "[memory, stream, data, sink]")
     }
 }
 
-// TODO: enable test when `Stream` supports X channel
-#if 0
 TEST_CASE("adding data to a stream with X", "[memory, stream, data, sink]")
 {
     Stream s(3, false, 10);
@@ -152,7 +147,8 @@ TEST_CASE("adding data to a stream with X", "[memory, stream, data, sink]")
     }
 
     TestSource so(3, true);
-    REQUIRE_THROWS(so.connectSink(&s));
+    so.connectSink(&s);
+    REQUIRE(s.hasX());
 
     // test
     so._feed(pack);
@@ -174,16 +170,16 @@ TEST_CASE("adding data to a stream with X", "[memory, stream, data, sink]")
 
     // check x
     const FrameBuffer* x = s.channel(0)->xData();
+    // empty part is filled with the first x value
     for (unsigned i = 0; i < 5; i++)
     {
-        REQUIRE(x->sample(i) == 0);
+        REQUIRE(x->sample(i) == 10);
     }
     for (unsigned i = 5; i < 10; i++)
     {
         REQUIRE(x->sample(i) == (i-5)+10);
     }
 }
-#endif
 
 TEST_CASE("paused stream shouldn't store data", "[memory, stream, pause]")
 {
@@ -250,3 +246,102 @@ TEST_CASE("clear stream data", "[memory, stream, pause]")
         }
     }
 }
+
+TEST_CASE("stream in trigger mode displays only captured window", "[memory, stream, trigger]")
+{
+    Stream s(2, false, 10);
+    TestSource so(2, false);
+    so.connectSink(&s);
+
+    auto trigger = s.trigger();
+    trigger->setType(Trigger::Type::risingEdge);
+    trigger->setLevel(0.5);
+    trigger->setPosition(20); // 2 samples before trigger
+    trigger->setMode(Trigger::Mode::normal);
+    REQUIRE(trigger->state() == Trigger::State::armed);
+
+    // channel 0 is a single pulse at 25, channel 1 is sample index
+    SamplePack pack(50, 2, false);
+    for (unsigned i = 0; i < 50; i++)
+    {
+        pack.data(0)[i] = (i == 25) ? 1 : 0;
+        pack.data(1)[i] = i;
+    }
+
+    // feed in small packs, display shouldn't change until capture
+    SamplePack part(5, 2, false);
+    for (unsigned p = 0; p < 6; p++)
+    {
+        for (unsigned ci = 0; ci < 2; ci++)
+        {
+            for (unsigned i = 0; i < 5; i++)
+            {
+                part.data(ci)[i] = pack.data(ci)[p*5 + i];
+            }
+        }
+        so._feed(part);
+
+        const FrameBuffer* y = s.channel(1)->yData();
+        for (unsigned i = 0; i < 10; i++)
+        {
+            REQUIRE(y->sample(i) == 0);
+        }
+    }
+
+    // window completes with the rest of the data
+    SamplePack rest(20, 2, false);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        for (unsigned i = 0; i < 20; i++)
+        {
+            rest.data(ci)[i] = pack.data(ci)[30 + i];
+        }
+    }
+    so._feed(rest);
+
+    const FrameBuffer* y0 = s.channel(0)->yData();
+    const FrameBuffer* y1 = s.channel(1)->yData();
+    for (unsigned i = 0; i < 10; i++)
+    {
+        REQUIRE(y1->sample(i) == 23 + i);
+        REQUIRE(y0->sample(i) == (i == 2 ? 1 : 0));
+    }
+}
+
+TEST_CASE("single trigger stops after first capture", "[memory, stream, trigger]")
+{
+    Trigger trigger(1, true, 4);
+    trigger.setType(Trigger::Type::fallingEdge);
+    trigger.setLevel(0);
+    trigger.setPosition(0);
+    trigger.setMode(Trigger::Mode::single);
+
+    SamplePack pack(20, 1, true);
+    for (unsigned i = 0; i < 20; i++)
+    {
+        pack.data(0)[i] = (i % 5 == 3) ? -1 : 1;
+        pack.xData()[i] = i;
+    }
+
+    REQUIRE(trigger.feedIn(pack) == 1);
+    REQUIRE(trigger.state() == Trigger::State::stopped);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(trigger.window().xData()[i] == 3 + i);
+    }
+    REQUIRE(trigger.feedIn(pack) == 0);
+
+    // after re-arming next falling edge is captured
+    trigger.arm();
+    REQUIRE(trigger.feedIn(pack) == 1);
+    REQUIRE(trigger.window().xData()[0] == 3);
+
+    // turning off and on again starts with a new history
+    trigger.setMode(Trigger::Mode::off);
+    REQUIRE(trigger.feedIn(pack) == 0);
+    trigger.setWindowSize(2);
+    trigger.setMode(Trigger::Mode::single);
+    REQUIRE(trigger.feedIn(pack) == 1);
+    REQUIRE(trigger.window().numSamples() == 2);
+    REQUIRE(trigger.window().xData()[0] == 3);
+}